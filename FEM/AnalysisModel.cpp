@@ -42,6 +42,7 @@
 #include <Domain.h>
 #include <FE_Element.h>
 #include <DOF_Group.h>
+#include <NodalKinematicState.h>
 #include <DOF_GrpIter.h>
 #include <FE_EleIter.h>
 #include <Graph.h>
@@ -63,7 +64,8 @@ AnalysisModel::AnalysisModel(int theClassTag)
 :MovableObject(theClassTag),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ stateStamp(0), stateUsable(false), stateIdentity(false)
 {
     theFEs     = new ArrayOfTaggedObjects(1024);
     theDOFs    =  new ArrayOfTaggedObjects(1024);
@@ -77,7 +79,8 @@ AnalysisModel::AnalysisModel()
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ stateStamp(0), stateUsable(false), stateIdentity(false)
 {
   theFEs     = new ArrayOfTaggedObjects(256);
   theDOFs    = new ArrayOfTaggedObjects(256);
@@ -90,7 +93,8 @@ AnalysisModel::AnalysisModel(TaggedObjectStorage &theFes, TaggedObjectStorage &t
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ stateStamp(0), stateUsable(false), stateIdentity(false)
 {
   theFEs     = &theFes;
   theDOFs    = &theDofs;
@@ -219,6 +223,7 @@ AnalysisModel::clearAll(void)
     numFE_Ele =0;
     numDOF_Grp = 0;
     numEqn = 0;    
+    stateStamp = 0;
 }
 
 void
@@ -279,6 +284,9 @@ void
 AnalysisModel::setNumEqn(int theNumEqn)
 {
     numEqn = theNumEqn;
+
+    // the dofs have been renumbered, remap the nodal state
+    stateStamp = 0;
 }
 
 int 
@@ -436,6 +444,12 @@ AnalysisModel::setResponse(const Vector &disp,
 			   const Vector &vel, 
 			   const Vector &accel)
 {
+    NodalKinematicState *theState = this->getNodalState();
+    if (theState != 0) {
+	theState->setTrialResponse(&disp, &vel, &accel, stateIdentity ? noEqns : stateEqns);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -449,6 +463,12 @@ AnalysisModel::setResponse(const Vector &disp,
 void 
 AnalysisModel::setDisp(const Vector &disp)
 {
+    NodalKinematicState *theState = this->getNodalState();
+    if (theState != 0) {
+	theState->setTrialResponse(&disp, 0, 0, stateIdentity ? noEqns : stateEqns);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -459,7 +479,13 @@ AnalysisModel::setDisp(const Vector &disp)
 void 
 AnalysisModel::setVel(const Vector &vel)
 {
-        DOF_GrpIter &theDOFGrps = this->getDOFs();
+    NodalKinematicState *theState = this->getNodalState();
+    if (theState != 0) {
+	theState->setTrialResponse(0, &vel, 0, stateIdentity ? noEqns : stateEqns);
+	return;
+    }
+
+    DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
     while ((dofPtr = theDOFGrps()) != 0) 
@@ -470,6 +496,12 @@ AnalysisModel::setVel(const Vector &vel)
 void 
 AnalysisModel::setAccel(const Vector &accel)
 {
+    NodalKinematicState *theState = this->getNodalState();
+    if (theState != 0) {
+	theState->setTrialResponse(0, 0, &accel, stateIdentity ? noEqns : stateEqns);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
@@ -477,6 +509,58 @@ AnalysisModel::setAccel(const Vector &accel)
 	dofPtr->setNodeAccel(accel);	
 }	
 
+// getNodalState():
+// returns the nodal state arrays of the Domain if the trial response can be
+// set in them directly, building stateEqns which maps state dof to equation 
+// number; returns 0 if the response has to go through the DOF_Groups.
+
+NodalKinematicState *
+AnalysisModel::getNodalState(void)
+{
+    if (myDomain == 0)
+	return 0;
+
+    NodalKinematicState *theState = myDomain->getNodalState();
+    if (theState == 0)
+	return 0;
+
+    if (theState->getStamp() == stateStamp)
+	return (stateUsable == true) ? theState : 0;
+
+    stateStamp = theState->getStamp();
+    stateUsable = false;
+    stateIdentity = false;
+
+    int numStateDOF = theState->getNumDOF();
+    if (numStateDOF == 0 || stateEqns.resize(numStateDOF) < 0)
+	return 0;
+    for (int i=0; i<numStateDOF; i++)
+	stateEqns(i) = -2;
+
+    DOF_GrpIter &theDOFGrps = this->getDOFs();
+    DOF_Group 	*dofPtr;
+    while ((dofPtr = theDOFGrps()) != 0) {
+	if (dofPtr->hasPlainNodeResponse() == false)
+	    return 0;
+	int index = myDomain->getFlatNodeIndex(dofPtr->getNodeTag());
+	int offset = theState->getOffset(index);
+	if (offset < 0)
+	    return 0;
+	const ID &theID = dofPtr->getID();
+	for (int j=0; j<theID.Size(); j++)
+	    stateEqns(offset+j) = (theID(j) >= 0) ? theID(j) : -1;
+    }
+
+    // the usual case, every state dof is the equation of the same number
+    stateIdentity = (numStateDOF == numEqn);
+    for (int i=0; i<numStateDOF && stateIdentity == true; i++)
+	if (stateEqns(i) != i)
+	    stateIdentity = false;
+
+    stateUsable = true;
+    return theState;
+}
+
 void 
 AnalysisModel::incrDisp(const Vector &disp)
 {
@@ -40,6 +40,7 @@
 // What: "@(#) AnalysisModel.h, revA"
 
 #include <MovableObject.h>
+#include <ID.h>
 
 class TaggedObjectStorage;
 class Domain;
@@ -51,6 +52,7 @@ class DOF_Group;
 class Vector;
 class FEM_ObjectBroker;
 class ConstraintHandler;
+class NodalKinematicState;
 
 class AnalysisModel: public MovableObject
 {
@@ -125,6 +127,8 @@ class AnalysisModel: public MovableObject
 
     
   private:
+    NodalKinematicState *getNodalState(void);
+
     Domain *myDomain;
     ConstraintHandler *myHandler;
 
@@ -140,6 +144,13 @@ class AnalysisModel: public MovableObject
     
     FE_EleIter    *theFEiter;     
     DOF_GrpIter   *theDOFiter;    
+
+    // map from the Domain's nodal state arrays to the equation numbers
+    ID   stateEqns;
+    ID   noEqns;
+    int  stateStamp;
+    bool stateUsable;
+    bool stateIdentity;
 };
 
 #endif
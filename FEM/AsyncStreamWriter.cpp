@@ -0,0 +1,181 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for AsyncStreamWriter.
+
+#include <AsyncStreamWriter.h>
+#include <DataFileStream.h>
+
+// number of doubles in the fill buffer before it is handed to the writer
+#define ASYNC_WRITER_BUFFER_SIZE 65536
+
+AsyncStreamWriter &
+AsyncStreamWriter::getWriter(void)
+{
+  // started on first use, drained and joined at program exit
+  static AsyncStreamWriter theWriter;
+  return theWriter;
+}
+
+
+AsyncStreamWriter::AsyncStreamWriter()
+:draining(false), done(false)
+{
+  fillData.reserve(ASYNC_WRITER_BUFFER_SIZE);
+  drainData.reserve(ASYNC_WRITER_BUFFER_SIZE);
+  theThread = std::thread(&AsyncStreamWriter::run, this);
+}
+
+
+AsyncStreamWriter::~AsyncStreamWriter()
+{
+  this->drain();
+
+  {
+    std::lock_guard<std::mutex> theLock(theMutex);
+    done = true;
+  }
+  workCond.notify_one();
+
+  if (theThread.joinable())
+    theThread.join();
+}
+
+
+int
+AsyncStreamWriter::write(DataFileStream *theStream, const double *data, int n)
+{
+  return getWriter().queue(theStream, data, n);
+}
+
+
+int
+AsyncStreamWriter::flush(DataFileStream *theStream)
+{
+  return getWriter().drain(theStream);
+}
+
+
+int
+AsyncStreamWriter::queue(DataFileStream *theStream, const double *data, int n)
+{
+  std::unique_lock<std::mutex> theLock(theMutex);
+
+  Row theRow;
+  theRow.theStream = theStream;
+  theRow.start = fillData.size();
+  theRow.size = n;
+  fillRows.push_back(theRow);
+  fillData.insert(fillData.end(), data, data+n);
+  pendingRows[theStream]++;
+
+  // hand the buffer over when full; wait only if the writer is still busy
+  if (fillData.size() >= ASYNC_WRITER_BUFFER_SIZE) {
+    while (draining == true)
+      doneCond.wait(theLock);
+    this->swapBuffers(theLock);
+  }
+
+  return 0;
+}
+
+
+int
+AsyncStreamWriter::drain(DataFileStream *theStream)
+{
+  std::unique_lock<std::mutex> theLock(theMutex);
+
+  // rows of the stream the writer is not busy with are in the fill buffer,
+  // which is handed over with the rows of the other streams in it
+  while (pendingRows.find(theStream) != pendingRows.end()) {
+    if (draining == false)
+      this->swapBuffers(theLock);
+    doneCond.wait(theLock);
+  }
+
+  return 0;
+}
+
+
+int
+AsyncStreamWriter::drain(void)
+{
+  std::unique_lock<std::mutex> theLock(theMutex);
+
+  while (draining == true)
+    doneCond.wait(theLock);
+
+  if (fillRows.empty() == false) {
+    this->swapBuffers(theLock);
+    while (draining == true)
+      doneCond.wait(theLock);
+  }
+
+  return 0;
+}
+
+
+// invoked with the lock held and the writer idle
+void
+AsyncStreamWriter::swapBuffers(std::unique_lock<std::mutex> &theLock)
+{
+  fillData.swap(drainData);
+  fillRows.swap(drainRows);
+  draining = true;
+  workCond.notify_one();
+}
+
+
+void
+AsyncStreamWriter::run(void)
+{
+  std::unique_lock<std::mutex> theLock(theMutex);
+
+  while (true) {
+    while (draining == false && done == false)
+      workCond.wait(theLock);
+
+    if (draining == false && done == true)
+      break;
+
+    // format and write without holding the lock, the analysis
+    // thread carries on filling the other buffer meanwhile
+    theLock.unlock();
+
+    const double *data = drainData.empty() ? 0 : &drainData[0];
+    for (size_t i=0; i<drainRows.size(); i++) {
+      const Row &theRow = drainRows[i];
+      theRow.theStream->writeData(data+theRow.start, theRow.size);
+    }
+
+    theLock.lock();
+
+    for (size_t i=0; i<drainRows.size(); i++) {
+      std::map<DataFileStream *, int>::iterator thePending = pendingRows.find(drainRows[i].theStream);
+      if (--(thePending->second) == 0)
+        pendingRows.erase(thePending);
+    }
+
+    drainData.clear();
+    drainRows.clear();
+    draining = false;
+    doneCond.notify_all();
+  }
+}
@@ -0,0 +1,82 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef AsyncStreamWriter_h
+#define AsyncStreamWriter_h
+
+// Description: This file contains the class definition for AsyncStreamWriter.
+// The AsyncStreamWriter takes the rows of data written by the recorders to
+// DataFileStream objects opened for asynchronous output. The analysis thread
+// only copies the raw doubles into the fill buffer; once that buffer is large
+// enough it is swapped with the drain buffer, which a background thread
+// formats and writes to the files. The analysis thread waits only when it has
+// filled a buffer before the writer has finished with the previous one.
+// The rows still pending are counted per stream, so a stream that has to be
+// in sync waits only for its own rows, and not at all if it has none.
+
+#include <vector>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class DataFileStream;
+
+class AsyncStreamWriter
+{
+  public:
+    // queue a row of data for theStream
+    static int write(DataFileStream *theStream, const double *data, int n);
+
+    // return once all the rows queued so far for theStream have been written
+    static int flush(DataFileStream *theStream);
+
+  private:
+    AsyncStreamWriter();
+    ~AsyncStreamWriter();
+
+    static AsyncStreamWriter &getWriter(void);
+
+    int queue(DataFileStream *theStream, const double *data, int n);
+    int drain(DataFileStream *theStream);
+    int drain(void);
+    void swapBuffers(std::unique_lock<std::mutex> &theLock);
+    void run(void);
+
+    struct Row {
+      DataFileStream *theStream;
+      int start;
+      int size;
+    };
+
+    std::vector<double> fillData, drainData;
+    std::vector<Row> fillRows, drainRows;
+    std::map<DataFileStream *, int> pendingRows;   // queued and not yet written, per stream
+
+    bool draining;                    // drain buffer handed to the writer thread
+    bool done;
+
+    std::mutex theMutex;
+    std::condition_variable workCond;
+    std::condition_variable doneCond;
+    std::thread theThread;
+};
+
+#endif
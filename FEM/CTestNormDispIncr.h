@@ -62,6 +62,11 @@ public:
     int getMaxNumTests(void);        
     double getRatioNumToMax(void);                
     const Vector &getNorms(void);    
+
+    // the test is on the norm of the displacement increment; if it is called
+    // before the unbalance is formed, the unbalance it prints is the one the
+    // increment was solved for
+    bool usesUnbalance(void) {return false;};
     
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);    
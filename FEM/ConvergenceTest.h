@@ -60,6 +60,11 @@ class ConvergenceTest: public MovableObject
     virtual int getMaxNumTests(void) =0;        
     virtual double getRatioNumToMax(void) =0;            
     virtual const Vector &getNorms(void) =0;
+
+    // false if test() depends only on the solution of the last iteration, in
+    // which case it can be called before the unbalance at the new trial state
+    // is formed
+    virtual bool usesUnbalance(void) {return true;};
     
     
   protected:
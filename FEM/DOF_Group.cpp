@@ -642,6 +642,13 @@ DOF_Group::setNodeAccel(const Vector &udotdot)
 }
 
 
+bool
+DOF_Group::hasPlainNodeResponse(void) const
+{
+    return (myNode != 0);
+}
+
+
 // void setNodeIncrDisp(const Vector &u);
 //	Method to set the corresponding nodes displacements to the
 //	values in u, components identified by myID;
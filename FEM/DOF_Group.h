@@ -93,6 +93,10 @@ class DOF_Group: public TaggedObject
     virtual void setNodeVel(const Vector &udot);
     virtual void setNodeAccel(const Vector &udotdot);
 
+    // true if setNodeDisp/Vel/Accel() just copy u(myID) to the node, so that
+    // the AnalysisModel may set the Domain's nodal state arrays directly
+    virtual bool hasPlainNodeResponse(void) const;
+
     virtual void incrNodeDisp(const Vector &u);
     virtual void incrNodeVel(const Vector &udot);
     virtual void incrNodeAccel(const Vector &udotdot);
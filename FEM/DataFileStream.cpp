@@ -32,6 +32,15 @@
 #include <Channel.h>
 #include <Message.h>
 #include <Matrix.h>
+#include <AsyncStreamWriter.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
 
 using std::cerr;
 using std::ios;
@@ -43,7 +52,8 @@ using std::getline;
 DataFileStream::DataFileStream(int indent)
   :OPS_Stream(OPS_STREAM_TAGS_DataFileStream), 
    fileOpen(0), fileName(0), indentSize(indent), sendSelfCount(0), theChannels(0), numDataRows(0),
-   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0), doCSV(0)
+   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0), doCSV(0),
+   closeOnWrite(false), asyncWrite(false)
 {
   if (indentSize < 1) indentSize = 1;
   indentString = new char[indentSize+5];
@@ -52,13 +62,13 @@ DataFileStream::DataFileStream(int indent)
 }
 
 
-DataFileStream::DataFileStream(const char *file, openMode mode, int indent, int csv, bool closeWrite, int prec, bool scientific)
+DataFileStream::DataFileStream(const char *file, openMode mode, int indent, int csv, bool closeWrite, int prec, bool scientific, bool async)
   :OPS_Stream(OPS_STREAM_TAGS_DataFileStream), 
    fileOpen(0), fileName(0), indentSize(indent), sendSelfCount(0), 
    theChannels(0), numDataRows(0),
    mapping(0), maxCount(0), sizeColumns(0), 
    theColumns(0), theData(0), theRemoteData(0), 
-   doCSV(csv), closeOnWrite(closeWrite)
+   doCSV(csv), closeOnWrite(closeWrite), asyncWrite(async)
 {
   thePrecision = prec;
   doScientific = scientific;
@@ -74,6 +84,8 @@ DataFileStream::DataFileStream(const char *file, openMode mode, int indent, int
 
 DataFileStream::~DataFileStream()
 {
+  this->syncAsync();
+
   if (fileOpen == 1)
     theFile.close();
 
@@ -113,6 +125,8 @@ DataFileStream::~DataFileStream()
 int 
 DataFileStream::setFile(const char *name, openMode mode)
 {
+  this->syncAsync();
+
   if (name == 0) {
     std::cerr << "DataFileStream::setFile() - no name passed\n";
     return -1;
@@ -189,6 +203,8 @@ DataFileStream::open(void)
 int 
 DataFileStream::close(void)
 {
+  this->syncAsync();
+
   if (fileOpen != 0)
     theFile.close();
   fileOpen = 0;
@@ -197,9 +213,60 @@ DataFileStream::close(void)
 }
 
 
+long long
+DataFileStream::getFileSize(void)
+{
+  this->syncAsync();
+
+  if (fileOpen != 0)
+    theFile.flush();
+  else if (theOpenMode == OVERWRITE)
+    return 0;
+
+  ifstream theSize(fileName, ios::in | ios::binary | ios::ate);
+  if (theSize.is_open() == false)
+    return 0;
+
+  return (long long)theSize.tellg();
+}
+
+
+int
+DataFileStream::setFileSize(long long size)
+{
+  this->close();
+
+  if (fileName == 0) {
+    std::cerr << "DataFileStream::setFileSize() - no file name has been set\n";
+    return -1;
+  }
+
+#ifdef _WIN32
+  int res = -1;
+  int fd = _open(fileName, _O_RDWR | _O_BINARY);
+  if (fd >= 0) {
+    res = _chsize_s(fd, size);
+    _close(fd);
+  }
+#else
+  int res = truncate(fileName, (off_t)size);
+#endif
+  if (res != 0) {
+    std::cerr << "WARNING - DataFileStream::setFileSize()";
+    std::cerr << " - could not cut file " << fileName << " to " << size << " bytes\n";
+    return -1;
+  }
+
+  theOpenMode = APPEND;
+  return 0;
+}
+
+
 int 
 DataFileStream::setPrecision(int prec)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -212,6 +279,8 @@ DataFileStream::setPrecision(int prec)
 int 
 DataFileStream::setFloatField(floatField field)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -276,6 +345,12 @@ DataFileStream::write(Vector &data)
   //
 
   if (sendSelfCount == 0) {
+    // queue a copy of the raw data, the writer thread does the formatting
+    if (asyncWrite == true && closeOnWrite == false) {
+      int size = data.Size();
+      return AsyncStreamWriter::write(this, (size != 0) ? &data(0) : 0, size);
+    }
+
     (*this) << data;  
     if (closeOnWrite == true)
       this->close();
@@ -358,6 +433,8 @@ DataFileStream::write(Vector &data)
 OPS_Stream& 
 DataFileStream::write(const char *s,int n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -370,6 +447,8 @@ DataFileStream::write(const char *s,int n)
 OPS_Stream& 
 DataFileStream::write(const unsigned char*s,int n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -381,6 +460,8 @@ DataFileStream::write(const unsigned char*s,int n)
 OPS_Stream& 
 DataFileStream::write(const signed char*s,int n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -392,6 +473,8 @@ DataFileStream::write(const signed char*s,int n)
 OPS_Stream& 
 DataFileStream::write(const void *s, int n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -403,6 +486,17 @@ DataFileStream::write(const void *s, int n)
 
 OPS_Stream& 
 DataFileStream::write(const double *s, int n)
+{
+  this->syncAsync();
+
+  return this->writeData(s, n);
+}
+
+
+// writeData(): format a row of data into the file; invoked by write() and, 
+// for the rows queued by an asynchronous stream, on the writer thread
+OPS_Stream& 
+DataFileStream::writeData(const double *s, int n)
 {
   numDataRows++;
 
@@ -432,6 +526,8 @@ DataFileStream::write(const double *s, int n)
 OPS_Stream& 
 DataFileStream::operator<<(char c)
 {  
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -443,6 +539,8 @@ DataFileStream::operator<<(char c)
 OPS_Stream& 
 DataFileStream::operator<<(unsigned char c)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -454,6 +552,8 @@ DataFileStream::operator<<(unsigned char c)
 OPS_Stream& 
 DataFileStream::operator<<(signed char c)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -465,6 +565,8 @@ DataFileStream::operator<<(signed char c)
 OPS_Stream& 
 DataFileStream::operator<<(const char *s)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -480,6 +582,8 @@ DataFileStream::operator<<(const char *s)
 OPS_Stream& 
 DataFileStream::operator<<(const unsigned char *s)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -491,6 +595,8 @@ DataFileStream::operator<<(const unsigned char *s)
 OPS_Stream& 
 DataFileStream::operator<<(const signed char *s)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -502,6 +608,8 @@ DataFileStream::operator<<(const signed char *s)
 OPS_Stream& 
 DataFileStream::operator<<(const void *p)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -514,6 +622,8 @@ DataFileStream::operator<<(const void *p)
 OPS_Stream& 
 DataFileStream::operator<<(int n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -525,6 +635,8 @@ DataFileStream::operator<<(int n)
 OPS_Stream& 
 DataFileStream::operator<<(unsigned int n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -536,6 +648,8 @@ DataFileStream::operator<<(unsigned int n)
 OPS_Stream& 
 DataFileStream::operator<<(long n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -548,6 +662,8 @@ DataFileStream::operator<<(long n)
 OPS_Stream& 
 DataFileStream::operator<<(unsigned long n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -560,6 +676,8 @@ DataFileStream::operator<<(unsigned long n)
 OPS_Stream& 
 DataFileStream::operator<<(short n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -572,6 +690,8 @@ DataFileStream::operator<<(short n)
 OPS_Stream& 
 DataFileStream::operator<<(unsigned short n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -584,6 +704,8 @@ DataFileStream::operator<<(unsigned short n)
 OPS_Stream& 
 DataFileStream::operator<<(bool b)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -596,6 +718,8 @@ DataFileStream::operator<<(bool b)
 OPS_Stream& 
 DataFileStream::operator<<(double n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -607,6 +731,8 @@ DataFileStream::operator<<(double n)
 OPS_Stream& 
 DataFileStream::operator<<(float n)
 {
+  this->syncAsync();
+
   if (fileOpen == 0)
     this->open();
 
@@ -620,6 +746,8 @@ DataFileStream::operator<<(float n)
 int 
 DataFileStream::sendSelf(int commitTag, Channel &theChannel)
 {
+  this->syncAsync();
+
   sendSelfCount++;
 
   Channel **theNextChannels = new Channel *[sendSelfCount];
@@ -663,6 +791,8 @@ DataFileStream::sendSelf(int commitTag, Channel &theChannel)
 int 
 DataFileStream::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
+  this->syncAsync();
+
   static ID idData(3);
 
   sendSelfCount = -1;
@@ -712,6 +842,16 @@ DataFileStream::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &t
 }
 
 
+// syncAsync(): before the file is used from this thread wait for the writer
+// thread to finish with the rows still queued for this stream
+void
+DataFileStream::syncAsync(void)
+{
+  if (asyncWrite == true)
+    AsyncStreamWriter::flush(this);
+}
+
+
 void
 DataFileStream::indent(void)
 {
@@ -724,6 +864,8 @@ DataFileStream::indent(void)
 int
 DataFileStream::setOrder(const ID &orderData)
 {
+  this->syncAsync();
+
   if (sendSelfCount == 0)
     return 0;
 
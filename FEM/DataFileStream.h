@@ -36,7 +36,7 @@ class DataFileStream : public OPS_Stream
 {
  public:
   DataFileStream(int indent=2);
-  DataFileStream(const char *fileName, openMode mode = OVERWRITE, int indent=2, int doCSV =0, bool closeOnWrite = false, int precision = 6, bool doScientific = false);
+  DataFileStream(const char *fileName, openMode mode = OVERWRITE, int indent=2, int doCSV =0, bool closeOnWrite = false, int precision = 6, bool doScientific = false, bool async = false);
   ~DataFileStream();
 
   int setFile(const char *fileName, openMode mode = OVERWRITE);
@@ -49,6 +49,12 @@ class DataFileStream : public OPS_Stream
   int width(int width) {return 0;};
   const char *getFileName(void) {return fileName;}
 
+  // the size of the file with all the data written so far in it, and to cut
+  // the file back to a size given by getFileSize() and append from there,
+  // e.g. when an analysis is resumed from a checkpoint
+  long long getFileSize(void);
+  int setFileSize(long long size);
+
   // xml stuff
   int tag(const char *);
   int tag(const char *, const char *);
@@ -89,6 +95,10 @@ class DataFileStream : public OPS_Stream
 	       FEM_ObjectBroker &theBroker);
 
  private:
+  friend class AsyncStreamWriter;
+  OPS_Stream& writeData(const double *s, int n);
+  void syncAsync(void);
+
   ofstream theFile;
   int fileOpen;
   openMode theOpenMode;
@@ -115,6 +125,8 @@ class DataFileStream : public OPS_Stream
 
   int thePrecision;
   bool doScientific;
+
+  bool asyncWrite;              // rows from write(Vector &) go through the AsyncStreamWriter
 };
 
 #endif
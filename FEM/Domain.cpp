@@ -34,6 +34,7 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <algorithm>
 
 #include <OPS_Globals.h>
 #include <Domain.h>
@@ -45,6 +46,8 @@
 #include <NodalLoadIter.h>
 #include <Element.h>
 #include <Node.h>
+#include <DOF_Group.h>
+#include <NodalKinematicState.h>
 #include <SP_Constraint.h>
 #include <Pressure_Constraint.h>
 #include <MP_Constraint.h>
@@ -74,6 +77,7 @@
 #include <Analysis.h>
 #include <FE_Datastore.h>
 #include <FEM_ObjectBroker.h>
+#include <SnapshotChannel.h>
 
 
 //
@@ -95,7 +99,12 @@ Domain::Domain()
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalDampingFactors(0), inclModalMatrix(false),
  lastChannel(0),
- paramIndex(0), paramSize(0), numParameters(0)
+ paramIndex(0), paramSize(0), numParameters(0),
+ theInfluenceSetter(0),
+ flatStorageFlag(false), flatStorageBuilt(false),
+ theFlatNodes(0), numFlatNodes(0), theFlatElements(0), numFlatElements(0),
+ flatNodeIndex(0), flatNodeTagMin(0), flatNodeTagRange(0),
+ flatEleIndex(0), flatEleTagMin(0), flatEleTagRange(0), theNodalState(0)
 {
   
     // init the arrays for storing the domain components
@@ -149,7 +158,12 @@ Domain::Domain(int numNodes, int numElements, int numSPs, int numMPs,
  theRegions(0), numRegions(0), commitTag(0),
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0), paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0), paramIndex(0), paramSize(0), numParameters(0),
+ theInfluenceSetter(0),
+ flatStorageFlag(false), flatStorageBuilt(false),
+ theFlatNodes(0), numFlatNodes(0), theFlatElements(0), numFlatElements(0),
+ flatNodeIndex(0), flatNodeTagMin(0), flatNodeTagRange(0),
+ flatEleIndex(0), flatEleTagMin(0), flatEleTagRange(0), theNodalState(0)
 {
     // init the arrays for storing the domain components
     theElements = new MapOfTaggedObjects();
@@ -209,7 +223,12 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
  theRegions(0), numRegions(0), commitTag(0),
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ theInfluenceSetter(0),
+ flatStorageFlag(false), flatStorageBuilt(false),
+ theFlatNodes(0), numFlatNodes(0), theFlatElements(0), numFlatElements(0),
+ flatNodeIndex(0), flatNodeTagMin(0), flatNodeTagRange(0),
+ flatEleIndex(0), flatEleTagMin(0), flatEleTagRange(0), theNodalState(0)
 {
     // init the arrays for storing the domain components
     thePCs      = new MapOfTaggedObjects();
@@ -267,7 +286,12 @@ Domain::Domain(TaggedObjectStorage &theStorage)
  theRegions(0), numRegions(0), commitTag(0),
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ theInfluenceSetter(0),
+ flatStorageFlag(false), flatStorageBuilt(false),
+ theFlatNodes(0), numFlatNodes(0), theFlatElements(0), numFlatElements(0),
+ flatNodeIndex(0), flatNodeTagMin(0), flatNodeTagRange(0),
+ flatEleIndex(0), flatEleTagMin(0), flatEleTagRange(0), theNodalState(0)
 {
     // init the arrays for storing the domain components
     theStorage.clearAll(); // clear the storage just in case populated
@@ -395,6 +419,8 @@ Domain::~Domain()
   
   theRecorders = 0;
   numRecorders = 0;
+
+  this->clearFlatStorage();
 }
 
 
@@ -931,6 +957,7 @@ Domain::clearAll(void) {
     thePattern->clearAll();
 
   // clean out the containers
+  this->clearFlatStorage();
   theElements->clearAll();
   theNodes->clearAll();
   theSPs->clearAll();
@@ -939,6 +966,7 @@ Domain::clearAll(void) {
   theLoadPatterns->clearAll();
   theParameters->clearAll();
   numParameters = 0;
+  theInfluenceSetter = 0;
 
   // remove the recorders
   int i;
@@ -1256,6 +1284,9 @@ Domain::removeLoadPattern(int tag)
     LoadPattern *result = (LoadPattern *)obj;
     // result->setDomain(0);
 
+    if (theInfluenceSetter == result)
+      theInfluenceSetter = 0;
+
     //
     // now set the Domain pointer for all loads and SP constraints 
     // in the loadPattern to be 0
@@ -1407,6 +1438,16 @@ Domain::getParameters()
 Element *
 Domain::getElement(int tag) 
 {
+  if (flatStorageBuilt == true) {
+    int index = tag - flatEleTagMin;
+    if (index >= 0 && index < flatEleTagRange) {
+      index = flatEleIndex[index];
+      return (index < 0) ? 0 : theFlatElements[index];
+    }
+    if (flatEleIndex != 0)
+      return 0;
+  }
+
   TaggedObject *mc = theElements->getComponentPtr(tag);
   
   // if not there return 0 otherwise perform a cast and return that
@@ -1420,6 +1461,16 @@ Domain::getElement(int tag)
 Node *
 Domain::getNode(int tag) 
 {
+  if (flatStorageBuilt == true) {
+    int index = tag - flatNodeTagMin;
+    if (index >= 0 && index < flatNodeTagRange) {
+      index = flatNodeIndex[index];
+      return (index < 0) ? 0 : theFlatNodes[index];
+    }
+    if (flatNodeIndex != 0)
+      return 0;
+  }
+
   TaggedObject *mc = theNodes->getComponentPtr(tag);
 
   // if not there return 0 otherwise perform a cast and return that  
@@ -1756,16 +1807,24 @@ Domain::applyLoad(double timeStep)
     // first loop over nodes and elements getting them to first zero their loads
     //
 
-    Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0)
+    if (this->useFlatStorage() == true) {
+      for (int i=0; i<numFlatNodes; i++)
+	theFlatNodes[i]->zeroUnbalancedLoad();
+      for (int i=0; i<numFlatElements; i++)
+	if (theFlatElements[i]->isSubdomain() == false)
+	  theFlatElements[i]->zeroLoad();
+    } else {
+      Node *nodePtr;
+      NodeIter &theNodeIter = this->getNodes();
+      while ((nodePtr = theNodeIter()) != 0)
 	nodePtr->zeroUnbalancedLoad();
 
-    Element *elePtr;
-    ElementIter &theElemIter = this->getElements();    
-    while ((elePtr = theElemIter()) != 0)
+      Element *elePtr;
+      ElementIter &theElemIter = this->getElements();    
+      while ((elePtr = theElemIter()) != 0)
 	if (elePtr->isSubdomain() == false)
-	    elePtr->zeroLoad();    
+	  elePtr->zeroLoad();    
+    }
 
     // now loop over load patterns, invoking applyLoad on them
     LoadPattern *thePattern;
@@ -1877,16 +1936,26 @@ Domain::commit(void)
     // 
     // first invoke commit on all nodes and elements in the domain
     //
-    Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0) {
-      nodePtr->commitState();
-    }
+    if (this->useFlatStorage() == true) {
+      if (theNodalState != 0 && theNodalState->hasAllNodes() == true)
+	theNodalState->commit();
+      else
+	for (int i=0; i<numFlatNodes; i++)
+	  theFlatNodes[i]->commitState();
+      for (int i=0; i<numFlatElements; i++)
+	theFlatElements[i]->commitState();
+    } else {
+      Node *nodePtr;
+      NodeIter &theNodeIter = this->getNodes();
+      while ((nodePtr = theNodeIter()) != 0) {
+	nodePtr->commitState();
+      }
 
-    Element *elePtr;
-    ElementIter &theElemIter = this->getElements();    
-    while ((elePtr = theElemIter()) != 0) {
-      elePtr->commitState();
+      Element *elePtr;
+      ElementIter &theElemIter = this->getElements();    
+      while ((elePtr = theElemIter()) != 0) {
+	elePtr->commitState();
+      }
     }
 
     // set the new committed time in the domain
@@ -1910,15 +1979,25 @@ Domain::revertToLastCommit(void)
     // first invoke revertToLastCommit  on all nodes and elements in the domain
     //
     
-    Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0)
+    if (this->useFlatStorage() == true) {
+      if (theNodalState != 0 && theNodalState->hasAllNodes() == true)
+	theNodalState->revertToLastCommit();
+      else
+	for (int i=0; i<numFlatNodes; i++)
+	  theFlatNodes[i]->revertToLastCommit();
+      for (int i=0; i<numFlatElements; i++)
+	theFlatElements[i]->revertToLastCommit();
+    } else {
+      Node *nodePtr;
+      NodeIter &theNodeIter = this->getNodes();
+      while ((nodePtr = theNodeIter()) != 0)
 	nodePtr->revertToLastCommit();
     
-    Element *elePtr;
-    ElementIter &theElemIter = this->getElements();    
-    while ((elePtr = theElemIter()) != 0) {
+      Element *elePtr;
+      ElementIter &theElemIter = this->getElements();    
+      while ((elePtr = theElemIter()) != 0) {
 	elePtr->revertToLastCommit();
+      }
     }
 
     // set the current time and load factor in the domain to last committed
@@ -1939,15 +2018,22 @@ Domain::revertToStart(void)
     // elements in the domain
     //
 
-    Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0) 
+    if (this->useFlatStorage() == true) {
+      for (int i=0; i<numFlatNodes; i++)
+	theFlatNodes[i]->revertToStart();
+      for (int i=0; i<numFlatElements; i++)
+	theFlatElements[i]->revertToStart();
+    } else {
+      Node *nodePtr;
+      NodeIter &theNodeIter = this->getNodes();
+      while ((nodePtr = theNodeIter()) != 0) 
 	nodePtr->revertToStart();
 
-    Element *elePtr;
-    ElementIter &theElements = this->getElements();    
-    while ((elePtr = theElements()) != 0) {
+      Element *elePtr;
+      ElementIter &theElements = this->getElements();    
+      while ((elePtr = theElements()) != 0) {
 	elePtr->revertToStart();
+      }
     }
 
     // ADDED BY TERJE //////////////////////////////////
@@ -1977,12 +2063,20 @@ Domain::update(void)
   int ok = 0;
 
   // invoke update on all the ele's
-  ElementIter &theEles = this->getElements();
-  Element *theEle;
+  if (this->useFlatStorage() == true) {
+    for (int i=0; i<numFlatElements; i++) {
+      Element *theEle = theFlatElements[i];
+      ops_TheActiveElement = theEle;
+      ok += theEle->update();
+    }
+  } else {
+    ElementIter &theEles = this->getElements();
+    Element *theEle;
 
-  while ((theEle = theEles()) != 0) {
-    ops_TheActiveElement = theEle;
-    ok += theEle->update();
+    while ((theEle = theEles()) != 0) {
+      ops_TheActiveElement = theEle;
+      ok += theEle->update();
+    }
   }
 
   if (ok != 0)
@@ -2139,10 +2233,322 @@ Domain::setDomainChangeStamp(int newStamp)
 }
 
 
+// returns the stamp hasDomainChanged() last returned, without resetting
+// the change flag
+int
+Domain::getDomainChangeStamp(void)
+{
+    return currentGeoTag;
+}
+
+
+// the load pattern the influence vectors R of the nodes were last set by,
+// so that a pattern sets them again only if another one has changed them
+void
+Domain::setInfluenceSetter(LoadPattern *thePattern)
+{
+    theInfluenceSetter = thePattern;
+}
+
+
+LoadPattern *
+Domain::getInfluenceSetter(void)
+{
+    return theInfluenceSetter;
+}
+
+
 void
 Domain::domainChange(void)
 {
     hasDomainChangedFlag = true;
+    this->clearFlatStorage();
+
+    // recorders holding on to nodes, elements or responses set them up again
+    for (int i=0; i<numRecorders; i++)
+      if (theRecorders[i] != 0)
+	theRecorders[i]->domainChanged();
+}
+
+
+void
+Domain::setFlatStorage(bool onOff)
+{
+  flatStorageFlag = onOff;
+  if (onOff == false)
+    this->clearFlatStorage();
+}
+
+
+bool
+Domain::hasFlatStorage(void) const
+{
+  return flatStorageFlag;
+}
+
+
+Node **
+Domain::getFlatNodes(int &numNodes)
+{
+  if (this->useFlatStorage() == false) {
+    numNodes = 0;
+    return 0;
+  }
+
+  numNodes = numFlatNodes;
+  return theFlatNodes;
+}
+
+
+Element **
+Domain::getFlatElements(int &numEle)
+{
+  if (this->useFlatStorage() == false) {
+    numEle = 0;
+    return 0;
+  }
+
+  numEle = numFlatElements;
+  return theFlatElements;
+}
+
+
+int
+Domain::getFlatNodeIndex(int tag)
+{
+  if (this->useFlatStorage() == false)
+    return -1;
+
+  if (flatNodeIndex != 0) {
+    int index = tag - flatNodeTagMin;
+    return (index >= 0 && index < flatNodeTagRange) ? flatNodeIndex[index] : -1;
+  }
+
+  for (int i=0; i<numFlatNodes; i++)
+    if (theFlatNodes[i]->getTag() == tag)
+      return i;
+  return -1;
+}
+
+
+int
+Domain::getFlatElementIndex(int tag)
+{
+  if (this->useFlatStorage() == false)
+    return -1;
+
+  if (flatEleIndex != 0) {
+    int index = tag - flatEleTagMin;
+    return (index >= 0 && index < flatEleTagRange) ? flatEleIndex[index] : -1;
+  }
+
+  for (int i=0; i<numFlatElements; i++)
+    if (theFlatElements[i]->getTag() == tag)
+      return i;
+  return -1;
+}
+
+
+NodalKinematicState *
+Domain::getNodalState(void)
+{
+  if (this->useFlatStorage() == false)
+    return 0;
+
+  return theNodalState;
+}
+
+
+bool
+Domain::useFlatStorage(void)
+{
+  if (flatStorageFlag == false)
+    return false;
+
+  if (flatStorageBuilt == false && this->buildFlatStorage() != 0)
+    return false;
+
+  return true;
+}
+
+
+// build the flat arrays: nodes ordered by the lowest equation number
+// of their DOF_Group (tag order for nodes with no dof numbering yet),
+// elements by the lowest key of their nodes, so that the element and node 
+// loops sweep the model in the same order as the system of equations
+int
+Domain::buildFlatStorage(void)
+{
+  this->clearFlatStorage();
+
+  int numNod = theNodes->getNumComponents();
+  int numEle = theElements->getNumComponents();
+
+  theFlatNodes = new Node *[numNod+1];
+  theFlatElements = new Element *[numEle+1];
+  double *nodeKey = new double[numNod+1];
+  double *eleKey = new double[numEle+1];
+  if (theFlatNodes == 0 || theFlatElements == 0 || nodeKey == 0 || eleKey == 0) {
+    opserr << "Domain::buildFlatStorage() - out of memory\n";
+    if (nodeKey != 0) delete [] nodeKey;
+    if (eleKey != 0) delete [] eleKey;
+    this->clearFlatStorage();
+    return -1;
+  }
+
+  // nodes, in tag order from the storage object
+  Node *nodePtr;
+  NodeIter &theNodeIter = this->getNodes();
+  int minTag = 0;
+  int maxTag = 0;
+  while ((nodePtr = theNodeIter()) != 0) {
+    int tag = nodePtr->getTag();
+    if (numFlatNodes == 0 || tag < minTag) minTag = tag;
+    if (numFlatNodes == 0 || tag > maxTag) maxTag = tag;
+    theFlatNodes[numFlatNodes++] = nodePtr;
+  }
+
+  // sort key: lowest equation number; unnumbered nodes keep tag order after those
+  for (int i=0; i<numFlatNodes; i++) {
+    double key = 2147483648.0 + i;
+    DOF_Group *theDOF = theFlatNodes[i]->getDOF_GroupPtr();
+    if (theDOF != 0) {
+      const ID &theEqns = theDOF->getID();
+      for (int j=0; j<theEqns.Size(); j++)
+	if (theEqns(j) >= 0 && theEqns(j) < key)
+	  key = theEqns(j);
+    }
+    nodeKey[i] = key;
+  }
+  this->sortFlatStorage((void **)theFlatNodes, nodeKey, numFlatNodes);
+
+  // tag -> index map, a dense array over the tag range when that is not too sparse
+  if (numFlatNodes != 0 && (double)maxTag - minTag < 4.0*numFlatNodes + 1024) {
+    flatNodeTagMin = minTag;
+    flatNodeTagRange = maxTag - minTag + 1;
+    flatNodeIndex = new int[flatNodeTagRange];
+    if (flatNodeIndex == 0)
+      flatNodeTagRange = 0;
+    else {
+      for (int i=0; i<flatNodeTagRange; i++)
+	flatNodeIndex[i] = -1;
+      for (int i=0; i<numFlatNodes; i++) {
+	flatNodeIndex[theFlatNodes[i]->getTag()-minTag] = i;
+      }
+    }
+  }
+
+  // elements, keyed on the position of their first node in the node array
+  Element *elePtr;
+  ElementIter &theElemIter = this->getElements();
+  while ((elePtr = theElemIter()) != 0) {
+    int tag = elePtr->getTag();
+    if (numFlatElements == 0 || tag < minTag) minTag = tag;
+    if (numFlatElements == 0 || tag > maxTag) maxTag = tag;
+
+    double key = numFlatNodes + numFlatElements;
+    const ID &theNodes = elePtr->getExternalNodes();
+    for (int j=0; j<theNodes.Size(); j++) {
+      int index = theNodes(j) - flatNodeTagMin;
+      index = (flatNodeIndex != 0 && index >= 0 && index < flatNodeTagRange) ? flatNodeIndex[index] : -1;
+      if (index >= 0 && index < key)
+	key = index;
+    }
+    eleKey[numFlatElements] = key;
+    theFlatElements[numFlatElements++] = elePtr;
+  }
+  this->sortFlatStorage((void **)theFlatElements, eleKey, numFlatElements);
+
+  if (numFlatElements != 0 && (double)maxTag - minTag < 4.0*numFlatElements + 1024) {
+    flatEleTagMin = minTag;
+    flatEleTagRange = maxTag - minTag + 1;
+    flatEleIndex = new int[flatEleTagRange];
+    if (flatEleIndex == 0)
+      flatEleTagRange = 0;
+    else {
+      for (int i=0; i<flatEleTagRange; i++)
+	flatEleIndex[i] = -1;
+      for (int i=0; i<numFlatElements; i++)
+	flatEleIndex[theFlatElements[i]->getTag()-minTag] = i;
+    }
+  }
+
+  delete [] nodeKey;
+  delete [] eleKey;
+
+  // the nodes now view their response into the arrays of the nodal state
+  theNodalState = new NodalKinematicState(theFlatNodes, numFlatNodes);
+
+  flatStorageBuilt = true;
+  return 0;
+}
+
+
+// stable sort of the objects on key, ties keep their current order
+struct FlatStorageEntry {
+  double key;
+  int pos;
+  void *theObject;
+};
+
+static bool
+flatStorageLess(const FlatStorageEntry &a, const FlatStorageEntry &b)
+{
+  return (a.key < b.key) || (a.key == b.key && a.pos < b.pos);
+}
+
+void
+Domain::sortFlatStorage(void **theObjects, double *key, int num)
+{
+  if (num < 2)
+    return;
+
+  FlatStorageEntry *theEntries = new FlatStorageEntry[num];
+  for (int i=0; i<num; i++) {
+    theEntries[i].key = key[i];
+    theEntries[i].pos = i;
+    theEntries[i].theObject = theObjects[i];
+  }
+
+  std::sort(theEntries, theEntries+num, flatStorageLess);
+
+  for (int i=0; i<num; i++) {
+    theObjects[i] = theEntries[i].theObject;
+    key[i] = theEntries[i].key;
+  }
+
+  delete [] theEntries;
+}
+
+
+void
+Domain::clearFlatStorage(void)
+{
+  // give the nodes their state back before the node array goes
+  if (theNodalState != 0)
+    delete theNodalState;
+  theNodalState = 0;
+
+  if (theFlatNodes != 0)
+    delete [] theFlatNodes;
+  if (theFlatElements != 0)
+    delete [] theFlatElements;
+  if (flatNodeIndex != 0)
+    delete [] flatNodeIndex;
+  if (flatEleIndex != 0)
+    delete [] flatEleIndex;
+
+  theFlatNodes = 0;
+  theFlatElements = 0;
+  flatNodeIndex = 0;
+  flatEleIndex = 0;
+  numFlatNodes = 0;
+  numFlatElements = 0;
+  flatNodeTagMin = 0;
+  flatNodeTagRange = 0;
+  flatEleTagMin = 0;
+  flatEleTagRange = 0;
+  flatStorageBuilt = false;
 }
 
 
@@ -2165,6 +2571,9 @@ Domain::hasDomainChanged(void)
 	currentGeoTag++;
 	nodeGraphBuiltFlag = false;
 	eleGraphBuiltFlag = false;
+	// the caller is about to renumber the dofs, rebuild the flat
+	// storage in the new equation order when next needed
+	this->clearFlatStorage();
     }
 
     // return the integer so user can determine if domain has changed 
@@ -3315,6 +3724,7 @@ Domain::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 
     lastGeoSendTag = currentGeoTag;
     hasDomainChangedFlag = false;
+    this->clearFlatStorage();
 
   } else {
 
@@ -3392,6 +3802,109 @@ Domain::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
   return 0;
 }
 
+// copies theObject into theCopy by sending it to theChannel and having
+// the copy receive what was sent
+static int
+copyObject(MovableObject &theObject, MovableObject &theCopy,
+	   SnapshotChannel &theChannel, FEM_ObjectBroker &theBroker)
+{
+  theChannel.clear();
+  if (theObject.sendSelf(0, theChannel) < 0)
+    return -1;
+  theChannel.rewind();
+  return theCopy.recvSelf(0, theChannel, theBroker);
+}
+
+
+Domain *
+Domain::getCopy(FEM_ObjectBroker &theBroker)
+{
+  Domain *theCopy = new Domain();
+  if (theCopy == 0) {
+    opserr << "Domain::getCopy - out of memory\n";
+    return 0;
+  }
+
+  SnapshotChannel theChannel;
+
+  Node *theNode;
+  NodeIter &theNodes = this->getNodes();
+  while ((theNode = theNodes()) != 0) {
+    Node *theNodeCopy = theBroker.getNewNode(theNode->getClassTag());
+    if (theNodeCopy == 0 || copyObject(*theNode, *theNodeCopy, theChannel, theBroker) < 0 ||
+	theCopy->addNode(theNodeCopy) == false) {
+      opserr << "Domain::getCopy - could not copy node with tag " << theNode->getTag() << endln;
+      if (theNodeCopy != 0)
+	delete theNodeCopy;
+      delete theCopy;
+      return 0;
+    }
+  }
+
+  Element *theEle;
+  ElementIter &theElements = this->getElements();
+  while ((theEle = theElements()) != 0) {
+    Element *theEleCopy = theBroker.getNewElement(theEle->getClassTag());
+    if (theEleCopy == 0 || copyObject(*theEle, *theEleCopy, theChannel, theBroker) < 0 ||
+	theCopy->addElement(theEleCopy) == false) {
+      opserr << "Domain::getCopy - could not copy element with tag " << theEle->getTag() << endln;
+      if (theEleCopy != 0)
+	delete theEleCopy;
+      delete theCopy;
+      return 0;
+    }
+  }
+
+  SP_Constraint *theSP;
+  SP_ConstraintIter &theSPs = this->getSPs();
+  while ((theSP = theSPs()) != 0) {
+    SP_Constraint *theSPCopy = theBroker.getNewSP(theSP->getClassTag());
+    if (theSPCopy == 0 || copyObject(*theSP, *theSPCopy, theChannel, theBroker) < 0 ||
+	theCopy->addSP_Constraint(theSPCopy) == false) {
+      opserr << "Domain::getCopy - could not copy SP_Constraint with tag " << theSP->getTag() << endln;
+      if (theSPCopy != 0)
+	delete theSPCopy;
+      delete theCopy;
+      return 0;
+    }
+  }
+
+  MP_Constraint *theMP;
+  MP_ConstraintIter &theMPs = this->getMPs();
+  while ((theMP = theMPs()) != 0) {
+    MP_Constraint *theMPCopy = theBroker.getNewMP(theMP->getClassTag());
+    if (theMPCopy == 0 || copyObject(*theMP, *theMPCopy, theChannel, theBroker) < 0 ||
+	theCopy->addMP_Constraint(theMPCopy) == false) {
+      opserr << "Domain::getCopy - could not copy MP_Constraint with tag " << theMP->getTag() << endln;
+      if (theMPCopy != 0)
+	delete theMPCopy;
+      delete theCopy;
+      return 0;
+    }
+  }
+
+  LoadPattern *theLP;
+  LoadPatternIter &theLPs = this->getLoadPatterns();
+  while ((theLP = theLPs()) != 0) {
+    LoadPattern *theLPCopy = theBroker.getNewLoadPattern(theLP->getClassTag());
+    if (theLPCopy == 0 || copyObject(*theLP, *theLPCopy, theChannel, theBroker) < 0 ||
+	theCopy->addLoadPattern(theLPCopy) == false) {
+      opserr << "Domain::getCopy - could not copy LoadPattern with tag " << theLP->getTag() << endln;
+      if (theLPCopy != 0)
+	delete theLPCopy;
+      delete theCopy;
+      return 0;
+    }
+  }
+
+  theCopy->currentTime = currentTime;
+  theCopy->committedTime = committedTime;
+  theCopy->dT = dT;
+  theCopy->setFlatStorage(flatStorageFlag);
+
+  return theCopy;
+}
+
 
 double
 Domain::getNodeDisp(int nodeTag, int dof, int &errorFlag)
@@ -74,6 +74,7 @@ class Channel;
 class FEM_ObjectBroker;
 
 class TaggedObjectStorage;
+class NodalKinematicState;
 
 class Domain
 {
@@ -205,6 +206,9 @@ class Domain
     virtual bool getDomainChangeFlag(void);    
     virtual void domainChange(void);    
     virtual void setDomainChangeStamp(int newStamp);
+    virtual int getDomainChangeStamp(void);
+    virtual void setInfluenceSetter(LoadPattern *thePattern);
+    virtual LoadPattern *getInfluenceSetter(void);
 
 
     // methods for output
@@ -226,17 +230,42 @@ class Domain
     virtual int recvSelf(int commitTag, Channel &theChannel, 
 			 FEM_ObjectBroker &theBroker);    
 
+    // returns a new Domain holding copies of the nodes, elements, single and
+    // multi point constraints and load patterns, made by having each copy
+    // receive what the original sends; theBroker creates the copies.
+    // Parameters, regions and recorders are not copied. Returns 0 if any
+    // object cannot be copied. Many sendSelf()/recvSelf() methods use static
+    // work areas, so copies are to be made from one thread at a time
+    virtual Domain *getCopy(FEM_ObjectBroker &theBroker);
+
     // nodal methods required in domain interface for parallel interprter
     virtual double getNodeDisp(int nodeTag, int dof, int &errorFlag);
     virtual int setMass(const Matrix &mass, int nodeTag);
 
     virtual int calculateNodalReactions(int flag);
 
+    // flat storage: when set the nodes and elements are also held in
+    // contiguous arrays ordered by equation number, with an O(1) tag to
+    // index map, and the commit/update/load loops run over those arrays;
+    // the nodal response is then held in a NodalKinematicState
+    void setFlatStorage(bool onOff);
+    bool hasFlatStorage(void) const;
+    Node    **getFlatNodes(int &numNodes);
+    Element **getFlatElements(int &numEle);
+    int getFlatNodeIndex(int tag);
+    int getFlatElementIndex(int tag);
+    NodalKinematicState *getNodalState(void);
+
   protected:    
 
     virtual int buildEleGraph(Graph *theEleGraph);
     virtual int buildNodeGraph(Graph *theNodeGraph);
 
+    bool useFlatStorage(void);
+    int  buildFlatStorage(void);
+    void clearFlatStorage(void);
+    void sortFlatStorage(void **theObjects, double *key, int num);
+
     Recorder **theRecorders;
     int numRecorders;    
 
@@ -287,6 +316,8 @@ class Domain
 
     int lastChannel;
 
+    LoadPattern *theInfluenceSetter;  // pattern the R of the nodes were last set by
+
     // Integer array: index[i] = tag of component i
     // Should put these in another class eventually -- MHS
     int *paramIndex;
@@ -294,6 +325,21 @@ class Domain
     enum {paramSize_grow = 20};
     int paramSize;
     int numParameters;
+
+    // flat storage of the nodes and elements, rebuilt when the domain changes
+    bool flatStorageFlag;
+    bool flatStorageBuilt;
+    Node **theFlatNodes;
+    int numFlatNodes;
+    Element **theFlatElements;
+    int numFlatElements;
+    int *flatNodeIndex;               // flatNodeIndex[tag-flatNodeTagMin] = index, -1 if none
+    int flatNodeTagMin;
+    int flatNodeTagRange;
+    int *flatEleIndex;
+    int flatEleTagMin;
+    int flatEleTagRange;
+    NodalKinematicState *theNodalState; // nodal response arrays the flat nodes view into
 };
 
 #endif
@@ -90,16 +90,23 @@ EarthquakePattern::applyLoad(double time)
     (*uDotDotG)(i) = theMotions[i]->getAccel(currentTime);
   }
 
-  NodeIter &theNodes = theDomain->getNodes();
+  this->addInertiaLoads(*theDomain, *uDotDotG);
+}
+
+
+void
+EarthquakePattern::addInertiaLoads(Domain &theDomain, const Vector &accelG)
+{
+  NodeIter &theNodes = theDomain.getNodes();
   Node *theNode;
   while ((theNode = theNodes()) != 0) 
-    theNode->addInertiaLoadToUnbalance(*uDotDotG, 1.0);
+    theNode->addInertiaLoadToUnbalance(accelG, 1.0);
   
 
-  ElementIter &theElements = theDomain->getElements();
+  ElementIter &theElements = theDomain.getElements();
   Element *theElement;
   while ((theElement = theElements()) != 0) 
-    theElement->addInertiaLoadToUnbalance(*uDotDotG);
+    theElement->addInertiaLoadToUnbalance(accelG);
 }
     
 void 
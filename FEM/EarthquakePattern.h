@@ -68,6 +68,11 @@ class EarthquakePattern : public LoadPattern
     
  protected:
     int addMotion(GroundMotion &theMotion);
+
+    // adds the inertia loads for the ground accelerations accelG to the
+    // nodes and elements of the domain
+    virtual void addInertiaLoads(Domain &theDomain, const Vector &accelG);
+
     GroundMotion **theMotions;
     int numMotions;
 
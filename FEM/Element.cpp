@@ -302,6 +302,22 @@ Element::getResistingForceIncInertia(void)
   return *theVector;
 }
 
+const Vector &
+Element::getResistingForceIncInertiaAndTangent(Matrix &theTangent,
+					       double kFact, double cFact, double mFact)
+{
+  // the matrices are added as soon as they are obtained as getDamp() and
+  // getMass() may return the same class wide matrix
+  if (kFact != 0.0)
+    theTangent.addMatrix(1.0, this->getTangentStiff(), kFact);
+  if (cFact != 0.0)
+    theTangent.addMatrix(1.0, this->getDamp(), cFact);
+  if (mFact != 0.0)
+    theTangent.addMatrix(1.0, this->getMass(), mFact);
+
+  return this->getResistingForceIncInertia();
+}
+
 
 const Vector &
 Element::getRayleighDampingForces(void) 
@@ -87,6 +87,12 @@ class Element : public DomainComponent
     virtual const Vector &getResistingForce(void) =0;
     virtual const Vector &getResistingForceIncInertia(void);        
 
+    // method for obtaining the resisting force incl. inertia while adding
+    // kFact*K + cFact*C + mFact*M to theTangent, so elements can share the
+    // work of forming both at the current trial state
+    virtual const Vector &getResistingForceIncInertiaAndTangent(Matrix &theTangent,
+								double kFact, double cFact, double mFact);
+
     // method for obtaining information specific to an element
     virtual Response *setResponse(const char **argv, int argc, 
 				  OPS_Stream &theHandler);
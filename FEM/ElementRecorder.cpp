@@ -276,7 +276,7 @@ OPS_ElementRecorder()
 
 ElementRecorder::ElementRecorder()
 :Recorder(RECORDER_TAGS_ElementRecorder),
- numEle(0), numDOF(0), eleID(0), dof(0), theResponses(0), 
+ numEle(0), numDOF(0), eleID(0), dof(0), theResponses(0), theResponseData(0), 
  theDomain(0), theOutputHandler(0),
  echoTimeFlag(true), deltaT(0), nextTimeStampToRecord(0.0), data(0), 
  initializationDone(false), responseArgs(0), numArgs(0), addColumnInfo(0)
@@ -293,7 +293,7 @@ ElementRecorder::ElementRecorder(const ID *ele,
 				 double dT,
 				 const ID *theDOFs)
 :Recorder(RECORDER_TAGS_ElementRecorder),
- numEle(0), numDOF(0), eleID(0), dof(0), theResponses(0), 
+ numEle(0), numDOF(0), eleID(0), dof(0), theResponses(0), theResponseData(0), 
  theDomain(&theDom), theOutputHandler(&theOutputHandler),
  echoTimeFlag(echoTime), deltaT(dT), nextTimeStampToRecord(0.0), data(0),
  initializationDone(false), responseArgs(0), numArgs(0), addColumnInfo(0)
@@ -357,6 +357,9 @@ ElementRecorder::~ElementRecorder()
       delete theResponses[i];
     delete [] theResponses;
   }
+  if (theResponseData != 0)
+    delete [] theResponseData;
+
 
   if (data != 0)
     delete data;
@@ -406,13 +409,14 @@ ElementRecorder::record(int commitTag, double timeStamp)
 	if (( res = theResponses[i]->getResponse()) < 0)
 	  result += res;
 	else {
-	  Information &eleInfo = theResponses[i]->getInformation();
-	  const Vector &eleData = eleInfo.getData();
+	  // a bound Vector is read directly, anything else is converted
+	  const Vector &eleData = (theResponseData[i] != 0) ? *theResponseData[i] :
+	    theResponses[i]->getInformation().getData();
 	  if (numDOF == 0) {
 	    for (int j=0; j<eleData.Size(); j++)
 	      (*data)(loc++) = eleData(j);
 	  } else {
-	    int dataSize = data->Size();
+	    int dataSize = eleData.Size();
 	    for (int j=0; j<numDOF; j++) {
 	      int index = (*dof)(j);
 	      if (index >= 0 && index < dataSize)
@@ -444,6 +448,15 @@ ElementRecorder::restart(void)
 }
 
 
+int
+ElementRecorder::domainChanged(void)
+{
+  // the elements may have gone, set up the responses again on the next record()
+  initializationDone = false;
+  return 0;
+}
+
+
 int 
 ElementRecorder::setDomain(Domain &theDom)
 {
@@ -730,6 +743,35 @@ ElementRecorder::recvSelf(int commitTag, Channel &theChannel,
   return 0;
 }
 
+int
+ElementRecorder::sendState(int commitTag, Channel &theChannel)
+{
+  static Vector data(1);
+  data(0) = nextTimeStampToRecord;
+
+  if (theChannel.sendVector(0, commitTag, data) < 0) {
+    opserr << "ElementRecorder::sendState() - failed to send the time of the next record\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+ElementRecorder::recvState(int commitTag, Channel &theChannel)
+{
+  static Vector data(1);
+
+  if (theChannel.recvVector(0, commitTag, data) < 0) {
+    opserr << "ElementRecorder::recvState() - failed to receive the time of the next record\n";
+    return -1;
+  }
+  nextTimeStampToRecord = data(0);
+
+  return 0;
+}
+
 int 
 ElementRecorder::initialize(void)
 {
@@ -740,8 +782,22 @@ ElementRecorder::initialize(void)
     for (int i = 0; i < numEle; i++)
       delete theResponses[i];
     delete [] theResponses;
+    theResponses = 0;
+  }
+
+  if (theResponseData != 0) {
+    delete [] theResponseData;
+    theResponseData = 0;
+  }
+
+  if (data != 0) {
+    delete data;
+    data = 0;
   }
 
+  if (eleID != 0)
+    numEle = eleID->Size();
+
   int numDbColumns = 0;
 
   // Set the response objects:
@@ -896,6 +952,28 @@ ElementRecorder::initialize(void)
     numEle = numResponse;
   }
 
+  //
+  // bind the data of the responses that hold a Vector; the Information keeps
+  // the same Vector object, so record() can read it without going through
+  // getInformation() & getData() for each element
+  //
+
+  if (numEle > 0) {
+    theResponseData = new const Vector *[numEle];
+    if (theResponseData == 0) {
+      opserr << "ElementRecorder::initialize() - out of memory\n";
+      return -1;
+    }
+    for (i=0; i<numEle; i++) {
+      theResponseData[i] = 0;
+      if (theResponses[i] != 0) {
+	Information &eleInfo = theResponses[i]->getInformation();
+	if (eleInfo.theType == VectorType && eleInfo.theVector != 0)
+	  theResponseData[i] = eleInfo.theVector;
+      }
+    }
+  }
+
   // create the vector to hold the data
   data = new Vector(numDbColumns);
 
@@ -66,10 +66,14 @@ class ElementRecorder: public Recorder
     int record(int commitTag, double timeStamp);
     int restart(void);    
 
+    int domainChanged(void);
+
     int setDomain(Domain &theDomain);
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
 		 FEM_ObjectBroker &theBroker);
+    int sendState(int commitTag, Channel &theChannel);
+    int recvState(int commitTag, Channel &theChannel);
     
   protected:
 
@@ -84,6 +88,7 @@ class ElementRecorder: public Recorder
     ID *dof;
 
     Response **theResponses;
+    const Vector **theResponseData;    // Information data of theResponses holding a Vector
 
     Domain *theDomain;
     OPS_Stream *theOutputHandler;
@@ -0,0 +1,344 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: This file contains the implementation of
+// FEM_ObjectBrokerAllClasses.
+//
+// What: "@(#) FEM_ObjectBrokerAllClasses.C, revA"
+
+#include <FEM_ObjectBrokerAllClasses.h>
+#include <classTags.h>
+#include <OPS_Globals.h>
+
+// domain components
+#include <Node.h>
+#include <SP_Constraint.h>
+#include <ImposedMotionSP.h>
+#include <MP_Constraint.h>
+#include <NodalLoad.h>
+
+// elements
+#include <ShearColumnUP.h>
+#include <SSPquad.h>
+#include <SSPquadUP.h>
+#include <SSPbrick.h>
+#include <Brick.h>
+#include <ZeroLength.h>
+
+// uniaxial materials
+#include <ElasticMaterial.h>
+#include <ViscousMaterial.h>
+#include <PySimple1.h>
+#include <QzSimple1.h>
+#include <TzSimple1.h>
+
+// nD materials
+#include <ElasticIsotropicPlaneStrain2D.h>
+#include <ElasticIsotropicThreeDimensional.h>
+#include <PlaneStrainMaterial.h>
+#include <PlaneStressMaterial.h>
+#include <PlateFiberMaterial.h>
+#include <BeamFiberMaterial.h>
+#include <BeamFiberMaterial2d.h>
+#include <PM4Sand.h>
+#include <PM4Silt.h>
+#include <J2CyclicBoundingSurface.h>
+
+// load patterns, ground motions and time series
+#include <LoadPattern.h>
+#include <UniformExcitation.h>
+#include <MultiSupportPattern.h>
+#include <GroundMotion.h>
+#include <LinearSeries.h>
+#include <PathSeries.h>
+#include <PathTimeSeries.h>
+#include <TrapezoidalTimeSeriesIntegrator.h>
+#include <SimpsonTimeSeriesIntegrator.h>
+
+
+FEM_ObjectBrokerAllClasses::FEM_ObjectBrokerAllClasses()
+{
+
+}
+
+
+FEM_ObjectBrokerAllClasses::~FEM_ObjectBrokerAllClasses()
+{
+
+}
+
+
+Element *
+FEM_ObjectBrokerAllClasses::getNewElement(int classTag)
+{
+  switch(classTag) {
+
+  case ELE_TAG_ShearColumnUP:
+    return new ShearColumnUP();
+
+  case ELE_TAG_SSPquad:
+    return new SSPquad();
+
+  case ELE_TAG_SSPquadUP:
+    return new SSPquadUP();
+
+  case ELE_TAG_SSPbrick:
+    return new SSPbrick();
+
+  case ELE_TAG_Brick:
+    return new Brick();
+
+  case ELE_TAG_ZeroLength:
+    return new ZeroLength();
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewElement - ";
+    opserr << " - no Element type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
+
+
+Node *
+FEM_ObjectBrokerAllClasses::getNewNode(int classTag)
+{
+  switch(classTag) {
+
+  case NOD_TAG_Node:
+    return new Node(classTag);
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewNode - ";
+    opserr << " - no Node type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
+
+
+MP_Constraint *
+FEM_ObjectBrokerAllClasses::getNewMP(int classTag)
+{
+  switch(classTag) {
+
+  case CNSTRNT_TAG_MP_Constraint:
+    return new MP_Constraint(classTag);
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewMP - ";
+    opserr << " - no MP_Constraint type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
+
+
+SP_Constraint *
+FEM_ObjectBrokerAllClasses::getNewSP(int classTag)
+{
+  switch(classTag) {
+
+  case CNSTRNT_TAG_SP_Constraint:
+    return new SP_Constraint(classTag);
+
+  case CNSTRNT_TAG_ImposedMotionSP:
+    return new ImposedMotionSP();
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewSP - ";
+    opserr << " - no SP_Constraint type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
+
+
+NodalLoad *
+FEM_ObjectBrokerAllClasses::getNewNodalLoad(int classTag)
+{
+  switch(classTag) {
+
+  case LOAD_TAG_NodalLoad:
+    return new NodalLoad(classTag);
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewNodalLoad - ";
+    opserr << " - no NodalLoad type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
+
+
+UniaxialMaterial *
+FEM_ObjectBrokerAllClasses::getNewUniaxialMaterial(int classTag)
+{
+  switch(classTag) {
+
+  case MAT_TAG_ElasticMaterial:
+    return new ElasticMaterial();
+
+  case MAT_TAG_Viscous:
+    return new ViscousMaterial();
+
+  case MAT_TAG_PySimple1:
+    return new PySimple1();
+
+  case MAT_TAG_QzSimple1:
+    return new QzSimple1();
+
+  case MAT_TAG_TzSimple1:
+    return new TzSimple1();
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewUniaxialMaterial - ";
+    opserr << " - no UniaxialMaterial type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
+
+
+NDMaterial *
+FEM_ObjectBrokerAllClasses::getNewNDMaterial(int classTag)
+{
+  switch(classTag) {
+
+  case ND_TAG_ElasticIsotropicPlaneStrain2d:
+    return new ElasticIsotropicPlaneStrain2D();
+
+  case ND_TAG_ElasticIsotropicThreeDimensional:
+    return new ElasticIsotropicThreeDimensional();
+
+  case ND_TAG_PlaneStrainMaterial:
+    return new PlaneStrainMaterial();
+
+  case ND_TAG_PlaneStressMaterial:
+    return new PlaneStressMaterial();
+
+  case ND_TAG_PlateFiberMaterial:
+    return new PlateFiberMaterial();
+
+  case ND_TAG_BeamFiberMaterial:
+    return new BeamFiberMaterial();
+
+  case ND_TAG_BeamFiberMaterial2d:
+    return new BeamFiberMaterial2d();
+
+  case ND_TAG_PM4Sand:
+    return new PM4Sand();
+
+  case ND_TAG_PM4Silt:
+    return new PM4Silt();
+
+  case ND_TAG_J2CyclicBoundingSurface:
+    return new J2CyclicBoundingSurface();
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewNDMaterial - ";
+    opserr << " - no NDMaterial type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
+
+
+LoadPattern *
+FEM_ObjectBrokerAllClasses::getNewLoadPattern(int classTag)
+{
+  switch(classTag) {
+
+  case PATTERN_TAG_LoadPattern:
+    return new LoadPattern();
+
+  case PATTERN_TAG_UniformExcitation:
+    return new UniformExcitation();
+
+  case PATTERN_TAG_MultiSupportPattern:
+    return new MultiSupportPattern();
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewLoadPattern - ";
+    opserr << " - no LoadPattern type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
+
+
+GroundMotion *
+FEM_ObjectBrokerAllClasses::getNewGroundMotion(int classTag)
+{
+  switch(classTag) {
+
+  case GROUND_MOTION_TAG_GroundMotion:
+    return new GroundMotion(classTag);
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewGroundMotion - ";
+    opserr << " - no GroundMotion type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
+
+
+TimeSeries *
+FEM_ObjectBrokerAllClasses::getNewTimeSeries(int classTag)
+{
+  switch(classTag) {
+
+  case TSERIES_TAG_LinearSeries:
+    return new LinearSeries();
+
+  case TSERIES_TAG_PathSeries:
+    return new PathSeries();
+
+  case TSERIES_TAG_PathTimeSeries:
+    return new PathTimeSeries();
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewTimeSeries - ";
+    opserr << " - no TimeSeries type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
+
+
+TimeSeriesIntegrator *
+FEM_ObjectBrokerAllClasses::getNewTimeSeriesIntegrator(int classTag)
+{
+  switch(classTag) {
+
+  case TIMESERIES_INTEGRATOR_TAG_Trapezoidal:
+    return new TrapezoidalTimeSeriesIntegrator();
+
+  case TIMESERIES_INTEGRATOR_TAG_Simpson:
+    return new SimpsonTimeSeriesIntegrator();
+
+  default:
+    opserr << "FEM_ObjectBrokerAllClasses::getNewTimeSeriesIntegrator - ";
+    opserr << " - no TimeSeriesIntegrator type exists for class tag ";
+    opserr << classTag << endln;
+    return 0;
+  }
+}
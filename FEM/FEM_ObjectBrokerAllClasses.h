@@ -0,0 +1,54 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Purpose: This file contains the class definition for
+// FEM_ObjectBrokerAllClasses. FEM_ObjectBrokerAllClasses is an object
+// broker that creates blank objects of the modelling classes compiled
+// into this library, so that they can receive themselves from a Channel.
+//
+// What: "@(#) FEM_ObjectBrokerAllClasses.h, revA"
+
+#ifndef FEM_ObjectBrokerAllClasses_h
+#define FEM_ObjectBrokerAllClasses_h
+
+#include <FEM_ObjectBroker.h>
+
+class FEM_ObjectBrokerAllClasses : public FEM_ObjectBroker
+{
+  public:
+    FEM_ObjectBrokerAllClasses();
+    ~FEM_ObjectBrokerAllClasses();
+
+    Element       *getNewElement(int classTag);
+    Node          *getNewNode(int classTag);
+    MP_Constraint *getNewMP(int classTag);
+    SP_Constraint *getNewSP(int classTag);
+    NodalLoad     *getNewNodalLoad(int classTag);
+
+    UniaxialMaterial  *getNewUniaxialMaterial(int classTag);
+    NDMaterial *getNewNDMaterial(int classTag);
+
+    LoadPattern *getNewLoadPattern(int classTag);
+    GroundMotion *getNewGroundMotion(int classTag);
+    TimeSeries  *getNewTimeSeries(int classTag);
+    TimeSeriesIntegrator  *getNewTimeSeriesIntegrator(int classTag);
+};
+
+#endif
@@ -334,6 +334,37 @@ FE_Element::getResidual(Integrator *theNewIntegrator)
 }
 
 
+const Vector &
+FE_Element::getResidualAndTangent(Integrator *theNewIntegrator)
+{
+    // FE_Elements with no Element (penalty and multiplier constraint
+    // handlers) and Subdomains form the two separately; for a Subdomain
+    // this class's methods are called, a subclass transforms their results
+    if (myEle == 0)
+      return this->getResidual(theNewIntegrator);
+    if (myEle->isSubdomain() == true)
+      return this->FE_Element::getResidual(theNewIntegrator);
+
+    theIntegrator = theNewIntegrator;
+
+    if (theIntegrator == 0)
+      return *theResidual;
+
+    theIntegrator->formEleResidualAndTangent(this);
+    return *theResidual;
+}
+
+const Matrix &
+FE_Element::getFormedTangent(void)
+{
+    if (myEle == 0)
+      return this->getTangent(theIntegrator);
+    if (myEle->isSubdomain() == true)
+      return this->FE_Element::getTangent(theIntegrator);
+
+    return *theTangent;
+}
+
 
 void  
 FE_Element::zeroTangent(void)
@@ -524,6 +555,28 @@ FE_Element::addRIncInertiaToResidual(double fact)
     }    	        
 }
 
+void  
+FE_Element::addRIncInertiaToResidualAndTang(double fact, double kFact,
+					    double cFact, double mFact)
+{
+    if (myEle != 0) {
+	if (myEle->isSubdomain() == false) {
+	  const Vector &eleResisting = 
+	    myEle->getResistingForceIncInertiaAndTangent(*theTangent, kFact, cFact, mFact);
+	  if (fact != 0.0)
+	    theResidual->addVector(1.0, eleResisting, -fact);
+	}
+	else {
+	    opserr << "WARNING FE_Element::addRIncInertiaToResidualAndTang() - ";
+	    opserr << "- this should not be called on a Subdomain!\n";
+	}    	    	    	
+    }
+    else {
+	opserr << "WARNING FE_Element::addRIncInertiaToResidualAndTang() - no Element *given ";
+	opserr << "- subclasses must provide implementation\n";
+    }    	        
+}
+
 
 const Vector &
 FE_Element::getTangForce(const Vector &disp, double fact)
@@ -61,6 +61,11 @@ class FE_Element: public TaggedObject
     virtual const Matrix &getTangent(Integrator *theIntegrator);
     virtual const Vector &getResidual(Integrator *theIntegrator);
 
+    // methods to form the residual and tangent in a single pass over the
+    // element; the tangent is then obtained with getFormedTangent()
+    virtual const Vector &getResidualAndTangent(Integrator *theIntegrator);
+    virtual const Matrix &getFormedTangent(void);
+
     // methods to allow integrator to build tangent
     virtual void  zeroTangent(void);
     virtual void  addKtToTang(double fact = 1.0);
@@ -75,6 +80,8 @@ class FE_Element: public TaggedObject
     virtual void  zeroResidual(void);    
     virtual void  addRtoResidual(double fact = 1.0);
     virtual void  addRIncInertiaToResidual(double fact = 1.0);    
+    virtual void  addRIncInertiaToResidualAndTang(double fact, double kFact,
+						  double cFact, double mFact);
 
     // methods for ele-by-ele strategies
     virtual const Vector &getTangForce(const Vector &x, double fact = 1.0);
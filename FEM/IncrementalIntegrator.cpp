@@ -143,6 +143,20 @@ IncrementalIntegrator::formUnbalance(void)
 
     return 0;
 }
+
+// forms the unbalance and, where the integrator supports it, the tangent in
+// the same pass over the FE_Elements. returns 0 if both have been formed, 1 if
+// only the unbalance has been (the tangent must then be formed with
+// formTangent()) and a negative value on failure. the base class only forms
+// the unbalance, so algorithms using this do no extra work for static analysis.
+int
+IncrementalIntegrator::formUnbalanceAndTangent(int statFlag)
+{
+    if (this->formUnbalance() < 0)
+      return -1;
+
+    return 1;
+}
     
 int
 IncrementalIntegrator::getLastResponse(Vector &result, const ID &id)
@@ -69,6 +69,7 @@ class IncrementalIntegrator : public Integrator
     // methods to set up the system of equations
     virtual int  formTangent(int statusFlag = CURRENT_TANGENT);    
     virtual int  formUnbalance(void);
+    virtual int  formUnbalanceAndTangent(int statusFlag = CURRENT_TANGENT);
 
     // pure virtual methods to define the FE_ELe and DOF_Group contributions
     virtual int formEleTangent(FE_Element *theEle) =0;
@@ -61,6 +61,17 @@ Integrator::domainChanged()
 }
 
 
+// default: form the residual and then the tangent separately; integrators
+// whose element contributions can share work override this
+int
+Integrator::formEleResidualAndTangent(FE_Element *theEle)
+{
+    if (this->formEleResidual(theEle) < 0)
+      return -1;
+
+    return this->formEleTangent(theEle);
+}
+
 int
 Integrator::formSensitivityRHS(int gradNum)
 {
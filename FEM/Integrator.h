@@ -59,6 +59,7 @@ public:
     virtual int formNodTangent(DOF_Group *theDof) =0;    
     virtual int formEleResidual(FE_Element *theEle) =0;
     virtual int formNodUnbalance(DOF_Group *theDof) =0;    
+    virtual int formEleResidualAndTangent(FE_Element *theEle);
 
     // Methods provided for Domain Decomposition
     virtual int getLastResponse(Vector &result, const ID &id) =0;
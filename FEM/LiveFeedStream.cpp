@@ -0,0 +1,223 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for LiveFeedStream.
+
+#include <LiveFeedStream.h>
+#include <OPS_Globals.h>
+#include <classTags.h>
+#include <Vector.h>
+#include <string.h>
+#include <atomic>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// the layout of the start of the file, see LiveFeedStream.h
+struct LiveFeedHeader {
+  char magic[8];
+  int numColumns;
+  int capacity;
+  volatile int status;
+  volatile int abortRequested;
+  volatile double endTime;
+  volatile long long numRows;
+};
+
+static const char liveFeedMagic[8] = {'S','R','T','F','E','E','D','1'};
+
+LiveFeedStream::LiveFeedStream(const char *file, int cap)
+  :OPS_Stream(OPS_STREAM_TAGS_LiveFeedStream),
+   fileName(0), capacity(cap), numColumns(0), endTime(0.0), status(Running),
+   failed(false), theMap(0), mapSize(0)
+#ifdef _WIN32
+  , fileHandle(0), mapHandle(0)
+#else
+  , fileDescriptor(-1)
+#endif
+{
+  if (capacity < 1)
+    capacity = 1;
+
+  if (file != 0) {
+    fileName = new char[strlen(file)+1];
+    if (fileName == 0) {
+      opserr << "LiveFeedStream::LiveFeedStream() - out of memory\n";
+      return;
+    }
+    strcpy(fileName, file);
+  }
+}
+
+
+LiveFeedStream::~LiveFeedStream()
+{
+  this->close();
+
+  if (fileName != 0)
+    delete [] fileName;
+}
+
+
+void
+LiveFeedStream::setEndTime(double time)
+{
+  endTime = time;
+  if (theMap != 0)
+    ((LiveFeedHeader *)theMap)->endTime = time;
+}
+
+
+void
+LiveFeedStream::setStatus(int newStatus)
+{
+  status = newStatus;
+  if (theMap != 0) {
+    std::atomic_thread_fence(std::memory_order_release);
+    ((LiveFeedHeader *)theMap)->status = newStatus;
+  }
+}
+
+
+bool
+LiveFeedStream::abortRequested(void)
+{
+  if (theMap == 0)
+    return false;
+
+  return ((LiveFeedHeader *)theMap)->abortRequested != 0;
+}
+
+
+int
+LiveFeedStream::write(Vector &data)
+{
+  if (failed == true)
+    return 0;
+
+  if (theMap == 0 && this->open(data.Size()) < 0) {
+    failed = true;
+    return -1;
+  }
+
+  if (data.Size() != numColumns)
+    return 0;
+
+  LiveFeedHeader *header = (LiveFeedHeader *)theMap;
+  long long n = header->numRows;
+  double *row = (double *)(theMap + sizeof(LiveFeedHeader)) + (n % capacity) * numColumns;
+  for (int i=0; i<numColumns; i++)
+    row[i] = data(i);
+
+  // the row has to be in place before a reader can see the new count
+  std::atomic_thread_fence(std::memory_order_release);
+  header->numRows = n + 1;
+
+  return 0;
+}
+
+
+int
+LiveFeedStream::open(int numCols)
+{
+  if (fileName == 0 || numCols <= 0)
+    return -1;
+
+  numColumns = numCols;
+  mapSize = sizeof(LiveFeedHeader) + (size_t)capacity * numColumns * sizeof(double);
+
+#ifdef _WIN32
+  fileHandle = CreateFileA(fileName, GENERIC_READ | GENERIC_WRITE,
+			   FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			   NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (fileHandle == INVALID_HANDLE_VALUE) {
+    fileHandle = 0;
+    opserr << "LiveFeedStream::open() - could not create file " << fileName << endln;
+    return -1;
+  }
+  unsigned long long size = mapSize;
+  mapHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READWRITE,
+				 (DWORD)(size >> 32), (DWORD)(size & 0xFFFFFFFF), NULL);
+  if (mapHandle != 0)
+    theMap = (char *)MapViewOfFile(mapHandle, FILE_MAP_WRITE, 0, 0, mapSize);
+#else
+  fileDescriptor = ::open(fileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fileDescriptor < 0) {
+    opserr << "LiveFeedStream::open() - could not create file " << fileName << endln;
+    return -1;
+  }
+  if (ftruncate(fileDescriptor, (off_t)mapSize) == 0) {
+    void *theAddress = mmap(0, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    if (theAddress != MAP_FAILED)
+      theMap = (char *)theAddress;
+  }
+#endif
+
+  if (theMap == 0) {
+    opserr << "LiveFeedStream::open() - could not map file " << fileName << endln;
+    this->close();
+    return -1;
+  }
+
+  // the magic goes in last so a reader never sees a half set up header
+  LiveFeedHeader *header = (LiveFeedHeader *)theMap;
+  header->numColumns = numColumns;
+  header->capacity = capacity;
+  header->status = status;
+  header->abortRequested = 0;
+  header->endTime = endTime;
+  header->numRows = 0;
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(header->magic, liveFeedMagic, sizeof(liveFeedMagic));
+
+  return 0;
+}
+
+
+int
+LiveFeedStream::close(void)
+{
+#ifdef _WIN32
+  if (theMap != 0)
+    UnmapViewOfFile(theMap);
+  if (mapHandle != 0)
+    CloseHandle(mapHandle);
+  if (fileHandle != 0)
+    CloseHandle(fileHandle);
+  mapHandle = 0;
+  fileHandle = 0;
+#else
+  if (theMap != 0)
+    munmap(theMap, mapSize);
+  if (fileDescriptor >= 0)
+    ::close(fileDescriptor);
+  fileDescriptor = -1;
+#endif
+  theMap = 0;
+  failed = true;
+
+  return 0;
+}
@@ -0,0 +1,117 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef _LiveFeedStream
+#define _LiveFeedStream
+
+// Description: This file contains the class definition for LiveFeedStream.
+// A LiveFeedStream is an OPS_Stream that publishes the rows a recorder sends
+// it to other processes while the analysis runs. The rows go into a ring
+// buffer in a memory mapped file, which another process can map and poll.
+// The file holds, in native byte order:
+//
+//   offset  0  char[8]  "SRTFEED1"
+//   offset  8  int      number of columns in a row, the time included
+//   offset 12  int      number of rows the ring holds
+//   offset 16  int      status: 0 running, 1 finished, 2 failed, 3 aborted
+//   offset 20  int      set to nonzero by a reader to ask for an abort
+//   offset 24  double   time at which the analysis will end
+//   offset 32  long long number of rows written so far
+//   offset 40  the rows; row n is at index n modulo the number of rows
+//
+// The row count is stored after the row, so a reader that sees count n can
+// read rows up to n-1; a reader that falls more than a ring behind has lost
+// the oldest of those rows. The file is created on the first row.
+
+#include <OPS_Stream.h>
+#include <stddef.h>
+
+class Vector;
+
+class LiveFeedStream : public OPS_Stream
+{
+ public:
+  LiveFeedStream(const char *fileName, int capacity = 4096);
+  ~LiveFeedStream();
+
+  enum {Running = 0, Finished = 1, Failed = 2, Aborted = 3};
+
+  // the reader uses the end time for the progress of the analysis
+  void setEndTime(double endTime);
+  void setStatus(int status);
+  bool abortRequested(void);
+
+  int close(void);
+
+  // xml stuff
+  int tag(const char *) {return 0;};
+  int tag(const char *, const char *) {return 0;};
+  int endTag() {return 0;};
+  int attr(const char *name, int value) {return 0;};
+  int attr(const char *name, double value) {return 0;};
+  int attr(const char *name, const char *value) {return 0;};
+  int write(Vector &data);
+
+  OPS_Stream& write(const char *s, int n) {return *this;};
+  OPS_Stream& write(const unsigned char *s, int n) {return *this;};
+  OPS_Stream& write(const signed char *s, int n) {return *this;};
+  OPS_Stream& write(const void *s, int n) {return *this;};
+  OPS_Stream& operator<<(char c) {return *this;};
+  OPS_Stream& operator<<(unsigned char c) {return *this;};
+  OPS_Stream& operator<<(signed char c) {return *this;};
+  OPS_Stream& operator<<(const char *s) {return *this;};
+  OPS_Stream& operator<<(const unsigned char *s) {return *this;};
+  OPS_Stream& operator<<(const signed char *s) {return *this;};
+  OPS_Stream& operator<<(const void *p) {return *this;};
+  OPS_Stream& operator<<(int n) {return *this;};
+  OPS_Stream& operator<<(unsigned int n) {return *this;};
+  OPS_Stream& operator<<(long n) {return *this;};
+  OPS_Stream& operator<<(unsigned long n) {return *this;};
+  OPS_Stream& operator<<(short n) {return *this;};
+  OPS_Stream& operator<<(unsigned short n) {return *this;};
+  OPS_Stream& operator<<(bool b) {return *this;};
+  OPS_Stream& operator<<(double n) {return *this;};
+  OPS_Stream& operator<<(float n) {return *this;};
+
+  int sendSelf(int commitTag, Channel &theChannel) {return 0;};
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker) {return 0;};
+
+ private:
+  int open(int numColumns);
+
+  char *fileName;
+  int capacity;
+  int numColumns;
+  double endTime;
+  int status;
+  bool failed;                  // not mapped or closed, rows are dropped
+
+  char *theMap;
+  size_t mapSize;
+#ifdef _WIN32
+  void *fileHandle;
+  void *mapHandle;
+#else
+  int fileDescriptor;
+#endif
+};
+
+#endif
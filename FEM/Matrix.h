@@ -143,6 +143,7 @@ class Matrix
     friend class MPI_Channel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class SnapshotChannel;
 
   protected:
 
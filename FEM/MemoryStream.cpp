@@ -0,0 +1,72 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for MemoryStream.
+
+#include <MemoryStream.h>
+#include <OPS_Globals.h>
+#include <classTags.h>
+#include <Vector.h>
+
+MemoryStream::MemoryStream()
+  :OPS_Stream(OPS_STREAM_TAGS_MemoryStream),
+   numRows(0), numColumns(0)
+{
+
+}
+
+
+MemoryStream::~MemoryStream()
+{
+
+}
+
+
+int
+MemoryStream::write(Vector &data)
+{
+  int n = data.Size();
+  if (n == 0)
+    return 0;
+
+  this->write(&data(0), n);
+  return 0;
+}
+
+
+OPS_Stream&
+MemoryStream::write(const double *s, int n)
+{
+  if (n == 0)
+    return *this;
+
+  // a row of another size does not go with the ones before it
+  if (numRows == 0)
+    numColumns = n;
+  else if (n != numColumns) {
+    opserr << "MemoryStream::write() - a row of " << n << " values, the rows have " << numColumns << endln;
+    return *this;
+  }
+
+  theData.insert(theData.end(), s, s+n);
+  numRows++;
+
+  return *this;
+}
@@ -286,6 +286,21 @@ int Newmark::formEleTangent(FE_Element *theEle)
 }    
 
 
+int Newmark::formEleResidualAndTangent(FE_Element *theEle)
+{
+    if (determiningMass == true || sensitivityFlag != 0 || 
+	statusFlag != CURRENT_TANGENT)
+        return this->TransientIntegrator::formEleResidualAndTangent(theEle);
+
+    // residual and c1*K + c2*C + c3*M from a single element evaluation
+    theEle->zeroResidual();
+    theEle->zeroTangent();
+    theEle->addRIncInertiaToResidualAndTang(1.0, c1, c2, c3);
+
+    return 0;
+}
+
+
 int Newmark::formNodTangent(DOF_Group *theDof)
 {
     if (determiningMass == true)
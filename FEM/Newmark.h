@@ -59,6 +59,7 @@ public:
     int formNodTangent(DOF_Group *theDof);
     int formEleResidual(FE_Element* theEle);
     int formNodUnbalance(DOF_Group* theDof);
+    int formEleResidualAndTangent(FE_Element *theEle);
     
     int domainChanged(void);    
     int newStep(double deltaT);    
@@ -112,7 +112,22 @@ NewtonRaphson::solveCurrentStep(void)
 	return -5;
     }	
 
-    if (theIntegrator->formUnbalance() < 0) {
+    // when the current tangent is used the integrator is asked to form it
+    // together with the unbalance, saving a second pass over the elements;
+    // formUnbalanceAndTangent() returns 1 if it only formed the unbalance
+    bool formBoth = (tangent == CURRENT_TANGENT) && 
+      (theIntegrator->activateSensitivity() == false);
+    bool tangentFormed = false;
+
+    if (formBoth == true) {
+      int res = theIntegrator->formUnbalanceAndTangent(CURRENT_TANGENT);
+      if (res < 0) {
+	opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
+	opserr << "the Integrator failed in formUnbalanceAndTangent()\n";	
+	return -2;
+      }
+      tangentFormed = (res == 0);
+    } else if (theIntegrator->formUnbalance() < 0) {
       opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
       opserr << "the Integrator failed in formUnbalance()\n";	
       return -2;
@@ -150,7 +165,7 @@ NewtonRaphson::solveCurrentStep(void)
       }	else {
 	
 	  SOLUTION_ALGORITHM_tangentFlag = tangent;
-	if (theIntegrator->formTangent(tangent) < 0){
+	if (tangentFormed == false && theIntegrator->formTangent(tangent) < 0){
 	    opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
 	    opserr << "the Integrator failed in formTangent()\n";
 	    return -1;
@@ -167,17 +182,33 @@ NewtonRaphson::solveCurrentStep(void)
 	opserr << "the Integrator failed in update()\n";	
 	return -4;
       }	        
-      if (theIntegrator->formUnbalance() < 0) {
+
+      // the tangent is formed together with the unbalance only if another
+      // iteration follows, which is known before the unbalance is formed
+      // when the test does not look at it; otherwise it is formed at the
+      // start of the next iteration
+      tangentFormed = false;
+      bool tested = false;
+      if (formBoth == true && theTest->usesUnbalance() == false) {
+	result = theTest->test();
+	tested = true;
+      }
+      if (tested == true && result == -1) {
+	int res = theIntegrator->formUnbalanceAndTangent(CURRENT_TANGENT);
+	if (res < 0) {
+	  opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
+	  opserr << "the Integrator failed in formUnbalanceAndTangent()\n";	
+	  return -2;
+	}
+	tangentFormed = (res == 0);
+      } else if (theIntegrator->formUnbalance() < 0) {
 	opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
 	opserr << "the Integrator failed in formUnbalance()\n";	
 	return -2;
       }	
 
-     
-     
-
-
-      result = theTest->test();
+      if (tested == false)
+	result = theTest->test();
        numIterations++;
       this->record(numIterations);
 
@@ -0,0 +1,253 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for NodalKinematicState.
+
+#include <NodalKinematicState.h>
+#include <Node.h>
+#include <Vector.h>
+#include <ID.h>
+#include <classTags.h>
+#include <OPS_Globals.h>
+
+int NodalKinematicState::numStamps = 0;
+
+NodalKinematicState::NodalKinematicState(Node **nodes, int num)
+:theNodes(0), numNodes(0), theOffsets(0), numDOF(0), allNodes(true),
+ disp(0), vel(0), accel(0), stamp(++numStamps)
+{
+  if (num <= 0)
+    return;
+
+  theNodes = new Node *[num];
+  theOffsets = new int[num];
+  if (theNodes == 0 || theOffsets == 0) {
+    opserr << "NodalKinematicState::NodalKinematicState() - out of memory\n";
+    allNodes = false;
+    return;
+  }
+
+  // only plain Node objects know how to view into the arrays
+  numNodes = num;
+  for (int i=0; i<num; i++) {
+    theNodes[i] = nodes[i];
+    if (nodes[i]->getClassTag() == NOD_TAG_Node) {
+      theOffsets[i] = numDOF;
+      numDOF += nodes[i]->getNumberDOF();
+    } else {
+      theOffsets[i] = -1;
+      allNodes = false;
+    }
+  }
+
+  if (numDOF == 0)
+    return;
+
+  disp = new double[4*numDOF];
+  vel = new double[2*numDOF];
+  accel = new double[2*numDOF];
+  if (disp == 0 || vel == 0 || accel == 0) {
+    opserr << "NodalKinematicState::NodalKinematicState() - out of memory\n";
+    for (int i=0; i<num; i++)
+      theOffsets[i] = -1;
+    allNodes = false;
+    return;
+  }
+
+  // the nodes copy their current state across
+  for (int i=0; i<numNodes; i++) {
+    int offset = theOffsets[i];
+    if (offset >= 0 &&
+	theNodes[i]->setStateStorage(&disp[offset], &vel[offset], &accel[offset], numDOF) < 0) {
+      theOffsets[i] = -1;
+      allNodes = false;
+    }
+  }
+}
+
+
+NodalKinematicState::~NodalKinematicState()
+{
+  // move the state back into the nodes before the arrays go
+  for (int i=0; i<numNodes; i++)
+    if (theOffsets[i] >= 0)
+      theNodes[i]->setStateStorage(0, 0, 0, 0);
+
+  if (theNodes != 0)
+    delete [] theNodes;
+  if (theOffsets != 0)
+    delete [] theOffsets;
+  if (disp != 0)
+    delete [] disp;
+  if (vel != 0)
+    delete [] vel;
+  if (accel != 0)
+    delete [] accel;
+}
+
+
+int
+NodalKinematicState::getStamp(void) const
+{
+  return stamp;
+}
+
+
+int
+NodalKinematicState::getNumDOF(void) const
+{
+  return numDOF;
+}
+
+
+int
+NodalKinematicState::getOffset(int nodeIndex) const
+{
+  if (nodeIndex < 0 || nodeIndex >= numNodes)
+    return -1;
+  return theOffsets[nodeIndex];
+}
+
+
+bool
+NodalKinematicState::hasAllNodes(void) const
+{
+  return allNodes;
+}
+
+
+int
+NodalKinematicState::commit(void)
+{
+  double *trialDisp = disp;
+  double *commitDisp = disp+numDOF;
+  double *incrDisp = disp+2*numDOF;
+  double *incrDeltaDisp = disp+3*numDOF;
+  double *trialVel = vel;
+  double *commitVel = vel+numDOF;
+  double *trialAccel = accel;
+  double *commitAccel = accel+numDOF;
+
+  for (int i=0; i<numDOF; i++) {
+    commitDisp[i] = trialDisp[i];
+    incrDisp[i] = 0.0;
+    incrDeltaDisp[i] = 0.0;
+    commitVel[i] = trialVel[i];
+    commitAccel[i] = trialAccel[i];
+  }
+
+  return 0;
+}
+
+
+int
+NodalKinematicState::revertToLastCommit(void)
+{
+  double *trialDisp = disp;
+  double *commitDisp = disp+numDOF;
+  double *incrDisp = disp+2*numDOF;
+  double *incrDeltaDisp = disp+3*numDOF;
+  double *trialVel = vel;
+  double *commitVel = vel+numDOF;
+  double *trialAccel = accel;
+  double *commitAccel = accel+numDOF;
+
+  for (int i=0; i<numDOF; i++) {
+    trialDisp[i] = commitDisp[i];
+    incrDisp[i] = 0.0;
+    incrDeltaDisp[i] = 0.0;
+    trialVel[i] = commitVel[i];
+    trialAccel[i] = commitAccel[i];
+  }
+
+  return 0;
+}
+
+
+// setTrialResponse():
+// does for all the nodes what DOF_Group::setNodeDisp(), setNodeVel() and
+// setNodeAccel() do node by node; if theEqns is of size 0 state dof i is
+// equation i and the loops are straight copies.
+
+int
+NodalKinematicState::setTrialResponse(const Vector *u, const Vector *udot, const Vector *udotdot,
+				      const ID &theEqns)
+{
+  double *trialDisp = disp;
+  double *commitDisp = disp+numDOF;
+  double *incrDisp = disp+2*numDOF;
+  double *incrDeltaDisp = disp+3*numDOF;
+
+  if (theEqns.Size() == 0) {
+    if (u != 0) {
+      const Vector &U = *u;
+      for (int i=0; i<numDOF; i++) {
+	double tDisp = U(i);
+	incrDisp[i] = tDisp - commitDisp[i];
+	incrDeltaDisp[i] = tDisp - trialDisp[i];
+	trialDisp[i] = tDisp;
+      }
+    }
+    if (udot != 0) {
+      const Vector &V = *udot;
+      for (int i=0; i<numDOF; i++)
+	vel[i] = V(i);
+    }
+    if (udotdot != 0) {
+      const Vector &A = *udotdot;
+      for (int i=0; i<numDOF; i++)
+	accel[i] = A(i);
+    }
+    return 0;
+  }
+
+  if (theEqns.Size() != numDOF) {
+    opserr << "NodalKinematicState::setTrialResponse() - equation map of wrong size\n";
+    return -1;
+  }
+
+  if (u != 0) {
+    for (int i=0; i<numDOF; i++) {
+      int loc = theEqns(i);
+      if (loc < -1)
+	continue;
+      double tDisp = (loc >= 0) ? (*u)(loc) : trialDisp[i];
+      incrDisp[i] = tDisp - commitDisp[i];
+      incrDeltaDisp[i] = tDisp - trialDisp[i];
+      trialDisp[i] = tDisp;
+    }
+  }
+  if (udot != 0) {
+    for (int i=0; i<numDOF; i++) {
+      int loc = theEqns(i);
+      if (loc >= 0)
+	vel[i] = (*udot)(loc);
+    }
+  }
+  if (udotdot != 0) {
+    for (int i=0; i<numDOF; i++) {
+      int loc = theEqns(i);
+      if (loc >= 0)
+	accel[i] = (*udotdot)(loc);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef NodalKinematicState_h
+#define NodalKinematicState_h
+
+// Description: This file contains the class definition for NodalKinematicState.
+// A NodalKinematicState holds the trial, committed and incremental response
+// of all the nodes of a Domain in structure-of-arrays form: one contiguous
+// array per quantity, the dof of the nodes laid out one after the other in
+// the order of the Domain's flat node array, i.e. in equation order once the
+// model has been numbered. The nodes are told to view into these arrays, so
+// that commit, revert and setting the trial response from the solution
+// vectors become plain loops over the arrays instead of calls on every node.
+
+class Node;
+class Vector;
+class ID;
+
+class NodalKinematicState
+{
+  public:
+    NodalKinematicState(Node **theNodes, int numNodes);
+    ~NodalKinematicState();
+
+    int getStamp(void) const;
+    int getNumDOF(void) const;
+    int getOffset(int nodeIndex) const;
+    bool hasAllNodes(void) const;
+
+    // contiguous arrays, each of size getNumDOF()
+    double *getTrialDisp(void)     {return disp;}
+    double *getCommitDisp(void)    {return disp+numDOF;}
+    double *getIncrDisp(void)      {return disp+2*numDOF;}
+    double *getIncrDeltaDisp(void) {return disp+3*numDOF;}
+    double *getTrialVel(void)      {return vel;}
+    double *getCommitVel(void)     {return vel+numDOF;}
+    double *getTrialAccel(void)    {return accel;}
+    double *getCommitAccel(void)   {return accel+numDOF;}
+
+    // the vectorised versions of Node::commitState() & revertToLastCommit()
+    int commit(void);
+    int revertToLastCommit(void);
+
+    // set the trial response from the vectors of the analysis; theEqns(i) is
+    // the equation of state dof i, -1 if constrained, -2 if not to be touched
+    int setTrialResponse(const Vector *u, const Vector *udot, const Vector *udotdot,
+			 const ID &theEqns);
+
+  private:
+    Node **theNodes;
+    int numNodes;
+    int *theOffsets;
+    int numDOF;
+    bool allNodes;                // false if some node could not be attached
+
+    double *disp;                 // trial, committed, incr and incrDelta disp
+    double *vel;                  // trial and committed vel
+    double *accel;                // trial and committed accel
+
+    int stamp;
+    static int numStamps;
+};
+
+#endif
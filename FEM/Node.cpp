@@ -187,7 +187,7 @@ Node::Node(int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0), 
  incrDeltaDisp(0),
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), externalState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
  index(-1), reaction(0), displayLocation(0)
 {
@@ -208,7 +208,7 @@ Node::Node(int tag, int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), externalState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
   R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
  index(-1), reaction(0), displayLocation(0)
 {
@@ -229,7 +229,7 @@ Node::Node(int tag, int ndof, double Crd1, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), externalState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
  index(-1), reaction(0), displayLocation(0)
 {
@@ -286,7 +286,7 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), externalState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0), displayLocation(0)
 {
@@ -345,7 +345,7 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), externalState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0), displayLocation(0)
 {
@@ -405,7 +405,7 @@ Node::Node(const Node &otherNode, bool copyMass)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), externalState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
    reaction(0), displayLocation(0)
 {
@@ -431,8 +431,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for displacement\n";
       exit(-1);
     }
-    for (int i=0; i<4*numberDOF; i++)
-      disp[i] = otherNode.disp[i];
+    for (int k=0; k<4; k++)
+      for (int i=0; i<numberDOF; i++)
+	disp[i+k*stateStride] = otherNode.disp[i+k*otherNode.stateStride];
   }    
   
   if (otherNode.commitVel != 0) {
@@ -440,8 +441,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for velocity\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      vel[i] = otherNode.vel[i];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numberDOF; i++)
+	vel[i+k*stateStride] = otherNode.vel[i+k*otherNode.stateStride];
   }    
   
   if (otherNode.commitAccel != 0) {
@@ -449,8 +451,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for acceleration\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      accel[i] = otherNode.accel[i];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numberDOF; i++)
+	accel[i+k*stateStride] = otherNode.accel[i+k*otherNode.stateStride];
   }    
   
   
@@ -546,14 +549,17 @@ Node::~Node()
     if (unbalLoad != 0)
 	delete unbalLoad;
     
-    if (disp != 0)
+    // the state arrays are not ours if they live in the domain's nodal state
+    if (externalState == false) {
+      if (disp != 0)
 	delete [] disp;
 
-    if (vel != 0)
+      if (vel != 0)
 	delete [] vel;
 
-    if (accel != 0)
+      if (accel != 0)
 	delete [] accel;
+    }
 
     if (mass != 0)
 	delete mass;
@@ -772,8 +778,8 @@ Node::setTrialDisp(double value, int dof)
     // perform the assignment .. we dont't go through Vector interface
     // as we are sure of size and this way is quicker
     double tDisp = value;
-    disp[dof+2*numberDOF] = tDisp - disp[dof+numberDOF];
-    disp[dof+3*numberDOF] = tDisp - disp[dof];	
+    disp[dof+2*stateStride] = tDisp - disp[dof+stateStride];
+    disp[dof+3*stateStride] = tDisp - disp[dof];	
     disp[dof] = tDisp;
 
     return 0;
@@ -803,8 +809,8 @@ Node::setTrialDisp(const Vector &newTrialDisp)
     // as we are sure of size and this way is quicker
     for (int i=0; i<numberDOF; i++) {
         double tDisp = newTrialDisp(i);
-	disp[i+2*numberDOF] = tDisp - disp[i+numberDOF];
-	disp[i+3*numberDOF] = tDisp - disp[i];	
+	disp[i+2*stateStride] = tDisp - disp[i+stateStride];
+	disp[i+3*stateStride] = tDisp - disp[i];	
 	disp[i] = tDisp;
     }
 
@@ -879,8 +885,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
 	for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] = incrDispI;
-	  disp[i+2*numberDOF] = incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] = incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
 	}
 	return 0;
     }
@@ -889,8 +895,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
     for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] += incrDispI;
-	  disp[i+2*numberDOF] += incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] += incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
     }
 
     return 0;
@@ -1124,22 +1130,22 @@ Node::commitState()
     // check disp exists, if does set commit = trial, incr = 0.0
     if (trialDisp != 0) {
       for (int i=0; i<numberDOF; i++) {
-	disp[i+numberDOF] = disp[i];  
-        disp[i+2*numberDOF] = 0.0;
-        disp[i+3*numberDOF] = 0.0;
+	disp[i+stateStride] = disp[i];  
+        disp[i+2*stateStride] = 0.0;
+        disp[i+3*stateStride] = 0.0;
       }
     }		    
     
     // check vel exists, if does set commit = trial    
     if (trialVel != 0) {
       for (int i=0; i<numberDOF; i++)
-	vel[i+numberDOF] = vel[i];
+	vel[i+stateStride] = vel[i];
     }
     
     // check accel exists, if does set commit = trial        
     if (trialAccel != 0) {
       for (int i=0; i<numberDOF; i++)
-	accel[i+numberDOF] = accel[i];
+	accel[i+stateStride] = accel[i];
     }
 
     // if we get here we are done
@@ -1154,22 +1160,22 @@ Node::revertToLastCommit()
     // check disp exists, if does set trial = last commit, incr = 0
     if (disp != 0) {
       for (int i=0 ; i<numberDOF; i++) {
-	disp[i] = disp[i+numberDOF];
-	disp[i+2*numberDOF] = 0.0;
-	disp[i+3*numberDOF] = 0.0;
+	disp[i] = disp[i+stateStride];
+	disp[i+2*stateStride] = 0.0;
+	disp[i+3*stateStride] = 0.0;
       }
     }
     
     // check vel exists, if does set trial = last commit
     if (vel != 0) {
       for (int i=0 ; i<numberDOF; i++)
-	vel[i] = vel[numberDOF+i];
+	vel[i] = vel[stateStride+i];
     }
 
     // check accel exists, if does set trial = last commit
     if (accel != 0) {    
       for (int i=0 ; i<numberDOF; i++)
-	accel[i] = accel[numberDOF+i];
+	accel[i] = accel[stateStride+i];
     }
 
     // if we get here we are done
@@ -1182,20 +1188,28 @@ Node::revertToStart()
 {
     // check disp exists, if does set all to zero
     if (disp != 0) {
-      for (int i=0 ; i<4*numberDOF; i++)
+      for (int i=0 ; i<numberDOF; i++) {
 	disp[i] = 0.0;
+	disp[i+stateStride] = 0.0;
+	disp[i+2*stateStride] = 0.0;
+	disp[i+3*stateStride] = 0.0;
+      }
     }
 
     // check vel exists, if does set all to zero
     if (vel != 0) {
-      for (int i=0 ; i<2*numberDOF; i++)
+      for (int i=0 ; i<numberDOF; i++) {
 	vel[i] = 0.0;
+	vel[i+stateStride] = 0.0;
+      }
     }
 
     // check accel exists, if does set all to zero
     if (accel != 0) {    
-      for (int i=0 ; i<2*numberDOF; i++)
+      for (int i=0 ; i<numberDOF; i++) {
 	accel[i] = 0.0;
+	accel[i+stateStride] = 0.0;
+      }
     }
     
     if (unbalLoad != 0) 
@@ -1610,7 +1624,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantities equal to committed
       for (int i=0; i<numberDOF; i++)
-	disp[i] = disp[i+numberDOF];  // set trial equal commited
+	disp[i] = disp[i+stateStride];  // set trial equal commited
 
     } else if (commitDisp != 0) {
       // if going back to initial we will just zero the vectors
@@ -1632,7 +1646,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantity
       for (int i=0; i<numberDOF; i++)
-	vel[i] = vel[i+numberDOF];  // set trial equal commited
+	vel[i] = vel[i+stateStride];  // set trial equal commited
     }
 
     if (data(4) == 0) {
@@ -1648,7 +1662,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
       
       // set the trial values
       for (int i=0; i<numberDOF; i++)
-	accel[i] = accel[i+numberDOF];  // set trial equal commited
+	accel[i] = accel[i+stateStride];  // set trial equal commited
     }
 
     if (data(5) == 0) {
@@ -1795,6 +1809,95 @@ Node::displaySelf(Renderer &theRenderer, int displayMode, float fact, const char
 }
 
 
+// setStateStorage():
+// method to have the committed and trial response quantities of the node
+// held in storage owned by someone else, the NodalKinematicState of the
+// Domain: block k of the disp (trial, committed, incr, incrDelta) starts at
+// theDisp[k*stride], of vel and accel (trial, committed) at theVel[k*stride]
+// and theAccel[k*stride]. The current values are copied across. Invoking 
+// the method with theDisp = 0 moves the state back into arrays of the node.
+
+int
+Node::setStateStorage(double *theDisp, double *theVel, double *theAccel, int stride)
+{
+  double *oldDisp = disp;
+  double *oldVel = vel;
+  double *oldAccel = accel;
+  int oldStride = stateStride;
+  bool oldExternal = externalState;
+
+  if (theDisp == 0 || theVel == 0 || theAccel == 0) {
+    if (externalState == false)
+      return 0;
+    disp = new double[4*numberDOF];
+    vel = new double[2*numberDOF];
+    accel = new double[2*numberDOF];
+    if (disp == 0 || vel == 0 || accel == 0) {
+      opserr << "WARNING - Node::setStateStorage() ran out of memory\n";
+      return -1;
+    }
+    stateStride = numberDOF;
+    externalState = false;
+  } else {
+    disp = theDisp;
+    vel = theVel;
+    accel = theAccel;
+    stateStride = stride;
+    externalState = true;
+  }
+
+  // copy the current values, zero if the node never had any
+  for (int i=0; i<numberDOF; i++) {
+    for (int k=0; k<4; k++)
+      disp[i+k*stateStride] = (oldDisp != 0) ? oldDisp[i+k*oldStride] : 0.0;
+    for (int k=0; k<2; k++) {
+      vel[i+k*stateStride] = (oldVel != 0) ? oldVel[i+k*oldStride] : 0.0;
+      accel[i+k*stateStride] = (oldAccel != 0) ? oldAccel[i+k*oldStride] : 0.0;
+    }
+  }
+
+  if (oldExternal == false) {
+    if (oldDisp != 0)
+      delete [] oldDisp;
+    if (oldVel != 0)
+      delete [] oldVel;
+    if (oldAccel != 0)
+      delete [] oldAccel;
+  }
+
+  // point the Vector objects at the new storage
+  if (trialDisp == 0) {
+    trialDisp = new Vector(disp, numberDOF);
+    commitDisp = new Vector(&disp[stateStride], numberDOF);
+    incrDisp = new Vector(&disp[2*stateStride], numberDOF);
+    incrDeltaDisp = new Vector(&disp[3*stateStride], numberDOF);
+  } else {
+    trialDisp->setData(disp, numberDOF);
+    commitDisp->setData(&disp[stateStride], numberDOF);
+    incrDisp->setData(&disp[2*stateStride], numberDOF);
+    incrDeltaDisp->setData(&disp[3*stateStride], numberDOF);
+  }
+
+  if (trialVel == 0) {
+    trialVel = new Vector(vel, numberDOF);
+    commitVel = new Vector(&vel[stateStride], numberDOF);
+  } else {
+    trialVel->setData(vel, numberDOF);
+    commitVel->setData(&vel[stateStride], numberDOF);
+  }
+
+  if (trialAccel == 0) {
+    trialAccel = new Vector(accel, numberDOF);
+    commitAccel = new Vector(&accel[stateStride], numberDOF);
+  } else {
+    trialAccel->setData(accel, numberDOF);
+    commitAccel->setData(&accel[stateStride], numberDOF);
+  }
+
+  return 0;
+}
+
+
 // createDisp(), createVel() and createAccel():
 // private methods to create the arrays to hold the disp, vel and acceleration
 // values and the Vector objects for the committed and trial quantaties.
@@ -1812,6 +1915,7 @@ Node::createDisp(void)
   }
   for (int i=0; i<4*numberDOF; i++)
     disp[i] = 0.0;
+  stateStride = numberDOF;
     
   commitDisp = new Vector(&disp[numberDOF], numberDOF); 
   trialDisp = new Vector(disp, numberDOF);
@@ -1839,6 +1943,7 @@ Node::createVel(void)
     }
     for (int i=0; i<2*numberDOF; i++)
       vel[i] = 0.0;
+    stateStride = numberDOF;
     
     commitVel = new Vector(&vel[numberDOF], numberDOF); 
     trialVel = new Vector(vel, numberDOF);
@@ -1863,6 +1968,7 @@ Node::createAccel(void)
     }
     for (int i=0; i<2*numberDOF; i++)
 	accel[i] = 0.0;
+    stateStride = numberDOF;
     
     commitAccel = new Vector(&accel[numberDOF], numberDOF);
     trialAccel = new Vector(accel, numberDOF);
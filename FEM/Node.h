@@ -107,6 +107,9 @@ class Node : public DomainComponent
     virtual int revertToLastCommit();    
     virtual int revertToStart();        
 
+    // public method to view the response into the domain's nodal state arrays
+    virtual int setStateStorage(double *theDisp, double *theVel, double *theAccel, int stride);
+
     // public methods for dynamic analysis
     virtual const Matrix &getMass(void);
     virtual int setMass(const Matrix &theMass);
@@ -179,6 +182,8 @@ class Node : public DomainComponent
     
     double *disp, *vel, *accel; // double arrays holding the displ, 
                                 // vel and accel values
+    int stateStride;            // offset between the blocks in the arrays
+    bool externalState;         // true if arrays are owned by the domain
 
     int dbTag1, dbTag2, dbTag3, dbTag4; // needed for database
     Matrix *R;                          // nodal participation matrix
@@ -289,6 +289,7 @@ OPS_NodeRecorder()
 NodeRecorder::NodeRecorder()
 :Recorder(RECORDER_TAGS_NodeRecorder),
  theDofs(0), theNodalTags(0), theNodes(0), response(0), 
+ theNodalResponses(0), theResponseDofs(0), 
  theDomain(0), theOutputHandler(0),
  echoTimeFlag(true), dataFlag(0), 
  deltaT(0), nextTimeStampToRecord(0.0), 
@@ -310,6 +311,7 @@ NodeRecorder::NodeRecorder(const ID &dofs,
 			   TimeSeries **theSeries)
 :Recorder(RECORDER_TAGS_NodeRecorder),
  theDofs(0), theNodalTags(0), theNodes(0), response(0), 
+ theNodalResponses(0), theResponseDofs(0), 
  theDomain(&theDom), theOutputHandler(&theOutputHandler),
  echoTimeFlag(timeFlag), dataFlag(0), 
  deltaT(dT), nextTimeStampToRecord(0.0), 
@@ -453,6 +455,9 @@ NodeRecorder::~NodeRecorder()
   if (theNodes != 0)
     delete [] theNodes;
 
+  if (theNodalResponses != 0)
+    delete [] theNodalResponses;
+
   if (theTimeSeries != 0) {
     for (int i=0; i<numDOF; i++)
       delete theTimeSeries[i];
@@ -525,7 +530,31 @@ NodeRecorder::record(int commitTag, double timeStamp)
     // now we go get the responses from the nodes & place them in disp vector
     //
 
-    if (dataFlag != 10) {
+    if (theNodalResponses != 0) {
+
+      // the response vectors were bound in initialize()
+      int cnt = timeOffset;
+      int loc = 0;
+      for (int i=0; i<numValidNodes; i++) {
+	const Vector &theResponse = *theNodalResponses[i];
+	for (int j=0; j<numDOF; j++) {
+	  if (theTimeSeries != 0) {
+	    timeSeriesTerm = timeSeriesValues[j];
+	  }
+
+	  int dof = theResponseDofs(loc++);
+	  if (dof >= 0)
+	    response(cnt) = theResponse(dof) + timeSeriesTerm;
+	  else
+	    response(cnt) = 0.0 + timeSeriesTerm;
+	  cnt++;
+	}
+      }
+
+      // insert the data into the database
+      theOutputHandler->write(response);
+
+    } else if (dataFlag != 10) {
 
       for (int i=0; i<numValidNodes; i++) {
 
@@ -1023,10 +1052,41 @@ NodeRecorder::recvSelf(int commitTag, Channel &theChannel,
   return 0;
 }
 
+int
+NodeRecorder::sendState(int commitTag, Channel &theChannel)
+{
+  static Vector data(1);
+  data(0) = nextTimeStampToRecord;
+
+  if (theChannel.sendVector(0, commitTag, data) < 0) {
+    opserr << "NodeRecorder::sendState() - failed to send the time of the next record\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+NodeRecorder::recvState(int commitTag, Channel &theChannel)
+{
+  static Vector data(1);
+
+  if (theChannel.recvVector(0, commitTag, data) < 0) {
+    opserr << "NodeRecorder::recvState() - failed to receive the time of the next record\n";
+    return -1;
+  }
+  nextTimeStampToRecord = data(0);
+
+  return 0;
+}
+
 
 int
 NodeRecorder::domainChanged(void)
 {
+  // the nodes may have gone, bind them again on the next record()
+  initializationDone = false;
   return 0;
 }
 
@@ -1084,6 +1144,46 @@ NodeRecorder::initialize(void)
     }
   }
 
+  //
+  // bind the response vectors of the nodes for disp, vel & accel
+  //
+
+  if (theNodalResponses != 0) {
+    delete [] theNodalResponses;
+    theNodalResponses = 0;
+  }
+
+  if (numValidNodes > 0 && ((dataFlag == 0 && sensitivity == 0) || dataFlag == 1 || dataFlag == 2)) {
+    int numDOF = theDofs->Size();
+    theNodalResponses = new const Vector *[numValidNodes];
+    if (theNodalResponses == 0) {
+      opserr << "NodeRecorder::initialize() - out of memory\n";
+      return -1;
+    }
+    theResponseDofs.resize(numValidNodes*numDOF);
+
+    int loc = 0;
+    for (int i=0; i<numValidNodes; i++) {
+      Node *theNode = theNodes[i];
+      const Vector *theResponse;
+      if (dataFlag == 0)
+	theResponse = &(theNode->getTrialDisp());
+      else if (dataFlag == 1)
+	theResponse = &(theNode->getTrialVel());
+      else
+	theResponse = &(theNode->getTrialAccel());
+      theNodalResponses[i] = theResponse;
+
+      for (int j=0; j<numDOF; j++) {
+	int dof = (*theDofs)(j);
+	if (theResponse->Size() > dof)
+	  theResponseDofs(loc++) = dof;
+	else
+	  theResponseDofs(loc++) = -1;
+      }
+    }
+  }
+
   //
   // resize the response vector
   //
@@ -68,6 +68,8 @@ class NodeRecorder: public Recorder
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
 		 FEM_ObjectBroker &theBroker);
+    int sendState(int commitTag, Channel &theChannel);
+    int recvState(int commitTag, Channel &theChannel);
 
   protected:
 
@@ -79,6 +81,11 @@ class NodeRecorder: public Recorder
     Node **theNodes;
     Vector response;
 
+    // disp, vel or accel vectors of theNodes bound at initialize() and the
+    // dof taken from each of them, -1 if the node has too few dof
+    const Vector **theNodalResponses;
+    ID theResponseDofs;
+
     Domain *theDomain;
     OPS_Stream *theOutputHandler;
 
@@ -49,7 +49,8 @@ using std::ios;
 PathTimeSeries::PathTimeSeries()	
   :TimeSeries(TSERIES_TAG_PathTimeSeries),
    thePath(0), time(0), currentTimeLoc(0), cFactor(0.0),
-   dbTag1(0), dbTag2(0), lastSendCommitTag(-1)
+   dbTag1(0), dbTag2(0), lastSendCommitTag(-1), lastChannel(0), useLast(false),
+   startTime(0.0), timeStep(0.0), resampledPath(0), resampleStart(0.0), resampleStep(0.0)
 {
   // does nothing
 }
@@ -62,7 +63,8 @@ PathTimeSeries::PathTimeSeries(int tag,
   :TimeSeries(tag, TSERIES_TAG_PathTimeSeries),
    thePath(0), time(0), currentTimeLoc(0), cFactor(theFactor),
    dbTag1(0), dbTag2(0), lastSendCommitTag(-1), lastChannel(0),
-   useLast(last)
+   useLast(last), startTime(0.0), timeStep(0.0),
+   resampledPath(0), resampleStart(0.0), resampleStep(0.0)
 {
   // check vectors are of same size
   if (theLoadPath.Size() != theTimePath.Size()) {
@@ -87,6 +89,42 @@ PathTimeSeries::PathTimeSeries(int tag,
       time = 0;
     }
   }
+
+  this->setUniformGrid();
+}
+
+PathTimeSeries::PathTimeSeries(int tag, 
+			       const double *theLoadPath, 
+			       const double *theTimePath, 
+			       int numPoints,
+			       double theFactor,
+			       bool last)
+  :TimeSeries(tag, TSERIES_TAG_PathTimeSeries),
+   thePath(0), time(0), currentTimeLoc(0), cFactor(theFactor),
+   dbTag1(0), dbTag2(0), lastSendCommitTag(-1), lastChannel(0),
+   useLast(last), startTime(0.0), timeStep(0.0),
+   resampledPath(0), resampleStart(0.0), resampleStep(0.0)
+{
+  if (numPoints <= 0 || theLoadPath == 0 || theTimePath == 0) {
+    opserr << "WARNING PathTimeSeries::PathTimeSeries() - no data points\n";
+  } else {
+
+    // vectors over the caller's arrays, they never write to or free them
+    thePath = new Vector((double *)theLoadPath, numPoints);
+    time = new Vector((double *)theTimePath, numPoints);
+
+    if (thePath == 0 || time == 0) {
+      opserr << "WARNING PathTimeSeries::PathTimeSeries() - out of memory\n ";
+      if (thePath != 0)
+	delete thePath;
+      if (time != 0)
+	delete time;
+      thePath = 0;
+      time = 0;
+    }
+  }
+
+  this->setUniformGrid();
 }
 
 PathTimeSeries::PathTimeSeries(int tag,
@@ -97,7 +135,8 @@ PathTimeSeries::PathTimeSeries(int tag,
   :TimeSeries(tag, TSERIES_TAG_PathTimeSeries),
    thePath(0), time(0), currentTimeLoc(0), cFactor(theFactor),
    dbTag1(0), dbTag2(0), lastSendCommitTag(-1), lastChannel(0),
-   useLast(last)
+   useLast(last), startTime(0.0), timeStep(0.0),
+   resampledPath(0), resampleStart(0.0), resampleStep(0.0)
 {
   // determine the number of data points
   int numDataPoints1 =0;
@@ -196,6 +235,8 @@ PathTimeSeries::PathTimeSeries(int tag,
       }   // read in the path data and then do the time
     }
   }
+
+  this->setUniformGrid();
 }
 
 PathTimeSeries::PathTimeSeries(int tag,
@@ -204,7 +245,8 @@ PathTimeSeries::PathTimeSeries(int tag,
 			       bool last)
   :TimeSeries(tag, TSERIES_TAG_PathTimeSeries),
    thePath(0), time(0), currentTimeLoc(0), cFactor(theFactor),
-   dbTag1(0), dbTag2(0), lastChannel(0), useLast(last)
+   dbTag1(0), dbTag2(0), lastChannel(0), useLast(last),
+   startTime(0.0), timeStep(0.0), resampledPath(0), resampleStart(0.0), resampleStep(0.0)
 {
   // determine the number of data points
   int numDataPoints = 0;
@@ -278,6 +320,8 @@ PathTimeSeries::PathTimeSeries(int tag,
       theFile1.close();
     } 
   }
+
+  this->setUniformGrid();
 }
 
 PathTimeSeries::~PathTimeSeries()
@@ -286,12 +330,17 @@ PathTimeSeries::~PathTimeSeries()
     delete thePath;
   if (time != 0)
     delete time;
+  if (resampledPath != 0)
+    delete resampledPath;
 }
 
 TimeSeries *
 PathTimeSeries::getCopy(void) 
 {
-  return new PathTimeSeries(this->getTag(), *thePath, *time, cFactor, useLast);
+  PathTimeSeries *theCopy = new PathTimeSeries(this->getTag(), *thePath, *time, cFactor, useLast);
+  if (theCopy != 0 && resampledPath != 0)
+    theCopy->setResampling(resampleStep, resampleStart);
+  return theCopy;
 }
 
 double
@@ -308,6 +357,31 @@ PathTimeSeries::getFactor(double pseudoTime)
   if (thePath == 0)
     return 0.0;
 
+  // at the times of the resampled path the factor is in the table
+  if (resampledPath != 0) {
+    double loc = (pseudoTime - resampleStart)/resampleStep;
+    int i = (int)floor(loc + 0.5);
+    if (i >= 0 && i < resampledPath->Size() && fabs(loc - i) <= 1.0e-8)
+      return cFactor*(*resampledPath)(i);
+  }
+
+  // on a uniform grid go straight to the interval, the checks against the
+  // time values take care of any roundoff in the division
+  if (timeStep > 0.0) {
+    int sizem2 = time->Size() - 2;
+    double loc = (pseudoTime - startTime)/timeStep;
+    int i = 0;
+    if (loc > sizem2)
+      i = sizem2;
+    else if (loc > 0.0)
+      i = (int)loc;
+    while (i > 0 && pseudoTime <= (*time)(i))
+      i--;
+    while (i < sizem2 && pseudoTime > (*time)(i+1))
+      i++;
+    currentTimeLoc = i;
+  }
+
   // determine indexes into the data array whose boundary holds the time
   double time1 = (*time)(currentTimeLoc);
 
@@ -361,6 +435,68 @@ PathTimeSeries::getFactor(double pseudoTime)
   return cFactor*(value1 + (value2-value1)*(pseudoTime-time1)/(time2 - time1));
 }
 
+int
+PathTimeSeries::setResampling(double dt, double tStart)
+{
+  if (resampledPath != 0)
+    delete resampledPath;
+  resampledPath = 0;
+
+  if (dt <= 0.0 || thePath == 0)
+    return 0;
+
+  int size = time->Size();
+  int num = (int)floor(((*time)(size-1) - tStart)/dt) + 1;
+  if (num < 1)
+    return 0;
+
+  Vector *theValues = new Vector(num);
+  if (theValues == 0 || theValues->Size() != num) {
+    opserr << "PathTimeSeries::setResampling() - out of memory\n";
+    if (theValues != 0)
+      delete theValues;
+    return -1;
+  }
+
+  // interpolate the path at each of the times
+  double factor = cFactor;
+  cFactor = 1.0;
+  for (int i=0; i<num; i++)
+    (*theValues)(i) = this->getFactor(tStart + i*dt);
+  cFactor = factor;
+  currentTimeLoc = 0;
+
+  resampledPath = theValues;
+  resampleStart = tStart;
+  resampleStep = dt;
+
+  return 0;
+}
+
+void
+PathTimeSeries::setUniformGrid(void)
+{
+  startTime = 0.0;
+  timeStep = 0.0;
+
+  if (time == 0 || time->Size() < 2)
+    return;
+
+  int size = time->Size();
+  double t0 = (*time)(0);
+  double dt = ((*time)(size-1) - t0)/(size-1);
+  if (dt <= 0.0)
+    return;
+
+  // close enough to a grid that the estimated interval is at most one out
+  for (int i=1; i<size; i++)
+    if (fabs((*time)(i) - (t0 + i*dt)) > 0.01*dt)
+      return;
+
+  startTime = t0;
+  timeStep = dt;
+}
+
 double
 PathTimeSeries::getDuration()
 {
@@ -513,6 +649,7 @@ PathTimeSeries::recvSelf(int commitTag, Channel &theChannel,
       opserr << "channel failed to receive tha time Vector\n";
       return result;  
     }
+    this->setUniformGrid();
   }
   return 0;    
 }
@@ -34,7 +34,8 @@
 // PathTimeSeries is a TimeSeries class which linear interpolates the
 // load factor using user specified control points provided in a vector object.
 // the points in the vector are given at time points specified in another vector.
-// object. 
+// object. If the time points are uniformly spaced the interval holding a time
+// is found directly from the time step instead of by searching.
 //
 // What: "@(#) PathTimeSeries.h, revA"
 
@@ -52,6 +53,15 @@ class PathTimeSeries : public TimeSeries
 		 double cfactor = 1.0,
          bool useLast = false);
   
+  // the series views thePath and theTime instead of copying them, the
+  // arrays must outlive it
+  PathTimeSeries(int tag,
+		 const double *thePath,
+		 const double *theTime,
+		 int numPoints,
+		 double cfactor = 1.0,
+         bool useLast = false);
+  
   PathTimeSeries(int tag,
 		 const char *fileNamePath, 
 		 const char *fileNameTime, 
@@ -76,6 +86,14 @@ class PathTimeSeries : public TimeSeries
     double getPeakFactor ();
     double getTimeIncr (double pseudoTime);
 
+    // the data points and their times, as given to the series
+    const Vector *getPath(void) const {return thePath;};
+    const Vector *getTime(void) const {return time;};
+
+    // tabulate the factor at tStart, tStart+dt, ... so that it is read
+    // straight from the table at those times; dt <= 0 removes the table
+    int setResampling(double dt, double tStart = 0.0);
+
     // methods for output
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -86,6 +104,8 @@ class PathTimeSeries : public TimeSeries
   protected:
     
   private:
+    void setUniformGrid(void);
+
     Vector *thePath;      // vector containg the data points
     Vector *time;		  // vector containg the time values of data points
     int currentTimeLoc;   // current location in time
@@ -94,6 +114,13 @@ class PathTimeSeries : public TimeSeries
     int lastSendCommitTag;
     Channel *lastChannel;
     bool useLast;
+
+    double startTime;     // first time and time step if the time values are
+    double timeStep;      // uniformly spaced, timeStep is 0 if they are not
+
+    Vector *resampledPath;  // path values at resampleStart + i*resampleStep
+    double resampleStart;
+    double resampleStep;
 };
 
 #endif
@@ -0,0 +1,224 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for ProfileStream.
+
+#include <ProfileStream.h>
+#include <OPS_Globals.h>
+#include <classTags.h>
+#include <Channel.h>
+#include <ID.h>
+#include <string.h>
+#include <math.h>
+#include <fstream>
+#include <iomanip>
+using std::ofstream;
+using std::ios;
+using std::setw;
+using std::setprecision;
+using std::endl;
+
+ProfileStream::ProfileStream(const char *file, bool echoTime)
+  :OPS_Stream(OPS_STREAM_TAGS_ProfileStream),
+   fileName(0), echoTimeFlag(echoTime), numRows(0), closed(false)
+{
+  if (file != 0) {
+    fileName = new char[strlen(file)+1];
+    if (fileName == 0) {
+      opserr << "ProfileStream::ProfileStream() - out of memory\n";
+      return;
+    }
+    strcpy(fileName, file);
+  }
+}
+
+
+ProfileStream::~ProfileStream()
+{
+  this->close();
+
+  if (fileName != 0)
+    delete [] fileName;
+}
+
+
+int
+ProfileStream::write(Vector &data)
+{
+  if (closed == true)
+    return 0;
+
+  int start = (echoTimeFlag == true) ? 1 : 0;
+  int numColumns = data.Size() - start;
+  if (numColumns <= 0)
+    return 0;
+
+  double time = (echoTimeFlag == true) ? data(0) : numRows;
+
+  // the first row sets the size and the reference values
+  if (numRows == 0 || firstValue.Size() != numColumns) {
+    firstValue.resize(numColumns);
+    minValue.resize(numColumns);
+    maxValue.resize(numColumns);
+    absMaxValue.resize(numColumns);
+    absMaxTime.resize(numColumns);
+    maxGrowth.resize(numColumns);
+    maxDrop.resize(numColumns);
+
+    for (int i=0; i<numColumns; i++) {
+      double value = data(i+start);
+      firstValue(i) = value;
+      minValue(i) = value;
+      maxValue(i) = value;
+      absMaxValue(i) = fabs(value);
+      absMaxTime(i) = time;
+    }
+    maxGrowth.Zero();
+    maxDrop.Zero();
+    numRows = 1;
+    return 0;
+  }
+
+  for (int i=0; i<numColumns; i++) {
+    double value = data(i+start);
+    double absValue = fabs(value);
+    double value0 = firstValue(i);
+
+    if (value < minValue(i))
+      minValue(i) = value;
+    if (value > maxValue(i))
+      maxValue(i) = value;
+    if (absValue > absMaxValue(i)) {
+      absMaxValue(i) = absValue;
+      absMaxTime(i) = time;
+    }
+
+    double growth = absValue - fabs(value0);
+    if (growth > maxGrowth(i))
+      maxGrowth(i) = growth;
+
+    if (value0 != 0.0) {
+      double drop = -(value - value0)/value0;
+      if (drop > maxDrop(i))
+	maxDrop(i) = drop;
+    }
+  }
+
+  numRows++;
+  return 0;
+}
+
+
+int
+ProfileStream::close(void)
+{
+  if (closed == true)
+    return 0;
+  closed = true;
+
+  if (fileName == 0)
+    return 0;
+
+  ofstream theFile(fileName, ios::out);
+  if (theFile.bad() == true || theFile.is_open() == false) {
+    opserr << "WARNING - ProfileStream::close()";
+    opserr << " - could not open file " << fileName << endln;
+    return -1;
+  }
+
+  theFile << "# min max absMax timeOfAbsMax maxGrowth maxDrop\n";
+  theFile << setprecision(12);
+  int numColumns = firstValue.Size();
+  for (int i=0; i<numColumns; i++) {
+    theFile << minValue(i) << " " << maxValue(i) << " "
+	    << absMaxValue(i) << " " << absMaxTime(i) << " "
+	    << maxGrowth(i) << " " << maxDrop(i) << "\n";
+  }
+
+  theFile.close();
+  return 0;
+}
+
+
+int
+ProfileStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  static ID idData(2);
+  idData(0) = numRows;
+  idData(1) = firstValue.Size();
+  if (theChannel.sendID(0, commitTag, idData) < 0) {
+    opserr << "ProfileStream::sendSelf() - failed to send the sizes\n";
+    return -1;
+  }
+
+  if (idData(1) == 0)
+    return 0;
+
+  if (theChannel.sendVector(0, commitTag, firstValue) < 0 ||
+      theChannel.sendVector(0, commitTag, minValue) < 0 ||
+      theChannel.sendVector(0, commitTag, maxValue) < 0 ||
+      theChannel.sendVector(0, commitTag, absMaxValue) < 0 ||
+      theChannel.sendVector(0, commitTag, absMaxTime) < 0 ||
+      theChannel.sendVector(0, commitTag, maxGrowth) < 0 ||
+      theChannel.sendVector(0, commitTag, maxDrop) < 0) {
+    opserr << "ProfileStream::sendSelf() - failed to send the reductions\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+ProfileStream::recvSelf(int commitTag, Channel &theChannel,
+			FEM_ObjectBroker &theBroker)
+{
+  static ID idData(2);
+  if (theChannel.recvID(0, commitTag, idData) < 0) {
+    opserr << "ProfileStream::recvSelf() - failed to receive the sizes\n";
+    return -1;
+  }
+
+  numRows = idData(0);
+  int numColumns = idData(1);
+  firstValue.resize(numColumns);
+  minValue.resize(numColumns);
+  maxValue.resize(numColumns);
+  absMaxValue.resize(numColumns);
+  absMaxTime.resize(numColumns);
+  maxGrowth.resize(numColumns);
+  maxDrop.resize(numColumns);
+
+  if (numColumns == 0)
+    return 0;
+
+  if (theChannel.recvVector(0, commitTag, firstValue) < 0 ||
+      theChannel.recvVector(0, commitTag, minValue) < 0 ||
+      theChannel.recvVector(0, commitTag, maxValue) < 0 ||
+      theChannel.recvVector(0, commitTag, absMaxValue) < 0 ||
+      theChannel.recvVector(0, commitTag, absMaxTime) < 0 ||
+      theChannel.recvVector(0, commitTag, maxGrowth) < 0 ||
+      theChannel.recvVector(0, commitTag, maxDrop) < 0) {
+    opserr << "ProfileStream::recvSelf() - failed to receive the reductions\n";
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef _ProfileStream
+#define _ProfileStream
+
+// Description: This file contains the class definition for ProfileStream.
+// A ProfileStream is an OPS_Stream that, instead of writing every row of data
+// a recorder sends it, keeps a running reduction of each column: the min, max,
+// abs max and the time of the abs max, the largest growth of the magnitude
+// |v|-|v0| and the largest relative drop -(v-v0)/v0 from the first value v0.
+// When the stream is closed, or destroyed, the reductions are written to the
+// file with one line per column, giving the envelope of the response over the
+// whole record.
+
+#include <OPS_Stream.h>
+#include <Vector.h>
+
+class ProfileStream : public OPS_Stream
+{
+ public:
+  ProfileStream(const char *fileName, bool echoTime = true);
+  ~ProfileStream();
+
+  int close(void);
+
+  // the reductions so far, a value for each column
+  int getNumColumns(void) const {return firstValue.Size();};
+  const Vector &getMin(void) const {return minValue;};
+  const Vector &getMax(void) const {return maxValue;};
+  const Vector &getAbsMax(void) const {return absMaxValue;};
+  const Vector &getAbsMaxTime(void) const {return absMaxTime;};
+  const Vector &getMaxGrowth(void) const {return maxGrowth;};
+  const Vector &getMaxDrop(void) const {return maxDrop;};
+
+  // xml stuff
+  int tag(const char *) {return 0;};
+  int tag(const char *, const char *) {return 0;};
+  int endTag() {return 0;};
+  int attr(const char *name, int value) {return 0;};
+  int attr(const char *name, double value) {return 0;};
+  int attr(const char *name, const char *value) {return 0;};
+  int write(Vector &data);
+
+  OPS_Stream& write(const char *s, int n) {return *this;};
+  OPS_Stream& write(const unsigned char *s, int n) {return *this;};
+  OPS_Stream& write(const signed char *s, int n) {return *this;};
+  OPS_Stream& write(const void *s, int n) {return *this;};
+  OPS_Stream& operator<<(char c) {return *this;};
+  OPS_Stream& operator<<(unsigned char c) {return *this;};
+  OPS_Stream& operator<<(signed char c) {return *this;};
+  OPS_Stream& operator<<(const char *s) {return *this;};
+  OPS_Stream& operator<<(const unsigned char *s) {return *this;};
+  OPS_Stream& operator<<(const signed char *s) {return *this;};
+  OPS_Stream& operator<<(const void *p) {return *this;};
+  OPS_Stream& operator<<(int n) {return *this;};
+  OPS_Stream& operator<<(unsigned int n) {return *this;};
+  OPS_Stream& operator<<(long n) {return *this;};
+  OPS_Stream& operator<<(unsigned long n) {return *this;};
+  OPS_Stream& operator<<(short n) {return *this;};
+  OPS_Stream& operator<<(unsigned short n) {return *this;};
+  OPS_Stream& operator<<(bool b) {return *this;};
+  OPS_Stream& operator<<(double n) {return *this;};
+  OPS_Stream& operator<<(float n) {return *this;};
+
+  // the reductions so far, so a stream of a resumed analysis carries on
+  // from where the checkpointed one was
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker);
+
+ private:
+  char *fileName;
+  bool echoTimeFlag;            // first column of the data is the time
+  int numRows;
+  bool closed;
+
+  Vector firstValue;
+  Vector minValue;
+  Vector maxValue;
+  Vector absMaxValue;
+  Vector absMaxTime;
+  Vector maxGrowth;             // max of |v| - |v0|
+  Vector maxDrop;               // max of -(v - v0)/v0
+};
+
+#endif
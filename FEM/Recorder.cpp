@@ -65,6 +65,18 @@ Recorder::setDomain(Domain &theDomain)
   return 0;
 }
 
+int 
+Recorder::sendState(int commitTag, Channel &theChannel)
+{
+  return 0;
+}
+
+int 
+Recorder::recvState(int commitTag, Channel &theChannel)
+{
+  return 0;
+}
+
 int 
 Recorder::sendSelf(int commitTag, Channel &theChannel)
 {
@@ -56,6 +56,12 @@ class Recorder: public MovableObject, public TaggedObject
     virtual int recvSelf(int commitTag, Channel &theChannel, 
 			 FEM_ObjectBroker &theBroker);
 
+    // send and receive only what changes as the analysis runs, e.g. the
+    // time of the next record, so a recorder set up again in the same way
+    // can carry on from a checkpoint of the analysis
+    virtual int sendState(int commitTag, Channel &theChannel);
+    virtual int recvState(int commitTag, Channel &theChannel);
+
     virtual void Print(OPS_Stream &s, int flag); 
 
   protected:
@@ -154,13 +154,13 @@ SSPquadUP::SSPquadUP(int tag, int Nd1, int Nd2, int Nd3, int Nd4, NDMaterial &th
     Q(SQUP_NUM_DOF),
     mMass(SQUP_NUM_DOF,SQUP_NUM_DOF),
     mDamp(SQUP_NUM_DOF,SQUP_NUM_DOF),
-    mNodeCrd(2,4),
-    dN(4,2),
-    Mmem(3,8),
-    Kstab(8,8),
-    mSolidK(8,8),
-    mSolidM(8,8),
-    mPerm(4,4),
+    mNodeCrd(mNodeCrdData,2,4),
+    dN(dNData,4,2),
+    Mmem(MmemData,3,8),
+    Kstab(KstabData,8,8),
+    mSolidK(mSolidKData,8,8),
+    mSolidM(mSolidMData,8,8),
+    mPerm(mPermData,4,4),
     mThickness(thick),
     fBulk(Kf),
     fDens(Rf),
@@ -201,6 +201,14 @@ SSPquadUP::SSPquadUP(int tag, int Nd1, int Nd2, int Nd3, int Nd4, NDMaterial &th
 
     mPorosity = eVoid/(1.0 + eVoid);
 
+    mNodeCrd.Zero();
+    dN.Zero();
+    Mmem.Zero();
+    Kstab.Zero();
+    mSolidK.Zero();
+    mSolidM.Zero();
+    mPerm.Zero();
+
     const char *type = "PlaneStrain";
 
     // get copy of the material object
@@ -228,13 +236,13 @@ SSPquadUP::SSPquadUP()
     Q(SQUP_NUM_DOF),
     mMass(SQUP_NUM_DOF,SQUP_NUM_DOF),
     mDamp(SQUP_NUM_DOF,SQUP_NUM_DOF),
-    mNodeCrd(2,4),
-    dN(4,2),
-    Mmem(3,8),
-    Kstab(8,8),
-    mSolidK(8,8),
-    mSolidM(8,8),
-    mPerm(4,4),
+    mNodeCrd(mNodeCrdData,2,4),
+    dN(dNData,4,2),
+    Mmem(MmemData,3,8),
+    Kstab(KstabData,8,8),
+    mSolidK(mSolidKData,8,8),
+    mSolidM(mSolidMData,8,8),
+    mPerm(mPermData,4,4),
     mThickness(0),
     fBulk(0),
     fDens(0),
@@ -247,6 +255,13 @@ SSPquadUP::SSPquadUP()
 	pressureLeftSide(0.0),
 	pressureRightSide(0.0)
 {
+    mNodeCrd.Zero();
+    dN.Zero();
+    Mmem.Zero();
+    Kstab.Zero();
+    mSolidK.Zero();
+    mSolidM.Zero();
+    mPerm.Zero();
 }
 
 // destructor
@@ -316,6 +331,12 @@ SSPquadUP::setDomain(Domain *theDomain)
     J1 = ((mNodeCrd(0,1)-mNodeCrd(0,0))*(mNodeCrd(1,2)-mNodeCrd(1,3))+(mNodeCrd(0,2)-mNodeCrd(0,3))*(mNodeCrd(1,0)-mNodeCrd(1,1)))/24;
     J2 = ((mNodeCrd(0,0)-mNodeCrd(0,3))*(mNodeCrd(1,2)-mNodeCrd(1,1))+(mNodeCrd(0,2)-mNodeCrd(0,1))*(mNodeCrd(1,3)-mNodeCrd(1,0)))/24;
 
+    // jacobian at the nodes (xi,eta = -1,-1; 1,-1; 1,1; -1,1), used for nodal body forces and mass
+    mNodeJac[0] = J0 - J1 - J2;
+    mNodeJac[1] = J0 + J1 - J2;
+    mNodeJac[2] = J0 + J1 + J2;
+    mNodeJac[3] = J0 - J1 + J2;
+
     // establish stabilization terms (based on initial material tangent, only need to compute once)
     GetStab();
 
@@ -325,6 +346,9 @@ SSPquadUP::setDomain(Domain *theDomain)
     // establish permeability matrix (constant, only need to compute once)
     GetPermeabilityMatrix();
 
+    // establish full element mass matrix (constant, only need to compute once)
+    GetMassMatrix();
+
     //LM change
 	// Compute consistent nodal loads due to surface pressure (at any side)
     this->setPressureLoadAtNodes();
@@ -363,25 +387,18 @@ int
 SSPquadUP::update(void)
 // this function updates variables for an incremental step n to n+1
 {
-    // get trial displacement
-    const Vector &mDisp_1 = theNodes[0]->getTrialDisp();
-    const Vector &mDisp_2 = theNodes[1]->getTrialDisp();
-    const Vector &mDisp_3 = theNodes[2]->getTrialDisp();
-    const Vector &mDisp_4 = theNodes[3]->getTrialDisp();
-        
-    // assemble displacement vector
-    Vector u(8);
-    u(0) = mDisp_1(0);
-    u(1) = mDisp_1(1);
-    u(2) = mDisp_2(0);
-    u(3) = mDisp_2(1);
-    u(4) = mDisp_3(0);
-    u(5) = mDisp_3(1);
-    u(6) = mDisp_4(0);
-    u(7) = mDisp_4(1);
-
-    Vector strain(3);
-    strain = Mmem*u;
+    // assemble displacement vector from trial nodal displacements
+    double uData[8];
+    for (int i = 0; i < 4; i++) {
+        const Vector &mDisp = theNodes[i]->getTrialDisp();
+        uData[2*i]   = mDisp(0);
+        uData[2*i+1] = mDisp(1);
+    }
+    Vector u(uData, 8);
+
+    double strainData[3];
+    Vector strain(strainData, 3);
+    strain.addMatrixVector(0.0, Mmem, u, 1.0);
     theMaterial->setTrialStrain(strain);
 
     return 0;
@@ -394,6 +411,15 @@ SSPquadUP::getTangentStiff(void)
     // solid phase stiffness matrix
     GetSolidStiffness();
 
+    AssembleStiffness();
+
+    return mTangentStiffness;
+}
+
+void
+SSPquadUP::AssembleStiffness(void)
+// this function assembles the tangent stiffness matrix from the current solid phase stiffness
+{
     // assemble full element stiffness matrix [ K  0 ]
     // comprised of K submatrix               [ 0  0 ]
     mTangentStiffness.Zero();
@@ -419,7 +445,7 @@ SSPquadUP::getTangentStiff(void)
         }
     }
 
-    return mTangentStiffness;
+    return;
 }
 
 const Matrix &
@@ -432,11 +458,22 @@ SSPquadUP::getInitialStiff(void)
 const Matrix &
 SSPquadUP::getDamp(void)
 {
-    Matrix dampC(8,8);
-
     // solid phase stiffness matrix
     GetSolidStiffness();
 
+    AssembleDamping();
+
+    return mDamp;
+}
+
+void
+SSPquadUP::AssembleDamping(void)
+// this function assembles the damping matrix from the current solid phase stiffness
+{
+    double dampCData[8*8];
+    Matrix dampC(dampCData, 8, 8);
+    dampC.Zero();
+
     // contribution of stiffness matrix for Rayleigh damping
     if (betaK != 0.0) {
         dampC.addMatrix(1.0, mSolidK, betaK);
@@ -487,11 +524,19 @@ SSPquadUP::getDamp(void)
         }
     }
 
-    return mDamp;
+    return;
 }
 
 const Matrix &
 SSPquadUP::getMass(void)
+{
+    // mass matrix is constant, it is formed once in setDomain()
+    return mMass;
+}
+
+void
+SSPquadUP::GetMassMatrix(void)
+// this function computes the full element mass matrix
 {
     mMass.Zero();
 
@@ -512,7 +557,7 @@ SSPquadUP::getMass(void)
 
     // return zero matrix if density is zero
     if (density == 0.0) {
-        return mMass;
+        return;
     }
 
     // full mass matrix for the element [ M  0 ]
@@ -543,7 +588,7 @@ SSPquadUP::getMass(void)
         }
     }
 
-    return mMass;
+    return;
 }
 
 void
@@ -628,31 +673,24 @@ const Vector &
 SSPquadUP::getResistingForce(void)
 // this function computes the resisting force vector for the element
 {
-    Vector f1(8);
-    Vector f2(4);
-    Vector mStress(3); 
+    double f1Data[8];
+    double f2[4];
+    Vector f1(f1Data, 8);
         
     // get stress from the material
-    mStress = theMaterial->getStress();
+    const Vector &mStress = theMaterial->getStress();
 
     // get trial displacement
-    const Vector &mDisp_1 = theNodes[0]->getTrialDisp();
-    const Vector &mDisp_2 = theNodes[1]->getTrialDisp();
-    const Vector &mDisp_3 = theNodes[2]->getTrialDisp();
-    const Vector &mDisp_4 = theNodes[3]->getTrialDisp();
-
-    Vector d(8);
-    d(0) = mDisp_1(0);
-    d(1) = mDisp_1(1);
-    d(2) = mDisp_2(0);
-    d(3) = mDisp_2(1);
-    d(4) = mDisp_3(0);
-    d(5) = mDisp_3(1);
-    d(6) = mDisp_4(0);
-    d(7) = mDisp_4(1);
+    double dData[8];
+    for (int i = 0; i < 4; i++) {
+        const Vector &mDisp = theNodes[i]->getTrialDisp();
+        dData[2*i]   = mDisp(0);
+        dData[2*i+1] = mDisp(1);
+    }
+    Vector d(dData, 8);
 
     // add stabilization force to internal force vector 
-    f1 = Kstab*d;
+    f1.addMatrixVector(0.0, Kstab, d, 1.0);
 
     // add internal force from the stress
     f1.addMatrixTransposeVector(1.0, Mmem, mStress, 4.0*mThickness*J0);
@@ -660,53 +698,41 @@ SSPquadUP::getResistingForce(void)
     // get mass density from the material
     double density = theMaterial->getRho();
 
-    // subtract body forces from internal force vector 
-    double xi[4];
-    double eta[4];
-    xi[0]  = -1.0; xi[1]  =  1.0; xi[2]  = 1.0; xi[3]  = -1.0;
-    eta[0] = -1.0; eta[1] = -1.0; eta[2] = 1.0; eta[3] =  1.0;
-
+    // body force vector
+    double body[2];
     if (applyLoad == 0) {
-        for (int i = 0; i < 4; i++) {
-            f1(2*i)   -= density*b[0]*mThickness*(J0 + J1*xi[i] + J2*eta[i]);
-            f1(2*i+1) -= density*b[1]*mThickness*(J0 + J1*xi[i] + J2*eta[i]);
-        }
+        body[0] = b[0];
+        body[1] = b[1];
     } else {
-        for (int i = 0; i < 4; i++) {
-            f1(2*i)   -= density*appliedB[0]*mThickness*(J0 + J1*xi[i] + J2*eta[i]);
-            f1(2*i+1) -= density*appliedB[1]*mThickness*(J0 + J1*xi[i] + J2*eta[i]);
-        }
+        body[0] = appliedB[0];
+        body[1] = appliedB[1];
     }
 
-    // account for fluid body forces
-    Matrix k(2,2);
-    Vector body(2);
-    // permeability tensor
-    k(0,0) = perm[0];
-    k(1,1) = perm[1];
-    // body force vector
-    if (applyLoad == 0) {
-        body(0) = b[0];
-        body(1) = b[1];
-    } else {
-        body(0) = appliedB[0];
-        body(1) = appliedB[1];
+    // subtract body forces from internal force vector 
+    for (int i = 0; i < 4; i++) {
+        f1(2*i)   -= density*body[0]*mThickness*mNodeJac[i];
+        f1(2*i+1) -= density*body[1]*mThickness*mNodeJac[i];
+    }
+
+    // account for fluid body forces, f2 = 4*J0*t*rho_f*dN*k*body with diagonal permeability tensor k
+    double fluidFact = 4.0*J0*mThickness*fDens;
+    for (int i = 0; i < 4; i++) {
+        f2[i] = fluidFact*dN(i,0)*perm[0]*body[0] + fluidFact*dN(i,1)*perm[1]*body[1];
     }
-    f2 = 4.0*J0*mThickness*fDens*dN*k*body;
 
     // assemble full internal force vector for the element
     mInternalForces(0)  = f1(0);
     mInternalForces(1)  = f1(1);
-    mInternalForces(2)  = f2(0);
+    mInternalForces(2)  = f2[0];
     mInternalForces(3)  = f1(2);
     mInternalForces(4)  = f1(3);
-    mInternalForces(5)  = f2(1);
+    mInternalForces(5)  = f2[1];
     mInternalForces(6)  = f1(4);
     mInternalForces(7)  = f1(5);
-    mInternalForces(8)  = f2(2);
+    mInternalForces(8)  = f2[2];
     mInternalForces(9)  = f1(6);
     mInternalForces(10) = f1(7);
-    mInternalForces(11) = f2(3);
+    mInternalForces(11) = f2[3];
 
     //LM change
     // Subtract pressure loading from internal force vector
@@ -724,60 +750,73 @@ SSPquadUP::getResistingForce(void)
 const Vector &
 SSPquadUP::getResistingForceIncInertia()
 {
-	// terms stemming from acceleration
-	const Vector &accel1 = theNodes[0]->getTrialAccel();
-	const Vector &accel2 = theNodes[1]->getTrialAccel();
-	const Vector &accel3 = theNodes[2]->getTrialAccel();
-	const Vector &accel4 = theNodes[3]->getTrialAccel();
-	
 	// compute current resisting force
 	this->getResistingForce();
 
-	// compute mass matrix
-	this->getMass();
+	// compute damping matrix
+	this->getDamp();
+
+	AddInertiaAndDampingForces();
+
+	return mInternalForces;
+}
+
+const Vector &
+SSPquadUP::getResistingForceIncInertiaAndTangent(Matrix &theTangent, double kFact, double cFact, double mFact)
+// this function forms the resisting force incl. inertia together with the tangent,
+// the solid phase stiffness is obtained from the material once for both
+{
+	// solid phase stiffness matrix
+	GetSolidStiffness();
+
+	AssembleStiffness();
+	AssembleDamping();
 
-	Vector a(12);
-	a(0)  = accel1(0);
-	a(1)  = accel1(1);
-	a(2)  = accel1(2);
-	a(3)  = accel2(0);
-	a(4)  = accel2(1);
-	a(5)  = accel2(2);
-	a(6)  = accel3(0);
-	a(7)  = accel3(1);
-	a(8)  = accel3(2);
-	a(9)  = accel4(0);
-	a(10) = accel4(1);
-	a(11) = accel4(2);
+	// compute current resisting force
+	this->getResistingForce();
+
+	AddInertiaAndDampingForces();
 
+	if (kFact != 0.0)
+		theTangent.addMatrix(1.0, mTangentStiffness, kFact);
+	if (cFact != 0.0)
+		theTangent.addMatrix(1.0, mDamp, cFact);
+	if (mFact != 0.0)
+		theTangent.addMatrix(1.0, mMass, mFact);
+
+	return mInternalForces;
+}
+
+void
+SSPquadUP::AddInertiaAndDampingForces(void)
+// this function adds M*a + C*v to the internal forces using the current damping matrix
+{
+	// terms stemming from acceleration
+	double aData[SQUP_NUM_DOF];
+	for (int i = 0; i < 4; i++) {
+		const Vector &accel = theNodes[i]->getTrialAccel();
+		aData[3*i]   = accel(0);
+		aData[3*i+1] = accel(1);
+		aData[3*i+2] = accel(2);
+	}
+	Vector a(aData, SQUP_NUM_DOF);
+
+	// mass matrix is constant (formed in setDomain)
 	mInternalForces.addMatrixVector(1.0, mMass, a, 1.0);
 
 	// terms stemming from velocity
-	const Vector &vel1 = theNodes[0]->getTrialVel();
-	const Vector &vel2 = theNodes[1]->getTrialVel();
-	const Vector &vel3 = theNodes[2]->getTrialVel();
-	const Vector &vel4 = theNodes[3]->getTrialVel();
-	
-	Vector v(12);
-	v(0)  = vel1(0);
-	v(1)  = vel1(1);
-	v(2)  = vel1(2);
-	v(3)  = vel2(0);
-	v(4)  = vel2(1);
-	v(5)  = vel2(2);
-	v(6)  = vel3(0);
-	v(7)  = vel3(1);
-	v(8)  = vel3(2);
-	v(9)  = vel4(0);
-	v(10) = vel4(1);
-	v(11) = vel4(2);
-
-	// compute damping matrix
-	this->getDamp();
+	double vData[SQUP_NUM_DOF];
+	for (int i = 0; i < 4; i++) {
+		const Vector &vel = theNodes[i]->getTrialVel();
+		vData[3*i]   = vel(0);
+		vData[3*i+1] = vel(1);
+		vData[3*i+2] = vel(2);
+	}
+	Vector v(vData, SQUP_NUM_DOF);
 
 	mInternalForces.addMatrixVector(1.0, mDamp, v, 1.0);
 
-	return mInternalForces;
+	return;
 }
 
 int
@@ -1064,7 +1103,7 @@ SSPquadUP::updateParameter(int parameterID, Information &info)
 }
 
 Matrix 
-SSPquadUP::DyadicProd(Vector v1, Vector v2)
+SSPquadUP::DyadicProd(const Vector &v1, const Vector &v2)
 // computes dyadic product for two vectors (2x1)
 {
 	Matrix result(2,2);
@@ -1188,15 +1227,11 @@ SSPquadUP::GetSolidMass(void)
 	// get mass density from the material
 	double density = theMaterial->getRho();
 
-	// local coordinates of nodes
-	double xi[4];
-	double eta[4];
-	xi[0]  = -1.0; xi[1]  =  1.0; xi[2]  = 1.0; xi[3]  = -1.0;
-	eta[0] = -1.0; eta[1] = -1.0; eta[2] = 1.0; eta[3] =  1.0;
+	mSolidM.Zero();
 
 	double massTerm;
 	for (int i = 0; i < 4; i++) {
-		massTerm = density*mThickness*(J0 + J1*xi[i] + J2*eta[i]);
+		massTerm = density*mThickness*mNodeJac[i];
 		mSolidM(2*i,2*i)     += massTerm;
 		mSolidM(2*i+1,2*i+1) += massTerm;
 	}
@@ -91,6 +91,7 @@ class SSPquadUP : public Element
     int addInertiaLoadToUnbalance(const Vector &accel);
     const Vector &getResistingForce(void);
     const Vector &getResistingForceIncInertia(void);
+    const Vector &getResistingForceIncInertiaAndTangent(Matrix &theTangent, double kFact, double cFact, double mFact);
 
     // public methods for element output
     int sendSelf(int commitTag, Channel &theChannel);
@@ -114,11 +115,15 @@ class SSPquadUP : public Element
   private:
 
     // member functions
-    Matrix DyadicProd(Vector v1, Vector v2);   // dyadic product for two 2x1 vectors
+    Matrix DyadicProd(const Vector &v1, const Vector &v2);   // dyadic product for two 2x1 vectors
     void GetStab(void);                        // compute stabilization stiffness matrix
     void GetSolidStiffness(void);              // compute solid phase stiffness matrix
     void GetSolidMass(void);                   // compute solid phase mass matrix
     void GetPermeabilityMatrix(void);          // compute permeability matrix
+    void GetMassMatrix(void);                  // compute full element mass matrix
+    void AssembleStiffness(void);              // assemble full element stiffness from solid phase stiffness
+    void AssembleDamping(void);                // assemble full element damping from solid phase stiffness
+    void AddInertiaAndDampingForces(void);     // add M*a + C*v to the internal force vector
     // LM change        
 	void setPressureLoadAtNodes(void);
     // LM change
@@ -162,6 +167,17 @@ class SSPquadUP : public Element
     double J2;                                 // linear (eta) portion of jacobian
     double mPorosity;                          // porosity of solid phase n = e/(1+e)
     double mAlpha;
+    double mNodeJac[SQUP_NUM_NODE];            // jacobian evaluated at the nodes, J0 + J1*xi + J2*eta
+
+    // fixed-size storage for the element operators below, so that the
+    // time-stepping path (update/residual/tangent) never touches the heap
+    double MmemData[3*8];
+    double KstabData[8*8];
+    double mNodeCrdData[SQUP_NUM_DIM*SQUP_NUM_NODE];
+    double dNData[SQUP_NUM_NODE*SQUP_NUM_DIM];
+    double mSolidKData[8*8];
+    double mSolidMData[8*8];
+    double mPermData[SQUP_NUM_NODE*SQUP_NUM_NODE];
         
     Matrix Mmem;                               // mapping matrix for membrane modes
     Matrix Kstab;                              // stabilization stiffness matrix
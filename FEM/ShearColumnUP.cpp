@@ -0,0 +1,932 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+//
+// Description: This file contains the implementation of the ShearColumnUP class
+//                2-node u-p element for 1D (shear column) site response analysis
+//                of saturated porous media
+//
+//              The operators are those of an SSPquadUP element of width w and
+//              height h whose left and right nodes are tied at each elevation
+//              (the usual periodic 1D column), summed onto the column nodes:
+//                - the strain at the center is (0, du_y/dy, du_x/dy) and the
+//                  hourglass mode vanishes, so no stabilization is needed
+//                - horizontal flow vanishes, so only the vertical permeability
+//                  enters the permeability matrix
+//              so a column of these elements reproduces the tied SSPquadUP strip
+//              with half the nodes and no constraints.
+//
+// References:  Zienkiewicz, O.C. and Shiomi, T. (1984). "Dynamic behavior of
+//                saturated porous media; the generalized Biot formulation and
+//                its numerical solution." International Journal for Numerical
+//                Methods in Geomechanics, 8, 71-96.
+//              McGann, C.R., Arduino, P., and Mackenzie-Helnwein, P. (2012) "Stabilized single-point
+//                4-node quadrilateral element for dynamic analysis of fluid saturated porous media."
+//                Acta Geotechnica, 7(4):297-311
+
+#include "ShearColumnUP.h"
+
+#include <elementAPI.h>
+#include <Information.h>
+#include <ElementResponse.h>
+#include <ElementalLoad.h>
+#include <ID.h>
+#include <Domain.h>
+#include <Node.h>
+#include <Channel.h>
+#include <Message.h>
+#include <FEM_ObjectBroker.h>
+#include <Renderer.h>
+#include <G3Globals.h>
+#include <ErrorHandler.h>
+#include <NDMaterial.h>
+#include <Parameter.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define OPS_Export
+
+#define OPS_PRINT_CURRENTSTATE 1
+#define OPS_PRINT_PRINTMODEL_JSON 1
+
+OPS_Export void *
+OPS_ShearColumnUP(void)
+{
+    // Pointer to an element that will be returned
+    Element *theElement = 0;
+
+    int numRemainingInputArgs = OPS_GetNumRemainingInputArgs();
+    if (numRemainingInputArgs < 12) {
+        opserr << "Invalid #args, want: element ShearColumnUP eleTag? iNode? jNode? matTag? w? t? fBulk? fDen? k1? k2? e? alpha? <b1? b2?>\n";
+        return 0;
+    }
+
+    int iData[4];
+    double dData[10];
+    dData[8] = 0.0;
+    dData[9] = 0.0;
+
+    int numData = 4;
+    if (OPS_GetIntInput(&numData, iData) != 0) {
+        opserr << "WARNING invalid integer data: element ShearColumnUP " << iData[0] << endln;
+        return 0;
+    }
+
+    numData = 8;
+    if (OPS_GetDoubleInput(&numData, dData) != 0) {
+        opserr << "WARNING invalid double data: element ShearColumnUP " << iData[0] << endln;
+        return 0;
+    }
+
+    int matID = iData[3];
+    NDMaterial *theMaterial = OPS_getNDMaterial(matID);
+    if (theMaterial == 0) {
+        opserr << "WARNING element ShearColumnUP " << iData[0] << endln;
+        opserr << " Material: " << matID << "not found\n";
+        return 0;
+    }
+
+    if (numRemainingInputArgs == 14) {
+        numData = 2;
+        if (OPS_GetDoubleInput(&numData, &dData[8]) != 0) {
+            opserr << "WARNING invalid optional data: element ShearColumnUP " << iData[0] << endln;
+            return 0;
+        }
+    }
+
+    // parsing was successful, allocate the element
+    theElement = new ShearColumnUP(iData[0], iData[1], iData[2], *theMaterial,
+                                   dData[0], dData[1], dData[2], dData[3], dData[4],
+                                   dData[5], dData[6], dData[7], dData[8], dData[9]);
+
+    if (theElement == 0) {
+        opserr << "WARNING could not create element of type ShearColumnUP\n";
+        return 0;
+    }
+
+    return theElement;
+}
+
+// full constructor
+ShearColumnUP::ShearColumnUP(int tag, int Nd1, int Nd2, NDMaterial &theMat,
+                             double width, double thick, double Kf, double Rf, double k1, double k2,
+                             double eVoid, double alpha, double b1, double b2)
+  :Element(tag,ELE_TAG_ShearColumnUP),
+    theMaterial(0),
+    mExternalNodes(SCUP_NUM_NODE),
+    mTangentStiffness(SCUP_NUM_DOF,SCUP_NUM_DOF),
+    mInternalForces(SCUP_NUM_DOF),
+    Q(SCUP_NUM_DOF),
+    mDamp(SCUP_NUM_DOF,SCUP_NUM_DOF),
+    mMass(SCUP_NUM_DOF,SCUP_NUM_DOF),
+    mWidth(width),
+    mThickness(thick),
+    fBulk(Kf),
+    fDens(Rf),
+    applyLoad(0),
+    mHeight(0),
+    mPorosity(0),
+    mAlpha(alpha),
+    Bmat(BmatData,3,4),
+    mSolidK(mSolidKData,4,4)
+{
+    mExternalNodes(0) = Nd1;
+    mExternalNodes(1) = Nd2;
+
+    theNodes[0] = 0;
+    theNodes[1] = 0;
+
+    b[0] = b1;
+    b[1] = b2;
+
+    appliedB[0] = 0.0;
+    appliedB[1] = 0.0;
+
+    perm[0] = k1;
+    perm[1] = k2;
+
+    mPorosity = eVoid/(1.0 + eVoid);
+
+    Bmat.Zero();
+    mSolidK.Zero();
+
+    const char *type = "PlaneStrain";
+
+    // get copy of the material object
+    NDMaterial *theMatCopy = theMat.getCopy(type);
+    if (theMatCopy != 0) {
+        theMaterial = (NDMaterial *)theMatCopy;
+    } else {
+        opserr << "ShearColumnUP::ShearColumnUP - failed to get copy of material model\n";;
+    }
+
+    // check material
+    if (theMaterial == 0) {
+        opserr << "ShearColumnUP::ShearColumnUP - failed to allocate material model pointer\n";
+        exit(-1);
+    }
+}
+
+// null constructor
+ShearColumnUP::ShearColumnUP()
+  :Element(0,ELE_TAG_ShearColumnUP),
+    theMaterial(0),
+    mExternalNodes(SCUP_NUM_NODE),
+    mTangentStiffness(SCUP_NUM_DOF,SCUP_NUM_DOF),
+    mInternalForces(SCUP_NUM_DOF),
+    Q(SCUP_NUM_DOF),
+    mDamp(SCUP_NUM_DOF,SCUP_NUM_DOF),
+    mMass(SCUP_NUM_DOF,SCUP_NUM_DOF),
+    mWidth(0),
+    mThickness(0),
+    fBulk(0),
+    fDens(0),
+    applyLoad(0),
+    mHeight(0),
+    mPorosity(0),
+    mAlpha(0),
+    Bmat(BmatData,3,4),
+    mSolidK(mSolidKData,4,4)
+{
+    theNodes[0] = 0;
+    theNodes[1] = 0;
+
+    b[0] = 0.0;
+    b[1] = 0.0;
+    appliedB[0] = 0.0;
+    appliedB[1] = 0.0;
+    perm[0] = 0.0;
+    perm[1] = 0.0;
+
+    Bmat.Zero();
+    mSolidK.Zero();
+}
+
+// destructor
+ShearColumnUP::~ShearColumnUP()
+{
+    if (theMaterial != 0) {
+        delete theMaterial;
+    }
+}
+
+int
+ShearColumnUP::getNumExternalNodes(void) const
+{
+    return SCUP_NUM_NODE;
+}
+
+const ID &
+ShearColumnUP::getExternalNodes(void)
+{
+    return mExternalNodes;
+}
+
+Node **
+ShearColumnUP::getNodePtrs(void)
+{
+    return theNodes;
+}
+
+int
+ShearColumnUP::getNumDOF(void)
+{
+    return SCUP_NUM_DOF;
+}
+
+void
+ShearColumnUP::setDomain(Domain *theDomain)
+{
+    theNodes[0] = theDomain->getNode(mExternalNodes(0));
+    theNodes[1] = theDomain->getNode(mExternalNodes(1));
+
+    for (int i = 0; i < SCUP_NUM_NODE; i++) {
+        if (theNodes[i] == 0) {
+            return;  // don't go any further - otherwise segmentation fault
+        }
+        if (theNodes[i]->getNumberDOF() != SCUP_NODE_DOF) {
+            opserr << "ShearColumnUP::setDomain - node " << mExternalNodes(i)
+                   << " does not have 3 dof, element " << this->getTag() << endln;
+            return;
+        }
+    }
+
+    // element height from the vertical coordinates, node 1 is the bottom node
+    const Vector &mIcrd_1 = theNodes[0]->getCrds();
+    const Vector &mIcrd_2 = theNodes[1]->getCrds();
+    mHeight = mIcrd_2(1) - mIcrd_1(1);
+
+    if (mHeight <= 0.0) {
+        opserr << "ShearColumnUP::setDomain - node " << mExternalNodes(1) << " must be above node "
+               << mExternalNodes(0) << ", element " << this->getTag() << endln;
+        return;
+    }
+
+    // strain-displacement matrix, solid dofs ordered (u_x1, u_y1, u_x2, u_y2)
+    //   eps_xx = 0,  eps_yy = (u_y2 - u_y1)/h,  gamma_xy = (u_x2 - u_x1)/h
+    Bmat.Zero();
+    Bmat(1,1) = -1.0/mHeight;
+    Bmat(1,3) =  1.0/mHeight;
+    Bmat(2,0) = -1.0/mHeight;
+    Bmat(2,2) =  1.0/mHeight;
+
+    // establish full element mass matrix (constant, only need to compute once)
+    GetMassMatrix();
+
+    // call the base-class method
+    this->DomainComponent::setDomain(theDomain);
+}
+
+int
+ShearColumnUP::commitState(void)
+{
+    int retVal = 0;
+    // call element commitState to do any base class stuff
+    if ((retVal = this->Element::commitState()) != 0) {
+        opserr << "ShearColumnUP::commitState() - failed in base class\n";
+    }
+    retVal = theMaterial->commitState();
+
+    return retVal;
+}
+
+int
+ShearColumnUP::revertToLastCommit(void)
+{
+    return theMaterial->revertToLastCommit();
+}
+
+int
+ShearColumnUP::revertToStart(void)
+{
+    return theMaterial->revertToStart();
+}
+
+int
+ShearColumnUP::update(void)
+// this function updates variables for an incremental step n to n+1
+{
+    // assemble displacement vector from trial nodal displacements
+    double uData[4];
+    for (int i = 0; i < 2; i++) {
+        const Vector &mDisp = theNodes[i]->getTrialDisp();
+        uData[2*i]   = mDisp(0);
+        uData[2*i+1] = mDisp(1);
+    }
+    Vector u(uData, 4);
+
+    double strainData[3];
+    Vector strain(strainData, 3);
+    strain.addMatrixVector(0.0, Bmat, u, 1.0);
+    theMaterial->setTrialStrain(strain);
+
+    return 0;
+}
+
+const Matrix &
+ShearColumnUP::getTangentStiff(void)
+// this function computes the tangent stiffness matrix for the element
+{
+    // solid phase stiffness matrix
+    GetSolidStiffness(theMaterial->getTangent());
+
+    AssembleStiffness();
+
+    return mTangentStiffness;
+}
+
+const Matrix &
+ShearColumnUP::getInitialStiff(void)
+// this function computes the initial tangent stiffness matrix for the element
+{
+    GetSolidStiffness(theMaterial->getInitialTangent());
+
+    AssembleStiffness();
+
+    return mTangentStiffness;
+}
+
+void
+ShearColumnUP::AssembleStiffness(void)
+// this function assembles the tangent stiffness matrix from the current solid phase stiffness
+{
+    // assemble full element stiffness matrix [ K  0 ]
+    // comprised of K submatrix               [ 0  0 ]
+    mTangentStiffness.Zero();
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            mTangentStiffness(3*i,3*j)     = mSolidK(2*i,2*j);
+            mTangentStiffness(3*i+1,3*j)   = mSolidK(2*i+1,2*j);
+            mTangentStiffness(3*i+1,3*j+1) = mSolidK(2*i+1,2*j+1);
+            mTangentStiffness(3*i,3*j+1)   = mSolidK(2*i,2*j+1);
+        }
+    }
+
+    return;
+}
+
+const Matrix &
+ShearColumnUP::getDamp(void)
+{
+    // solid phase stiffness matrix
+    GetSolidStiffness(theMaterial->getTangent());
+
+    AssembleDamping();
+
+    return mDamp;
+}
+
+void
+ShearColumnUP::AssembleDamping(void)
+// this function assembles the damping matrix from the current solid phase stiffness
+{
+    double dampCData[4*4];
+    Matrix dampC(dampCData, 4, 4);
+    dampC.Zero();
+
+    // contribution of stiffness matrix for Rayleigh damping
+    if (betaK != 0.0) {
+        dampC.addMatrix(1.0, mSolidK, betaK);
+    } if (betaK0 != 0.0) {
+        dampC.addMatrix(1.0, mSolidK, betaK0);
+    } if (betaKc != 0.0) {
+        dampC.addMatrix(1.0, mSolidK, betaKc);
+    }
+
+    // contribution of (lumped) solid mass matrix for Rayleigh damping
+    if (alphaM != 0.0) {
+        double massTerm = alphaM*0.5*theMaterial->getRho()*mWidth*mHeight*mThickness;
+        for (int i = 0; i < 4; i++)
+            dampC(i,i) += massTerm;
+    }
+
+    // solid-fluid coupling and permeability terms
+    double area = mWidth*mThickness;
+    double coupling[2];
+    coupling[0] =  0.5*area;
+    coupling[1] = -0.5*area;
+    double permTerm = area*perm[1]/mHeight;
+
+    // assemble full element damping matrix   [  C  -Q ]
+    // comprised of C, Q, and H submatrices   [ -Q' -H ]
+    mDamp.Zero();
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+
+            // contribution of solid phase damping matrix
+            mDamp(3*i,3*j)     = dampC(2*i,2*j);
+            mDamp(3*i+1,3*j)   = dampC(2*i+1,2*j);
+            mDamp(3*i+1,3*j+1) = dampC(2*i+1,2*j+1);
+            mDamp(3*i,3*j+1)   = dampC(2*i,2*j+1);
+
+            // contribution of solid-fluid coupling matrix
+            mDamp(3*j+2,3*i+1) = coupling[i];
+            mDamp(3*i+1,3*j+2) = coupling[i];
+
+            // contribution of permeability matrix
+            mDamp(3*i+2,3*j+2) = (i == j) ? -permTerm : permTerm;
+        }
+    }
+
+    return;
+}
+
+const Matrix &
+ShearColumnUP::getMass(void)
+{
+    // mass matrix is constant, it is formed once in setDomain()
+    return mMass;
+}
+
+void
+ShearColumnUP::GetMassMatrix(void)
+{
+    mMass.Zero();
+
+    // get mass density from the material
+    double density = theMaterial->getRho();
+
+    // return zero matrix if density is zero (as SSPquadUP)
+    if (density == 0.0) {
+        return;
+    }
+
+    double volume = mWidth*mHeight*mThickness;
+
+    // lumped solid mass
+    double massTerm = 0.5*density*volume;
+
+    // compressibility term and stabilization for incompressible problems
+    double oneOverQ = -0.25*volume*mPorosity/fBulk;
+    double kpTerm = -mAlpha*mWidth*mThickness/mHeight;
+
+    // full mass matrix for the element [ M  0 ]
+    //  includes M and S submatrices    [ 0 -S ]
+    for (int i = 0; i < 2; i++) {
+        mMass(3*i,3*i)     = massTerm;
+        mMass(3*i+1,3*i+1) = massTerm;
+
+        for (int j = 0; j < 2; j++)
+            mMass(3*i+2,3*j+2) = ((i == j) ? kpTerm : -kpTerm) + oneOverQ;
+    }
+
+    return;
+}
+
+void
+ShearColumnUP::zeroLoad(void)
+{
+    applyLoad = 0;
+    appliedB[0] = 0.0;
+    appliedB[1] = 0.0;
+
+    Q.Zero();
+
+    return;
+}
+
+int
+ShearColumnUP::addLoad(ElementalLoad *theLoad, double loadFactor)
+{
+    // body forces can be applied in a load pattern
+    int type;
+    const Vector &data = theLoad->getData(type, loadFactor);
+
+    if (type == LOAD_TAG_SelfWeight) {
+        applyLoad = 1;
+        appliedB[0] += loadFactor*data(0)*b[0];
+        appliedB[1] += loadFactor*data(1)*b[1];
+        return 0;
+    } else {
+        opserr << "ShearColumnUP::addLoad - load type unknown for ele with tag: " << this->getTag() << endln;
+        return -1;
+    }
+
+    return -1;
+}
+
+int
+ShearColumnUP::addInertiaLoadToUnbalance(const Vector &accel)
+{
+    // get mass density from the material
+    double density = theMaterial->getRho();
+
+    // do nothing if density is zero
+    if (density == 0.0) {
+        return 0;
+    }
+
+    // Get R * accel from the nodes
+    const Vector &Raccel1 = theNodes[0]->getRV(accel);
+    const Vector &Raccel2 = theNodes[1]->getRV(accel);
+
+    if (3 != Raccel1.Size() || 3 != Raccel2.Size()) {
+        opserr << "ShearColumnUP::addInertiaLoadToUnbalance matrix and vector sizes are incompatable\n";
+        return -1;
+    }
+
+    double ra[SCUP_NUM_DOF];
+    ra[0] = Raccel1(0);
+    ra[1] = Raccel1(1);
+    ra[2] = 0.0;
+    ra[3] = Raccel2(0);
+    ra[4] = Raccel2(1);
+    ra[5] = 0.0;
+
+    for (int i = 0; i < SCUP_NUM_DOF; i++) {
+        Q(i) += -mMass(i,i)*ra[i];
+    }
+
+    return 0;
+}
+
+const Vector &
+ShearColumnUP::getResistingForce(void)
+// this function computes the resisting force vector for the element
+{
+    double f1Data[4];
+    double f2[2];
+    Vector f1(f1Data, 4);
+
+    double volume = mWidth*mHeight*mThickness;
+
+    // get stress from the material
+    const Vector &mStress = theMaterial->getStress();
+
+    // internal force from the stress
+    f1.addMatrixTransposeVector(0.0, Bmat, mStress, volume);
+
+    // get mass density from the material
+    double density = theMaterial->getRho();
+
+    // body force vector
+    double body[2];
+    if (applyLoad == 0) {
+        body[0] = b[0];
+        body[1] = b[1];
+    } else {
+        body[0] = appliedB[0];
+        body[1] = appliedB[1];
+    }
+
+    // subtract body forces from internal force vector, half the weight to each node
+    for (int i = 0; i < 2; i++) {
+        f1(2*i)   -= 0.5*density*body[0]*volume;
+        f1(2*i+1) -= 0.5*density*body[1]*volume;
+    }
+
+    // account for fluid body forces, only the vertical flow remains in the column
+    double fluidFact = mWidth*mThickness*fDens*perm[1]*body[1];
+    f2[0] = -fluidFact;
+    f2[1] =  fluidFact;
+
+    // assemble full internal force vector for the element
+    mInternalForces(0) = f1(0);
+    mInternalForces(1) = f1(1);
+    mInternalForces(2) = f2[0];
+    mInternalForces(3) = f1(2);
+    mInternalForces(4) = f1(3);
+    mInternalForces(5) = f2[1];
+
+    // inertial unbalance load
+    mInternalForces.addVector(1.0, Q, -1.0);
+
+    return mInternalForces;
+}
+
+const Vector &
+ShearColumnUP::getResistingForceIncInertia()
+{
+    // compute current resisting force
+    this->getResistingForce();
+
+    // compute damping matrix
+    this->getDamp();
+
+    AddInertiaAndDampingForces();
+
+    return mInternalForces;
+}
+
+const Vector &
+ShearColumnUP::getResistingForceIncInertiaAndTangent(Matrix &theTangent, double kFact, double cFact, double mFact)
+// this function forms the resisting force incl. inertia together with the tangent,
+// the material tangent is obtained once for both
+{
+    // solid phase stiffness matrix
+    GetSolidStiffness(theMaterial->getTangent());
+
+    AssembleStiffness();
+    AssembleDamping();
+
+    // compute current resisting force
+    this->getResistingForce();
+
+    AddInertiaAndDampingForces();
+
+    if (kFact != 0.0)
+        theTangent.addMatrix(1.0, mTangentStiffness, kFact);
+    if (cFact != 0.0)
+        theTangent.addMatrix(1.0, mDamp, cFact);
+    if (mFact != 0.0)
+        theTangent.addMatrix(1.0, mMass, mFact);
+
+    return mInternalForces;
+}
+
+void
+ShearColumnUP::AddInertiaAndDampingForces(void)
+// this function adds M*a + C*v to the internal forces using the current damping matrix
+{
+    // terms stemming from acceleration
+    double aData[SCUP_NUM_DOF];
+    for (int i = 0; i < 2; i++) {
+        const Vector &accel = theNodes[i]->getTrialAccel();
+        aData[3*i]   = accel(0);
+        aData[3*i+1] = accel(1);
+        aData[3*i+2] = accel(2);
+    }
+    Vector a(aData, SCUP_NUM_DOF);
+
+    // mass matrix is constant (formed in setDomain)
+    mInternalForces.addMatrixVector(1.0, mMass, a, 1.0);
+
+    // terms stemming from velocity
+    double vData[SCUP_NUM_DOF];
+    for (int i = 0; i < 2; i++) {
+        const Vector &vel = theNodes[i]->getTrialVel();
+        vData[3*i]   = vel(0);
+        vData[3*i+1] = vel(1);
+        vData[3*i+2] = vel(2);
+    }
+    Vector v(vData, SCUP_NUM_DOF);
+
+    mInternalForces.addMatrixVector(1.0, mDamp, v, 1.0);
+
+    return;
+}
+
+int
+ShearColumnUP::sendSelf(int commitTag, Channel &theChannel)
+{
+    int res = 0;
+
+    // note: we don't check for dataTag == 0 for Element
+    // objects as that is taken care of in a commit by the Domain
+    // object - don't want to have to do the check if sending data
+    int dataTag = this->getDbTag();
+
+    // ShearColumnUP packs its data into a Vector and sends this to theChannel
+    // along with its dbTag and the commitTag passed in the arguments
+    static Vector data(14);
+    data(0) = this->getTag();
+    data(1) = mWidth;
+    data(2) = mThickness;
+    data(3) = fBulk;
+    data(4) = fDens;
+    data(5) = perm[0];
+    data(6) = perm[1];
+    data(7) = mPorosity;
+    data(8) = mAlpha;
+    data(9) = b[0];
+    data(10) = b[1];
+    data(11) = theMaterial->getClassTag();
+
+    // Now ShearColumnUP sends the ids of its materials
+    int matDbTag = theMaterial->getDbTag();
+
+    // NOTE: we do have to ensure that the material has a database
+    // tag if we are sending to a database channel.
+    if (matDbTag == 0) {
+        matDbTag = theChannel.getDbTag();
+        if (matDbTag != 0) {
+            theMaterial->setDbTag(matDbTag);
+        }
+    }
+    data(12) = matDbTag;
+    data(13) = 0.0;
+
+    res += theChannel.sendVector(dataTag, commitTag, data);
+    if (res < 0) {
+        opserr << "WARNING ShearColumnUP::sendSelf() - " << this->getTag() << " failed to send Vector\n";
+        return res;
+    }
+
+    // ShearColumnUP then sends the tags of its two nodes
+    res += theChannel.sendID(dataTag, commitTag, mExternalNodes);
+    if (res < 0) {
+        opserr << "WARNING ShearColumnUP::sendSelf() - " << this->getTag() << " failed to send ID\n";
+        return res;
+    }
+
+    // finally, ShearColumnUP asks its material object to send itself
+    res = theMaterial->sendSelf(commitTag, theChannel);
+    if (res < 0) {
+        opserr << "WARNING ShearColumnUP::sendSelf() - " << this->getTag() << " failed to send its Material\n";
+        return -3;
+    }
+
+    return 0;
+}
+
+int
+ShearColumnUP::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+    int res = 0;
+    int dataTag = this->getDbTag();
+
+    // ShearColumnUP creates a Vector, receives the Vector and then sets the
+    // internal data with the data in the Vector
+    static Vector data(14);
+    res += theChannel.recvVector(dataTag, commitTag, data);
+    if (res < 0) {
+        opserr << "WARNING ShearColumnUP::recvSelf() - failed to receive Vector\n";
+        return res;
+    }
+
+    this->setTag((int)data(0));
+    mWidth = data(1);
+    mThickness = data(2);
+    fBulk = data(3);
+    fDens = data(4);
+    perm[0] = data(5);
+    perm[1] = data(6);
+    mPorosity = data(7);
+    mAlpha = data(8);
+    b[0] = data(9);
+    b[1] = data(10);
+
+    // ShearColumnUP now receives the tags of its two external nodes
+    res += theChannel.recvID(dataTag, commitTag, mExternalNodes);
+    if (res < 0) {
+        opserr << "WARNING ShearColumnUP::recvSelf() - " << this->getTag() << " failed to receive ID\n";
+        return res;
+    }
+
+    // finally, ShearColumnUP creates a material object of the correct type, sets its
+    // database tag, and asks this new object to receive itself
+    int matClass = (int)data(11);
+    int matDb    = (int)data(12);
+
+    // check if material object exists and that it is the right type
+    if ((theMaterial == 0) || (theMaterial->getClassTag() != matClass)) {
+
+        // if old one, delete it
+        if (theMaterial != 0)
+            delete theMaterial;
+
+        // create new material object
+        NDMaterial *theMatCopy = theBroker.getNewNDMaterial(matClass);
+        theMaterial = (NDMaterial *)theMatCopy;
+
+        if (theMaterial == 0) {
+            opserr << "WARNING ShearColumnUP::recvSelf() - " << this->getTag()
+                   << " failed to get a blank Material of type " << matClass << endln;
+            return -3;
+        }
+    }
+
+    // NOTE: we set the dbTag before we receive the material
+    theMaterial->setDbTag(matDb);
+    res = theMaterial->recvSelf(commitTag, theChannel, theBroker);
+    if (res < 0) {
+        opserr << "WARNING ShearColumnUP::recvSelf() - " << this->getTag() << " failed to receive its Material\n";
+        return -3;
+    }
+
+    return 0;
+}
+
+int
+ShearColumnUP::displaySelf(Renderer &theViewer, int displayMode, float fact, const char **modes, int numMode)
+{
+    return 0;
+}
+
+void
+ShearColumnUP::Print(OPS_Stream &s, int flag)
+{
+    if (flag == OPS_PRINT_CURRENTSTATE) {
+        s << "ShearColumnUP, element id:  " << this->getTag() << endln;
+        s << "   Connected external nodes:  ";
+        for (int i = 0; i < SCUP_NUM_NODE; i++) {
+            s << mExternalNodes(i) << " ";
+        }
+        s << endln;
+    }
+
+    if (flag == OPS_PRINT_PRINTMODEL_JSON) {
+        s << "\t\t\t{";
+        s << "\"name\": " << this->getTag() << ", ";
+        s << "\"type\": \"ShearColumnUP\", ";
+        s << "\"nodes\": [" << mExternalNodes(0) << ", ";
+        s << mExternalNodes(1) << "], ";
+        s << "\"width\": " << mWidth << ", ";
+        s << "\"thickness\": " << mThickness << ", ";
+        s << "\"bodyForces\": [" << b[0] << ", " << b[1] << "], ";
+        s << "\"material\": \"" << theMaterial->getTag() << "\"}";
+    }
+}
+
+Response*
+ShearColumnUP::setResponse(const char **argv, int argc, OPS_Stream &eleInfo)
+{
+    // no special recorders for this element, call the method in the material class
+    return theMaterial->setResponse(argv, argc, eleInfo);
+}
+
+int
+ShearColumnUP::getResponse(int responseID, Information &eleInfo)
+{
+    // no special recorders for this element, call the method in the material class
+    return theMaterial->getResponse(responseID, eleInfo);
+}
+
+int
+ShearColumnUP::setParameter(const char **argv, int argc, Parameter &param)
+{
+    if (argc < 1) {
+        return -1;
+    }
+    int res = -1;
+
+    // check for element parameters first, ids as in SSPquadUP
+    if (strcmp(argv[0],"hPerm") == 0) {
+        return param.addObject(3, this);
+    } else if (strcmp(argv[0],"vPerm") == 0) {
+        return param.addObject(4, this);
+    } else if (strcmp(argv[0],"b1") == 0) {
+        return param.addObject(13,this);
+    } else if (strcmp(argv[0],"b2") == 0) {
+        return param.addObject(14,this);
+    } else {
+        // default is to call setParameter in the material
+        int matRes = res;
+        matRes =  theMaterial->setParameter(argv, argc, param);
+        if (matRes != -1) {
+            res = matRes;
+        }
+    }
+
+    return res;
+}
+
+int
+ShearColumnUP::updateParameter(int parameterID, Information &info)
+{
+    int res = -1;
+    int matRes = res;
+
+    if (parameterID == res) {
+        return -1;
+    } else if (parameterID == 3) {
+        // horizontal permeability, kept for input compatibility (no horizontal flow in the column)
+        perm[0] = info.theDouble;
+        return 0;
+    } else if (parameterID == 4) {
+        // update element permeability in direction 2
+        perm[1] = info.theDouble;
+        return 0;
+    } else if (parameterID == 13) {
+        b[0] = info.theDouble;
+        return 0;
+    } else if (parameterID == 14) {
+        b[1] = info.theDouble;
+        return 0;
+    } else {
+        // update the material parameter
+        matRes = theMaterial->updateParameter(parameterID, info);
+        if (matRes != -1) {
+            res = matRes;
+        }
+        return res;
+    }
+}
+
+void
+ShearColumnUP::GetSolidStiffness(const Matrix &Cmat)
+// this function computes the stiffness matrix for the solid phase
+{
+    mSolidK.addMatrixTripleProduct(0.0, Bmat, Cmat, mWidth*mHeight*mThickness);
+
+    return;
+}
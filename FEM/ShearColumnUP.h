@@ -0,0 +1,155 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ShearColumnUP_h
+#define ShearColumnUP_h
+
+//
+// Description: This file contains the class definition for ShearColumnUP
+//                2-node u-p element for 1D (shear column) site response
+//                analysis of saturated porous media. Each node carries the
+//                horizontal and vertical displacement and the pore pressure.
+//                The element is the SSPquadUP element of width w with the
+//                left and right nodes at each elevation tied together, written
+//                directly in terms of the column nodes: the material is called
+//                in plane strain with strain (0, du_y/dy, du_x/dy).
+//
+// Reference:   Zienkiewicz, O.C. and Shiomi, T. (1984). "Dynamic behavior of
+//                saturated porous media; the generalized Biot formulation and
+//                its numerical solution." International Journal for Numerical
+//                Methods in Geomechanics, 8, 71-96.
+
+#include <Element.h>
+#include <Node.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <ID.h>
+
+// number of nodes per element
+#define SCUP_NUM_NODE 2
+// degrees of freedom per node
+#define SCUP_NODE_DOF 3
+// degrees of freedom per element
+#define SCUP_NUM_DOF  6
+
+class Domain;
+class Node;
+class Channel;
+class NDMaterial;
+class FEM_ObjectBroker;
+class Response;
+
+class ShearColumnUP : public Element
+{
+  public:
+    ShearColumnUP(int tag, int Nd1, int Nd2, NDMaterial &theMat,
+                  double width, double thick, double Kf, double Rf, double k1, double k2,
+                  double eVoid, double alpha, double b1 = 0.0, double b2 = 0.0);
+    ShearColumnUP();
+    ~ShearColumnUP();
+
+    // public methods to obtain information about dof and connectivity
+    int getNumExternalNodes(void) const;
+    const ID &getExternalNodes(void);
+    Node **getNodePtrs(void);
+    int getNumDOF(void);
+    void setDomain(Domain *theDomain);
+
+    // public methods to set the state of the element
+    int commitState(void);
+    int revertToLastCommit(void);
+    int revertToStart(void);
+    int update(void);
+
+    // public methods to obtain stiffness, mass, damping, and residual info
+    const Matrix &getTangentStiff(void);
+    const Matrix &getInitialStiff(void);
+    const Matrix &getDamp(void);
+    const Matrix &getMass(void);
+
+    void zeroLoad(void);
+    int addLoad(ElementalLoad *theLoad, double loadFactor);
+    int addInertiaLoadToUnbalance(const Vector &accel);
+    const Vector &getResistingForce(void);
+    const Vector &getResistingForceIncInertia(void);
+    const Vector &getResistingForceIncInertiaAndTangent(Matrix &theTangent, double kFact, double cFact, double mFact);
+
+    // public methods for element output
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
+    int displaySelf(Renderer &theViewer, int displayMode, float fact, const char **modes, int numMode);
+    void Print(OPS_Stream &s, int flag =0);
+
+    Response *setResponse(const char **argv, int argc, OPS_Stream &eleInfo);
+    int getResponse(int responseID, Information &eleInformation);
+
+    // public methods for material stage update
+    int setParameter(const char **argv, int argc, Parameter &param);
+    int updateParameter(int parameterID, Information &info);
+
+  protected:
+
+  private:
+
+    // member functions
+    void GetSolidStiffness(const Matrix &Cmat);  // compute solid phase stiffness matrix from a material tangent
+    void GetMassMatrix(void);                  // compute full element mass matrix
+    void AssembleStiffness(void);              // assemble full element stiffness from solid phase stiffness
+    void AssembleDamping(void);                // assemble full element damping from solid phase stiffness
+    void AddInertiaAndDampingForces(void);     // add M*a + C*v to the internal force vector
+
+    // objects
+    NDMaterial *theMaterial;                   // pointer to NDMaterial object
+    ID mExternalNodes;                         // contains tags of the nodes
+    Matrix mTangentStiffness;                  // tangent stiffness matrix
+    Vector mInternalForces;                    // vector of internal forces
+    Vector Q;                                  // vector of applied nodal forces
+    Matrix mDamp;                              // damping matrix
+    Matrix mMass;                              // mass matrix
+
+    Node *theNodes[SCUP_NUM_NODE];
+
+    // input quantities
+    double mWidth;                             // width of the column (in-plane)
+    double mThickness;                         // thickness of element (out-of-plane)
+    double fBulk;                              // bulk modulus of pore fluid
+    double fDens;                              // pore fluid mass density
+    double perm[2];                            // horiz and vertical permeability
+    double b[2];                               // body forces acting on element
+
+    // load pattern variables
+    double appliedB[2];                        // body forces applied with load pattern
+    int    applyLoad;                          // flag for body force in load pattern
+
+    // calculation variables
+    double mHeight;                            // element height, y2 - y1
+    double mPorosity;                          // porosity of solid phase n = e/(1+e)
+    double mAlpha;
+
+    // fixed-size storage for the element operators below, so that the
+    // time-stepping path (update/residual/tangent) never touches the heap
+    double BmatData[3*4];
+    double mSolidKData[4*4];
+
+    Matrix Bmat;                               // strain-displacement matrix for the solid dofs
+    Matrix mSolidK;                            // stiffness matrix for solid phase
+};
+
+#endif
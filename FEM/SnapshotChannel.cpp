@@ -0,0 +1,322 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for SnapshotChannel.
+
+#include <SnapshotChannel.h>
+#include <MovableObject.h>
+#include <FEM_ObjectBroker.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <OPS_Globals.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define SNAPSHOT_VECTOR 1
+#define SNAPSHOT_MATRIX 2
+#define SNAPSHOT_ID     3
+
+static const char snapshotMagic[8] = {'O','P','S','S','N','A','P','1'};
+
+SnapshotChannel::SnapshotChannel()
+  :currentPos(0)
+{
+
+}
+
+
+SnapshotChannel::~SnapshotChannel()
+{
+
+}
+
+
+char *
+SnapshotChannel::addToProgram(void)
+{
+  return 0;
+}
+
+
+int
+SnapshotChannel::setUpConnection(void)
+{
+  return 0;
+}
+
+
+int
+SnapshotChannel::setNextAddress(const ChannelAddress &theAddress)
+{
+  return 0;
+}
+
+
+ChannelAddress *
+SnapshotChannel::getLastSendersAddress(void)
+{
+  return 0;
+}
+
+
+int
+SnapshotChannel::sendObj(int commitTag,
+			 MovableObject &theObject,
+			 ChannelAddress *theAddress)
+{
+  return theObject.sendSelf(commitTag, *this);
+}
+
+
+int
+SnapshotChannel::recvObj(int commitTag,
+			 MovableObject &theObject,
+			 FEM_ObjectBroker &theBroker,
+			 ChannelAddress *theAddress)
+{
+  return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int
+SnapshotChannel::sendMsg(int dbTag, int commitTag,
+			 const Message &theMessage,
+			 ChannelAddress *theAddress)
+{
+  opserr << "SnapshotChannel::sendMsg() - not implemented\n";
+  return -1;
+}
+
+
+int
+SnapshotChannel::recvMsg(int dbTag, int commitTag,
+			 Message &theMessage,
+			 ChannelAddress *theAddress)
+{
+  opserr << "SnapshotChannel::recvMsg() - not implemented\n";
+  return -1;
+}
+
+
+int
+SnapshotChannel::recvMsgUnknownSize(int dbTag, int commitTag,
+				    Message &theMessage,
+				    ChannelAddress *theAddress)
+{
+  opserr << "SnapshotChannel::recvMsgUnknownSize() - not implemented\n";
+  return -1;
+}
+
+
+int
+SnapshotChannel::sendMatrix(int dbTag, int commitTag,
+			    const Matrix &theMatrix,
+			    ChannelAddress *theAddress)
+{
+  return this->put(SNAPSHOT_MATRIX, theMatrix.numRows, theMatrix.numCols,
+		   theMatrix.data, theMatrix.numRows*theMatrix.numCols*sizeof(double));
+}
+
+
+int
+SnapshotChannel::recvMatrix(int dbTag, int commitTag,
+			    Matrix &theMatrix,
+			    ChannelAddress *theAddress)
+{
+  return this->get(SNAPSHOT_MATRIX, theMatrix.numRows, theMatrix.numCols,
+		   theMatrix.data, theMatrix.numRows*theMatrix.numCols*sizeof(double));
+}
+
+
+int
+SnapshotChannel::sendVector(int dbTag, int commitTag,
+			    const Vector &theVector,
+			    ChannelAddress *theAddress)
+{
+  return this->put(SNAPSHOT_VECTOR, theVector.sz, 1,
+		   theVector.theData, theVector.sz*sizeof(double));
+}
+
+
+int
+SnapshotChannel::recvVector(int dbTag, int commitTag,
+			    Vector &theVector,
+			    ChannelAddress *theAddress)
+{
+  return this->get(SNAPSHOT_VECTOR, theVector.sz, 1,
+		   theVector.theData, theVector.sz*sizeof(double));
+}
+
+
+int
+SnapshotChannel::sendID(int dbTag, int commitTag,
+			const ID &theID,
+			ChannelAddress *theAddress)
+{
+  return this->put(SNAPSHOT_ID, theID.sz, 1, theID.data, theID.sz*sizeof(int));
+}
+
+
+int
+SnapshotChannel::recvID(int dbTag, int commitTag,
+			ID &theID,
+			ChannelAddress *theAddress)
+{
+  return this->get(SNAPSHOT_ID, theID.sz, 1, theID.data, theID.sz*sizeof(int));
+}
+
+
+void
+SnapshotChannel::clear(void)
+{
+  theData.clear();
+  currentPos = 0;
+}
+
+
+void
+SnapshotChannel::rewind(void)
+{
+  currentPos = 0;
+}
+
+
+int
+SnapshotChannel::getSize(void) const
+{
+  return theData.size();
+}
+
+
+unsigned long long
+SnapshotChannel::getHash(void) const
+{
+  unsigned long long hash = 14695981039346656037ULL;
+  for (size_t i=0; i<theData.size(); i++) {
+    hash ^= (unsigned char)theData[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+
+int
+SnapshotChannel::save(const char *fileName, unsigned long long key, double time) const
+{
+  FILE *theFile = fopen(fileName, "wb");
+  if (theFile == 0) {
+    opserr << "SnapshotChannel::save() - could not open file " << fileName << endln;
+    return -1;
+  }
+
+  unsigned long long size = theData.size();
+  bool ok = (fwrite(snapshotMagic, sizeof(snapshotMagic), 1, theFile) == 1) &&
+    (fwrite(&key, sizeof(key), 1, theFile) == 1) &&
+    (fwrite(&time, sizeof(time), 1, theFile) == 1) &&
+    (fwrite(&size, sizeof(size), 1, theFile) == 1) &&
+    (size == 0 || fwrite(&theData[0], 1, size, theFile) == size);
+  ok = (fclose(theFile) == 0) && ok;
+
+  if (ok == false) {
+    opserr << "SnapshotChannel::save() - could not write file " << fileName << endln;
+    remove(fileName);
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+SnapshotChannel::load(const char *fileName, unsigned long long &key, double &time)
+{
+  this->clear();
+
+  FILE *theFile = fopen(fileName, "rb");
+  if (theFile == 0)
+    return -1;
+
+  char magic[sizeof(snapshotMagic)];
+  unsigned long long size = 0;
+  bool ok = (fread(magic, sizeof(magic), 1, theFile) == 1) &&
+    (memcmp(magic, snapshotMagic, sizeof(magic)) == 0) &&
+    (fread(&key, sizeof(key), 1, theFile) == 1) &&
+    (fread(&time, sizeof(time), 1, theFile) == 1) &&
+    (fread(&size, sizeof(size), 1, theFile) == 1);
+
+  if (ok == true && size > 0) {
+    theData.resize(size);
+    ok = (fread(&theData[0], 1, size, theFile) == size);
+  }
+  fclose(theFile);
+
+  if (ok == false) {
+    this->clear();
+    return -1;
+  }
+
+  return 0;
+}
+
+
+// each item is recorded as its type and two sizes followed by the data
+int
+SnapshotChannel::put(int type, int size1, int size2, const void *data, int numBytes)
+{
+  int header[3];
+  header[0] = type;
+  header[1] = size1;
+  header[2] = size2;
+
+  const char *headerBytes = (const char *)header;
+  theData.insert(theData.end(), headerBytes, headerBytes + sizeof(header));
+  if (numBytes > 0) {
+    const char *dataBytes = (const char *)data;
+    theData.insert(theData.end(), dataBytes, dataBytes + numBytes);
+  }
+
+  return 0;
+}
+
+
+int
+SnapshotChannel::get(int type, int size1, int size2, void *data, int numBytes)
+{
+  int header[3];
+  if (currentPos + sizeof(header) + numBytes > theData.size()) {
+    opserr << "SnapshotChannel::get() - nothing more to receive\n";
+    return -1;
+  }
+
+  memcpy(header, &theData[currentPos], sizeof(header));
+  if (header[0] != type || header[1] != size1 || header[2] != size2) {
+    opserr << "SnapshotChannel::get() - the object received does not match the one sent\n";
+    return -1;
+  }
+
+  currentPos += sizeof(header);
+  if (numBytes > 0)
+    memcpy(data, &theData[currentPos], numBytes);
+  currentPos += numBytes;
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef SnapshotChannel_h
+#define SnapshotChannel_h
+
+// Description: This file contains the class definition for SnapshotChannel.
+// A SnapshotChannel records in memory the Vectors, Matrices and IDs that
+// objects send to it in sendSelf() and hands them back in the same order
+// to the recvSelf() of the same objects, so the state of a set of objects
+// can be kept and put back later. The dbTag and commitTag are ignored. The record
+// can be saved to and loaded from a binary file, stamped with a key that
+// identifies what it was taken from.
+
+#include <Channel.h>
+#include <vector>
+
+class SnapshotChannel : public Channel
+{
+  public:
+    SnapshotChannel();
+    ~SnapshotChannel();
+
+    // methods defined in the Channel class interface which mean nothing here
+    char *addToProgram(void);
+    int setUpConnection(void);
+    int setNextAddress(const ChannelAddress &theAddress);
+    ChannelAddress *getLastSendersAddress(void);
+
+    int sendObj(int commitTag,
+		MovableObject &theObject,
+		ChannelAddress *theAddress =0);
+    int recvObj(int commitTag,
+		MovableObject &theObject,
+		FEM_ObjectBroker &theBroker,
+		ChannelAddress *theAddress =0);
+
+    int sendMsg(int dbTag, int commitTag,
+		const Message &theMessage,
+		ChannelAddress *theAddress =0);
+    int recvMsg(int dbTag, int commitTag,
+		Message &theMessage,
+		ChannelAddress *theAddress =0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+		Message &theMessage,
+		ChannelAddress *theAddress =0);
+
+    int sendMatrix(int dbTag, int commitTag,
+		   const Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag,
+		   Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+
+    int sendVector(int dbTag, int commitTag,
+		   const Vector &theVector,
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag,
+		   Vector &theVector,
+		   ChannelAddress *theAddress =0);
+
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+    // empty the record, or go back to its start to receive it again
+    void clear(void);
+    void rewind(void);
+    int getSize(void) const;
+
+    // a 64 bit FNV-1a hash of the record
+    unsigned long long getHash(void) const;
+
+    // the file holds the key, the time and the record; load() returns -1 if
+    // the file cannot be read or was not written by save()
+    int save(const char *fileName, unsigned long long key, double time) const;
+    int load(const char *fileName, unsigned long long &key, double &time);
+
+  private:
+    int put(int type, int size1, int size2, const void *data, int numBytes);
+    int get(int type, int size1, int size2, void *data, int numBytes);
+
+    std::vector<char> theData;
+    int currentPos;
+};
+
+#endif
@@ -540,6 +540,14 @@ TransformationDOF_Group::setNodeVel(const Vector &u)
 }
 
 
+// the response goes through the transformation, not a plain copy
+bool
+TransformationDOF_Group::hasPlainNodeResponse(void) const
+{
+    return false;
+}
+
+
 void
 TransformationDOF_Group::setNodeAccel(const Vector &u)
 {
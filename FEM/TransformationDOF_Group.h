@@ -80,6 +80,7 @@ class TransformationDOF_Group: public DOF_Group
     void setNodeDisp(const Vector &u);
     void setNodeVel(const Vector &udot);
     void setNodeAccel(const Vector &udotdot);
+    bool hasPlainNodeResponse(void) const;
 
     void incrNodeDisp(const Vector &u);
     void incrNodeVel(const Vector &udot);
@@ -292,7 +292,39 @@ const Matrix &
 TransformationFE::getTangent(Integrator *theNewIntegrator)
 {
     const Matrix &theTangent = this->FE_Element::getTangent(theNewIntegrator);
+    return this->transformTangent(theTangent);
+}
+
+
+const Vector &
+TransformationFE::getResidual(Integrator *theNewIntegrator)
+{
+    const Vector &theResidual = this->FE_Element::getResidual(theNewIntegrator);
+    return this->transformResidual(theResidual);
+}
+
+
+// the residual and tangent formed in a single pass over the element are
+// transformed in the same way as those of getResidual() and getTangent()
+const Vector &
+TransformationFE::getResidualAndTangent(Integrator *theNewIntegrator)
+{
+    const Vector &theResidual = this->FE_Element::getResidualAndTangent(theNewIntegrator);
+    return this->transformResidual(theResidual);
+}
+
+
+const Matrix &
+TransformationFE::getFormedTangent(void)
+{
+    const Matrix &theTangent = this->FE_Element::getFormedTangent();
+    return this->transformTangent(theTangent);
+}
 
+
+const Matrix &
+TransformationFE::transformTangent(const Matrix &theTangent)
+{
     static ID numDOFs(dofData, 1);
     numDOFs.setData(dofData, numGroups);
     
@@ -388,10 +420,8 @@ TransformationFE::getTangent(Integrator *theNewIntegrator)
 
 
 const Vector &
-TransformationFE::getResidual(Integrator *theNewIntegrator)
-
+TransformationFE::transformResidual(const Vector &theResidual)
 {
-    const Vector &theResidual = this->FE_Element::getResidual(theNewIntegrator);
     // DO THE SP STUFF TO THE TANGENT
     
     // perform Tt R  -- as T is block diagonal do T(i)^T R(i)
@@ -56,6 +56,8 @@ class TransformationFE: public FE_Element
     // methods to form and obtain the tangent and residual
     virtual const Matrix &getTangent(Integrator *theIntegrator);
     virtual const Vector &getResidual(Integrator *theIntegrator);
+    virtual const Vector &getResidualAndTangent(Integrator *theIntegrator);
+    virtual const Matrix &getFormedTangent(void);
     
     // methods for ele-by-ele strategies
     virtual const Vector &getTangForce(const Vector &x, double fact = 1.0);
@@ -79,6 +81,9 @@ class TransformationFE: public FE_Element
     int transformResponse(const Vector &modResponse, Vector &unmodResponse);
     
   private:
+    // T^t K T and T^t R of the tangent and residual of the element
+    const Matrix &transformTangent(const Matrix &theTangent);
+    const Vector &transformResidual(const Vector &theResidual);
     
     // private variables - a copy for each object of the class        
     DOF_Group **theDOFs;
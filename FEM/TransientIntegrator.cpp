@@ -144,6 +144,78 @@ TransientIntegrator::formUnbalance(void) {
     return 0;
 }
     
+int
+TransientIntegrator::formUnbalanceAndTangent(int statFlag)
+{
+    // only the current tangent is formed together with the unbalance
+    if (statFlag != CURRENT_TANGENT)
+      return this->IncrementalIntegrator::formUnbalanceAndTangent(statFlag);
+
+    int result = 0;
+    statusFlag = statFlag;
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theLinSOE == 0 || theModel == 0) {
+	opserr << "WARNING TransientIntegrator::formUnbalanceAndTangent() ";
+	opserr << "no LinearSOE or AnalysisModel has been set\n";
+	return -1;
+    }
+
+    // contributions are added in the same order as formTangent() followed
+    // by formUnbalance() so results are identical to the separate calls
+
+    theLinSOE->zeroA();
+    theLinSOE->zeroB();
+
+    // do modal damping
+    bool inclModalMatrix=theModel->inclModalDampingMatrix();
+    const Vector *modalValues = theModel->getModalDampingFactors();
+    if (modalValues != 0) {
+      if (inclModalMatrix == true)
+	this->addModalDampingMatrix(modalValues);
+      this->addModalDampingForce(modalValues);
+    }
+
+    // loop through the DOF_Groups and add the tangent
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    DOF_Group *dofPtr;
+    
+    while ((dofPtr = theDOFs()) != 0) {
+	if (theLinSOE->addA(dofPtr->getTangent(this),dofPtr->getID()) <0) {
+	    opserr << "TransientIntegrator::formUnbalanceAndTangent() - failed to addA:dof\n";
+	    result = -1;
+	}
+    }
+
+    // loop through the FE_Elements getting them to form the residual and
+    // tangent together; the two must be added before moving to the next
+    // FE_Element as FE_Elements of the same size share storage
+    FE_EleIter &theEles2 = theModel->getFEs();    
+    FE_Element *elePtr;    
+    while((elePtr = theEles2()) != 0) {
+	const Vector &theResidual = elePtr->getResidualAndTangent(this);
+	if (theLinSOE->addA(elePtr->getFormedTangent(),elePtr->getID()) < 0) {
+	    opserr << "TransientIntegrator::formUnbalanceAndTangent() - failed to addA:ele\n";
+	    result = -2;
+	}
+	if (theLinSOE->addB(theResidual,elePtr->getID()) < 0) {
+	    opserr << "TransientIntegrator::formUnbalanceAndTangent() - failed to addB:ele\n";
+	    result = -2;
+	}
+    }
+
+    if (result < 0)
+      return result;
+
+    if (this->formNodalUnbalance() < 0) {
+	opserr << "WARNING TransientIntegrator::formUnbalanceAndTangent() ";
+	opserr << " - this->formNodalUnbalance failed\n";
+	return -2;
+    }    
+
+    return 0;
+}
+
 int
 TransientIntegrator::formEleResidual(FE_Element *theEle)
 {
@@ -55,6 +55,7 @@ class TransientIntegrator : public IncrementalIntegrator
 
     virtual int formTangent(int statFlag);
     virtual int formUnbalance(void);
+    virtual int formUnbalanceAndTangent(int statFlag = CURRENT_TANGENT);
     virtual int formEleResidual(FE_Element *theEle);
     virtual int formNodUnbalance(DOF_Group *theDof);    
 
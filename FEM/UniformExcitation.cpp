@@ -43,6 +43,7 @@
 #include <SP_ConstraintIter.h>
 #include <SP_Constraint.h>
 #include <elementAPI.h>
+#include <Matrix.h>
 
 void* OPS_TimeSeriesIntegrator();
 
@@ -190,7 +191,8 @@ void* OPS_UniformExcitationPattern()
 
 UniformExcitation::UniformExcitation()
 :EarthquakePattern(0, PATTERN_TAG_UniformExcitation), 
- theMotion(0), theDof(0), vel0(0.0), fact(0.0)
+ theMotion(0), theDof(0), vel0(0.0), fact(0.0),
+ theNodes(0), theForces(0), numNodes(0), lastStamp(-1)
 {
 
 }
@@ -199,7 +201,8 @@ UniformExcitation::UniformExcitation()
 UniformExcitation::UniformExcitation(GroundMotion &_theMotion, 
 				     int dof, int tag, double velZero, double theFactor)
 :EarthquakePattern(tag, PATTERN_TAG_UniformExcitation), 
- theMotion(&_theMotion), theDof(dof), vel0(velZero), fact(theFactor)
+ theMotion(&_theMotion), theDof(dof), vel0(velZero), fact(theFactor),
+ theNodes(0), theForces(0), numNodes(0), lastStamp(-1)
 {
   // add the motion to the list of ground motions
   this->addMotion(*theMotion);
@@ -208,7 +211,7 @@ UniformExcitation::UniformExcitation(GroundMotion &_theMotion,
 
 UniformExcitation::~UniformExcitation()
 {
-
+  this->clearEffectiveForces();
 }
 
 
@@ -285,60 +288,171 @@ UniformExcitation::applyLoad(double time)
     Domain *theDomain = this->getDomain();
     if (theDomain == 0)
         return;
+
+    // R and M*R only change with the domain; while a change is pending,
+    // i.e. before the analysis has seen it, they are formed every step
+    if (theDomain->getDomainChangeFlag() == true ||
+        theDomain->getDomainChangeStamp() != lastStamp)
+        this->formEffectiveForces(*theDomain);
+
+    // another pattern has set R since, the elements need ours back
+    else if (theDomain->getInfluenceSetter() != this) {
+        for (int i=0; i<numNodes; i++)
+            this->setInfluence(theNodes[i]);
+        theDomain->setInfluenceSetter(this);
+    }
     
-    NodeIter &theNodes = theDomain->getNodes();
-    Node *theNode;
-    while ((theNode = theNodes()) != 0) {
-        theNode->setNumColR(1);
-        const Vector &crds=theNode->getCrds();
-        int ndm = crds.Size();
-        
-        if (ndm == 1) {
+    this->EarthquakePattern::applyLoad(time);
+    
+    return;
+}
+
+
+void
+UniformExcitation::addInertiaLoads(Domain &theDomain, const Vector &accelG)
+{
+    // forces could not be formed, do it node by node
+    if (lastStamp < 0) {
+        this->EarthquakePattern::addInertiaLoads(theDomain, accelG);
+        return;
+    }
+
+    // - M*R*accelG, as Node::addInertiaLoadToUnbalance() would add it
+    double accel = accelG(0);
+    for (int i=0; i<numNodes; i++)
+        if (theForces[i] != 0)
+            theNodes[i]->addUnbalancedLoad(*theForces[i], -accel);
+
+    ElementIter &theElements = theDomain.getElements();
+    Element *theElement;
+    while ((theElement = theElements()) != 0) 
+        theElement->addInertiaLoadToUnbalance(accelG);
+}
+
+
+void
+UniformExcitation::setInfluence(Node *theNode)
+{
+    theNode->setNumColR(1);
+    const Vector &crds=theNode->getCrds();
+    int ndm = crds.Size();
+    
+    if (ndm == 1) {
+        theNode->setR(theDof, 0, fact);
+    }
+    else if (ndm == 2) {
+        if (theDof < 2) {
             theNode->setR(theDof, 0, fact);
         }
-        else if (ndm == 2) {
-            if (theDof < 2) {
-                theNode->setR(theDof, 0, fact);
-            }
-            else if (theDof == 2) {
-                double xCrd = crds(0);
-                double yCrd = crds(1);
-                theNode->setR(0, 0, -fact*yCrd);
-                theNode->setR(1, 0, fact*xCrd);
-                theNode->setR(2, 0, fact);
-            }
+        else if (theDof == 2) {
+            double xCrd = crds(0);
+            double yCrd = crds(1);
+            theNode->setR(0, 0, -fact*yCrd);
+            theNode->setR(1, 0, fact*xCrd);
+            theNode->setR(2, 0, fact);
         }
-        else if (ndm == 3) {
-            if (theDof < 3) {
-                theNode->setR(theDof, 0, fact);
-            }
-            else if (theDof == 3) {
-                double yCrd = crds(1);
-                double zCrd = crds(2);
-                theNode->setR(1, 0, -fact*zCrd);
-                theNode->setR(2, 0, fact*yCrd);
-                theNode->setR(3, 0, fact);
-            }
-            else if (theDof == 4) {
-                double xCrd = crds(0);
-                double zCrd = crds(2);
-                theNode->setR(0, 0, fact*zCrd);
-                theNode->setR(2, 0, -fact*xCrd);
-                theNode->setR(4, 0, fact);
-            }
-            else if (theDof == 5) {
-                double xCrd = crds(0);
-                double yCrd = crds(1);
-                theNode->setR(0, 0, -fact*yCrd);
-                theNode->setR(1, 0, fact*xCrd);
-                theNode->setR(5, 0, fact);
-            }
+    }
+    else if (ndm == 3) {
+        if (theDof < 3) {
+            theNode->setR(theDof, 0, fact);
+        }
+        else if (theDof == 3) {
+            double yCrd = crds(1);
+            double zCrd = crds(2);
+            theNode->setR(1, 0, -fact*zCrd);
+            theNode->setR(2, 0, fact*yCrd);
+            theNode->setR(3, 0, fact);
+        }
+        else if (theDof == 4) {
+            double xCrd = crds(0);
+            double zCrd = crds(2);
+            theNode->setR(0, 0, fact*zCrd);
+            theNode->setR(2, 0, -fact*xCrd);
+            theNode->setR(4, 0, fact);
+        }
+        else if (theDof == 5) {
+            double xCrd = crds(0);
+            double yCrd = crds(1);
+            theNode->setR(0, 0, -fact*yCrd);
+            theNode->setR(1, 0, fact*xCrd);
+            theNode->setR(5, 0, fact);
         }
     }
-    
-    this->EarthquakePattern::applyLoad(time);
-    
-    return;
+}
+
+
+int
+UniformExcitation::formEffectiveForces(Domain &theDomain)
+{
+    this->clearEffectiveForces();
+
+    int num = theDomain.getNumNodes();
+    if (num > 0) {
+        theNodes = new Node *[num];
+        theForces = new Vector *[num];
+        if (theNodes == 0 || theForces == 0) {
+            opserr << "UniformExcitation::formEffectiveForces() - out of memory\n";
+            this->clearEffectiveForces();
+        }
+    }
+
+    Vector unit(1);
+    unit(0) = 1.0;
+
+    NodeIter &theNodeIter = theDomain.getNodes();
+    Node *theNode;
+    while ((theNode = theNodeIter()) != 0) {
+        this->setInfluence(theNode);
+        if (theNodes == 0)
+            continue;
+
+        // M*R formed as Node::addInertiaLoadToUnbalance() forms it
+        int numDOF = theNode->getNumberDOF();
+        const Vector &r = theNode->getRV(unit);
+        Matrix R(numDOF, 1);
+        for (int j=0; j<numDOF; j++)
+            R(j, 0) = r(j);
+        Matrix MR(numDOF, 1);
+        MR.addMatrixProduct(0.0, theNode->getMass(), R, 1.0);
+
+        Vector *theForce = 0;
+        for (int j=0; j<numDOF; j++)
+            if (MR(j, 0) != 0.0) {
+                theForce = new Vector(numDOF);
+                for (int k=0; k<numDOF; k++)
+                    (*theForce)(k) = MR(k, 0);
+                break;
+            }
+
+        theNodes[numNodes] = theNode;
+        theForces[numNodes] = theForce;
+        numNodes++;
+    }
+
+    theDomain.setInfluenceSetter(this);
+    if (theNodes != 0 || num == 0)
+        lastStamp = theDomain.getDomainChangeStamp();
+
+    return (lastStamp < 0) ? -1 : 0;
+}
+
+
+void
+UniformExcitation::clearEffectiveForces(void)
+{
+    for (int i=0; i<numNodes; i++)
+        if (theForces[i] != 0)
+            delete theForces[i];
+
+    if (theNodes != 0)
+        delete [] theNodes;
+    if (theForces != 0)
+        delete [] theForces;
+
+    theNodes = 0;
+    theForces = 0;
+    numNodes = 0;
+    lastStamp = -1;
 }
 
 
@@ -358,6 +472,8 @@ UniformExcitation::applyLoadSensitivity(double time)
     }
 //  }
 
+  theDomain->setInfluenceSetter(0);
+
   this->EarthquakePattern::applyLoadSensitivity(time);
 
   return;
@@ -417,6 +533,7 @@ UniformExcitation::recvSelf(int commitTag, Channel &theChannel,
   theDof = int(data(1));
   vel0 = data(2);
   fact = data(5);
+  this->clearEffectiveForces();
   int motionClassTag = int(data(3));
   int motionDbTag = int(data(4));
 
@@ -37,6 +37,8 @@
 
 #include <EarthquakePattern.h>
 
+class Node;
+
 class UniformExcitation : public EarthquakePattern
 {
   public:
@@ -64,12 +66,24 @@ class UniformExcitation : public EarthquakePattern
     const GroundMotion *getGroundMotion(void);
     
  protected:
+    void addInertiaLoads(Domain &theDomain, const Vector &accelG);
     
  private:
+    void setInfluence(Node *theNode);
+    int formEffectiveForces(Domain &theDomain);
+    void clearEffectiveForces(void);
+
     GroundMotion *theMotion; // the ground motion
     int theDof;      // the dof corrseponding to the ground motion
     double vel0;     // the initial velocity, should be neg of ug dot(0)
     double fact;
+
+    // the effective force M*R of each node, formed once per domain change
+    // so a step only scales and adds them; 0 for nodes with no inertia load
+    Node **theNodes;
+    Vector **theForces;
+    int numNodes;
+    int lastStamp;   // domain change stamp the forces were formed for
 };
 
 #endif
@@ -117,6 +117,7 @@ class Vector
     friend class MPI_Channel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class SnapshotChannel;
     
   private:
     static double VECTOR_NOT_VALID_ENTRY;
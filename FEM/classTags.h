@@ -710,6 +710,7 @@
 #define ELE_TAG_EmbeddedBeamInterfaceP    183
 #define ELE_TAG_EmbeddedEPBeamInterface   184
 #define ELE_TAG_EmbeddedBeamInterface     185
+#define ELE_TAG_ShearColumnUP             186
 
 #define FRN_TAG_Coulomb            1
 #define FRN_TAG_VelDependent       2
@@ -989,6 +990,9 @@
 #define OPS_STREAM_TAGS_ChannelStream           9
 #define OPS_STREAM_TAGS_DataTurbineStream      10
 #define OPS_STREAM_TAGS_DataFileStreamAdd      11
+#define OPS_STREAM_TAGS_ProfileStream          12
+#define OPS_STREAM_TAGS_LiveFeedStream         13
+#define OPS_STREAM_TAGS_MemoryStream           14
 
 
 #define DomDecompALGORITHM_TAGS_DomainDecompAlgo 1
@@ -46,13 +46,16 @@
 #include "NodeIter.h"
 #include "ElementIter.h"
 #include "DataFileStream.h"
+#include "ProfileStream.h"
+#include "LiveFeedStream.h"
+#include "MemoryStream.h"
 #include "Recorder.h"
 #include "UniaxialMaterial.h"
 #include "ElementStateParameter.h"
 
 #include "SSPbrick.h"
 #include "SSPquad.h"
-#include "SSPquadUP.h"
+#include "ShearColumnUP.h"
 #include "Brick.h"
 #include "J2CyclicBoundingSurface.h"
 #include "ElasticIsotropicMaterial.h"
@@ -76,6 +79,11 @@
 #include "ViscousMaterial.h"
 #include "ZeroLength.h"
 #include "SingleDomParamIter.h"
+#include "SP_ConstraintIter.h"
+#include "MP_ConstraintIter.h"
+#include "ResultCache.h"
+#include "SnapshotChannel.h"
+#include "FEM_ObjectBroker.h"
 
 #include "Information.h"
 #include <vector> 
@@ -88,6 +96,7 @@
 using json = nlohmann::json;
 #include <exception>
 #include <cmath>
+#include <cstdio>
 
 
 
@@ -100,10 +109,31 @@ using json = nlohmann::json;
 #define PATH_SEPARATOR "/"
 #endif
 
+// the outputs of an analysis, kept in the result cache
+static const char *resultFileNames[] = {"surface.acc", "surface.vel", "surface.disp", "base.acc", "base.vel", "base.disp",
+	"pwpLiq.out", "displacement.out", "velocity.out", "acceleration.out", "porePressure.out", "displacement.prof",
+	"acceleration.prof", "stress.out", "strain.out", "stress.prof", "strain.prof"};
+static const int numResultFiles = sizeof(resultFileNames) / sizeof(resultFileNames[0]);
+
 SiteResponseModel::SiteResponseModel() : theModelType("2D"),
 										 theMotionX(0),
 										 theMotionZ(0),
-										 theOutputDir(".")
+										 theOutputDir("."),
+										 useSnapshot(true),
+										 checkpointInterval(0),
+										 resumeAnalysis(false),
+										 useLiveFeed(false),
+										 theCacheMaxBytes(0),
+										 theAlgorithm("Newton"),
+										 theGamma(0.5),
+										 theBeta(0.25),
+										 theTimeStep(0.001),
+										 theOutputCSV(0),
+										 theOutputPrecision(6),
+										 keepOutputsInMemory(false),
+										 theProgressCallback(NULL),
+										 theProgressData(NULL),
+										 theModelBuilt(false)
 {
 }
 
@@ -111,7 +141,22 @@ SiteResponseModel::SiteResponseModel(SiteLayering layering, std::string modelTyp
 																																	 theModelType(modelType),
 																																	 theMotionX(motionX),
 																																	 theMotionZ(motionY),
-																																	 theOutputDir(".")
+																																	 theOutputDir("."),
+																																	 useSnapshot(true),
+																																	 checkpointInterval(0),
+																																	 resumeAnalysis(false),
+																																	 useLiveFeed(false),
+																																	 theCacheMaxBytes(0),
+																																	 theAlgorithm("Newton"),
+																																	 theGamma(0.5),
+																																	 theBeta(0.25),
+																																	 theTimeStep(0.001),
+																																	 theOutputCSV(0),
+																																	 theOutputPrecision(6),
+																																	 keepOutputsInMemory(false),
+																																	 theProgressCallback(NULL),
+																																	 theProgressData(NULL),
+																																	 theModelBuilt(false)
 {
 	if (theMotionX->isInitialized() || theMotionZ->isInitialized())
 		theDomain = new Domain();
@@ -125,7 +170,22 @@ SiteResponseModel::SiteResponseModel(SiteLayering layering, std::string modelTyp
 SiteResponseModel::SiteResponseModel(SiteLayering layering, std::string modelType, OutcropMotion *motionX) : SRM_layering(layering),
 																											 theModelType(modelType),
 																											 theMotionX(motionX),
-																											 theOutputDir(".")
+																											 theOutputDir("."),
+																											 useSnapshot(true),
+																											 checkpointInterval(0),
+																											 resumeAnalysis(false),
+																											 useLiveFeed(false),
+																											 theCacheMaxBytes(0),
+																											 theAlgorithm("Newton"),
+																											 theGamma(0.5),
+																											 theBeta(0.25),
+																											 theTimeStep(0.001),
+																											 theOutputCSV(0),
+																											 theOutputPrecision(6),
+																											 keepOutputsInMemory(false),
+																											 theProgressCallback(NULL),
+																											 theProgressData(NULL),
+																											 theModelBuilt(false)
 {
 	if (theMotionX->isInitialized())
 		theDomain = new Domain();
@@ -138,7 +198,22 @@ SiteResponseModel::SiteResponseModel(SiteLayering layering, std::string modelTyp
 
 SiteResponseModel::SiteResponseModel(std::string modelType, OutcropMotion *motionX) : theModelType(modelType),
 																											 theMotionX(motionX),
-																											 theOutputDir(".")
+																											 theOutputDir("."),
+																											 useSnapshot(true),
+																											 checkpointInterval(0),
+																											 resumeAnalysis(false),
+																											 useLiveFeed(false),
+																											 theCacheMaxBytes(0),
+																											 theAlgorithm("Newton"),
+																											 theGamma(0.5),
+																											 theBeta(0.25),
+																											 theTimeStep(0.001),
+																											 theOutputCSV(0),
+																											 theOutputPrecision(6),
+																											 keepOutputsInMemory(false),
+																											 theProgressCallback(NULL),
+																											 theProgressData(NULL),
+																											 theModelBuilt(false)
 {
 	if (theMotionX->isInitialized())
 		theDomain = new Domain();
@@ -177,11 +252,51 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	// ------------------------------------------
 	//std::string configFile = "/Users/simcenter/Codes/SimCenter/SiteResponseTool/bin/SRT.json";
     //std::string configFile = "SRT.json";
-    std::ifstream i(theConfigFile);
-    if(!i)
-        return false;// failed to open SRT.json TODO: print to log
     json SRT;
-    i >> SRT;
+    if (!theConfigText.empty())
+        SRT = json::parse(theConfigText);
+    else
+    {
+        std::ifstream i(theConfigFile);
+        if(!i)
+        {
+            opserr << "Could not open the configuration file " << theConfigFile.c_str() << endln;
+            return -1;
+        }
+        i >> SRT;
+    }
+
+	// the outputs of the last build go with its recorders; a model kept in
+	// memory writes none of its other files
+	theOutputs.clear();
+	theProfiles.clear();
+	if (keepOutputsInMemory)
+	{
+		useSnapshot = false;
+		checkpointInterval = 0;
+		resumeAnalysis = false;
+		useLiveFeed = false;
+		theCacheDir = "";
+	}
+
+	// an analysis of the same configuration and motion run before left its
+	// outputs, with the tcl files, in the cache
+	std::vector<std::string> resultDirs;
+	resultDirs.push_back(theAnalysisDir);
+	resultDirs.push_back(theTclOutputDir);
+	resultDirs.push_back(theOutputDir);
+	unsigned long long resultKey = 0;
+	bool useResultCache = doAnalysis && !resumeAnalysis && !theCacheDir.empty();
+	if (useResultCache)
+	{
+		resultKey = ResultCache::makeKey(SRT, theMotionX, SRT_ENGINE_VERSION " " + this->getEngineSettings());
+		if (ResultCache(theCacheDir, theCacheMaxBytes).fetch(resultKey, resultDirs))
+		{
+			opserr << "Results of an identical analysis restored from " << theCacheDir.c_str() << endln;
+			opserr << "Site response analysis done..." << endln;
+			return 0;
+		}
+	}
 
 	// set outputs for tcl 
 	//ofstream s ("/Users/simcenter/Codes/SimCenter/SiteResponseTool/bin/model.tcl", std::ofstream::out);
@@ -190,9 +305,13 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	ofstream ns ("out_tcl/nodesInfo.dat", std::ofstream::out);
 	ofstream es ("out_tcl/elementInfo.dat", std::ofstream::out);
     */
-    ofstream s (theAnalysisDir + "/model.tcl", std::ofstream::out);//TODO: may not work on windows
-    ofstream ns (theTclOutputDir+"/nodesInfo.dat", std::ofstream::out);
-    ofstream es (theTclOutputDir+"/elementInfo.dat", std::ofstream::out);
+    ofstream s, ns, es;
+    if (!keepOutputsInMemory)
+    {
+        s.open(theAnalysisDir + "/model.tcl", std::ofstream::out);//TODO: may not work on windows
+        ns.open(theTclOutputDir+"/nodesInfo.dat", std::ofstream::out);
+        es.open(theTclOutputDir+"/elementInfo.dat", std::ofstream::out);
+    }
 	//ofstream s ("/Users/simcenter/Codes/SimCenter/build-SiteResponseTool-Desktop_Qt_5_11_1_clang_64bit-Debug/SiteResponseTool.app/Contents/MacOS/model.tcl", std::ofstream::out);
 	s << "# #########################################################" << "\n\n";
 	s << "wipe \n\n";
@@ -222,8 +341,8 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
             std::string err = "eSizeH is tool small. change it in the json file.";throw err;
         }
     }
-    catch (std::exception& e){std::cerr << "Standard exception: " << e.what() << std::endl;return false;}
-    catch(std::string str){std::cerr << str << std::endl;return false;}
+    catch (std::exception& e){std::cerr << "Standard exception: " << e.what() << std::endl;return -1;}
+    catch(std::string str){std::cerr << str << std::endl;return -1;}
 
 
 	std::vector<int> layerNumElems;
@@ -232,6 +351,12 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	std::vector<int> dryNodes;
 
 
+	// a model built before by this object is taken out of the domain, the
+	// whole model is built again
+	if (theModelBuilt)
+		this->clearModel();
+	theModelBuilt = true;
+
 	s << "# ------------------------------------------ \n";
 	s << "# 1. Build nodes and elements                \n";
 	s << "# ------------------------------------------ \n \n";
@@ -239,6 +364,9 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	Node *theNode;
 	NDMaterial *theMat;
 
+	// keep the nodes and elements in flat arrays in equation order for the time stepping loops
+	theDomain->setFlatStorage(true);
+
 	Element *theEle;
 	Parameter *theParameter;
 	char **paramArgs = new char *[2];
@@ -248,14 +376,19 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	std::map<int, int> matNumDict;
 	std::vector<int> soilMatTags;
 
+	// the soil column is a single line of nodes (ux, uy, p) joined by ShearColumnUP
+	// elements of width sElemX, so no periodic constraints are needed. The stock
+	// OpenSees that runs model.tcl has no ShearColumnUP, there the column is
+	// still the strip of SSPquadUP elements, node i of the column being the
+	// nodes 2i-1 and 2i of the strip tied by equalDOF; nodesInfo.dat and
+	// elementInfo.dat describe that strip
 	theNode = new Node(numNodes + 1, 3, 0.0, yCoord); theDomain->addNode(theNode);
-	theNode = new Node(numNodes + 2, 3, sElemX, yCoord); theDomain->addNode(theNode);
 	s << "model BasicBuilder -ndm 2 -ndf 3  \n\n";
-	s << "node " << numNodes + 1 << " 0.0 " << yCoord << endln;
-	s << "node " << numNodes + 2 << " " << sElemX << " " << yCoord << endln;
-	ns << numNodes + 1 << " 0.0 " << yCoord << endln;
-	ns << numNodes + 2 << " " << sElemX << " " << yCoord << endln;
-	numNodes += 2;			
+	s << "node " << 2 * numNodes + 1 << " 0.0 " << yCoord << endln;
+	s << "node " << 2 * numNodes + 2 << " " << sElemX << " " << yCoord << endln;
+	ns << 2 * numNodes + 1 << " 0.0 " << yCoord << endln;
+	ns << 2 * numNodes + 2 << " " << sElemX << " " << yCoord << endln;
+	numNodes += 1;			
 	json soilProfile,soilLayers,mats;
 	try
     {
@@ -304,7 +437,7 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 
 			
 			json mat = mats[matTag-1];
-			std::cout << "mat id:" << mat["id"] << " mat type" << mat["type"] << std::endl;
+			opserr << "mat id:" << mat["id"].dump().c_str() << " mat type" << mat["type"].dump().c_str() << endln;
 			std::string matType = mat["type"];
 			int trueMatId = mat["id"];
 			if(!matType.compare("Elastic"))
@@ -376,21 +509,19 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
                 yCoord += t ;
 				theNode = new Node(numNodes + 1, 3, 0.0, yCoord);
 				theDomain->addNode(theNode);
-				theNode = new Node(numNodes + 2, 3, sElemX, yCoord);
-				theDomain->addNode(theNode);
 
-				s << "node " << numNodes + 1 << " 0.0 " << yCoord << endln;
-				s << "node " << numNodes + 2 << " " << sElemX << " " << yCoord << endln;
-				ns << numNodes + 1 << " 0.0 " << yCoord << endln;
-				ns << numNodes + 2 << " " << sElemX << " " << yCoord << endln;
+				s << "node " << 2 * numNodes + 1 << " 0.0 " << yCoord << endln;
+				s << "node " << 2 * numNodes + 2 << " " << sElemX << " " << yCoord << endln;
+				ns << 2 * numNodes + 1 << " 0.0 " << yCoord << endln;
+				ns << 2 * numNodes + 2 << " " << sElemX << " " << yCoord << endln;
 
-				theEle = new SSPquadUP(numElems + 1, numNodes - 1, numNodes, numNodes + 2, numNodes + 1,
-									   *theMat, 1.0, uBulk, 1.0, 1.0, 1.0, evoid, 0.0, 0.0, g * 1.0); // -9.81 * theMat->getRho() TODO: theMat->getRho()
+				theEle = new ShearColumnUP(numElems + 1, numNodes, numNodes + 1,
+									   *theMat, sElemX, 1.0, uBulk, 1.0, 1.0, 1.0, evoid, 0.0, 0.0, g * 1.0); // -9.81 * theMat->getRho() TODO: theMat->getRho()
 				
 				s << "element SSPquadUP "<<numElems + 1<<" " 
-					<<numNodes - 1 <<" "<<numNodes<<" "<< numNodes + 2<<" "<< numNodes + 1<<" "
+					<<2 * numNodes - 1 <<" "<<2 * numNodes<<" "<< 2 * numNodes + 2<<" "<< 2 * numNodes + 1<<" "
 					<< theMat->getTag() << " " << "1.0 "<<uBulk<<" 1.0 1.0 1.0 " <<evoid << " 0.0 0.0 "<< g * 1.0 << endln;
-				es << numElems + 1<<" " <<numNodes - 1 <<" "<<numNodes<<" "<< numNodes + 2<<" "<< numNodes + 1<<" "
+				es << numElems + 1<<" " <<2 * numNodes - 1 <<" "<<2 * numNodes<<" "<< 2 * numNodes + 2<<" "<< 2 * numNodes + 1<<" "
 					<< theMat->getTag() << endln;
 
 				theDomain->addElement(theEle);
@@ -407,16 +538,15 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
                 if (yCoord >= (totalHeight - groundWaterTable))
 				{ 	//record dry nodes above ground water table
 					dryNodes.push_back(numNodes + 1);
-					dryNodes.push_back(numNodes + 2);
 				}
-                numNodes += 2;
+                numNodes += 1;
 				numElems += 1;
             }
-            std::cout << "layer tag: " << lTag << std::endl;
+            opserr << "layer tag: " << lTag << endln;
         }
     }
-    catch (std::exception& e){std::cerr << "Standard exception: " << e.what() << std::endl;return false;}
-    catch(std::string str){std::cerr << str << std::endl;return false;}
+    catch (std::exception& e){std::cerr << "Standard exception: " << e.what() << std::endl;return -1;}
+    catch(std::string str){std::cerr << str << std::endl;return -1;}
 	s << "\n\n";
 
 
@@ -426,7 +556,7 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 
 	s << "# 2.1 Apply fixities at base              \n\n";
 	SP_Constraint *theSP;
-	int sizeTheSPtoRemove = 2 ; // for 3D it's 8;
+	int sizeTheSPtoRemove = 1 ; // for 3D it's 4;
 	ID theSPtoRemove(sizeTheSPtoRemove); // these fixities should be removed later on if compliant base is used
 
 	theSP = new SP_Constraint(1, 0, 0.0, true);
@@ -436,43 +566,24 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	theDomain->addSP_Constraint(theSP);
 
 	s << "fix 1 1 1 0" << endln;
-
-	theSP = new SP_Constraint(2, 0, 0.0, true);
-	theDomain->addSP_Constraint(theSP);
-	theSPtoRemove(1) = theSP->getTag();
-	theSP = new SP_Constraint(2, 1, 0.0, true);
-	theDomain->addSP_Constraint(theSP);
-
 	s << "fix 2 1 1 0" << endln << endln;
 
 
 
 	s << "# 2.2 Apply periodic boundary conditions    \n\n";
-	MP_Constraint *theMP;
-	int crrdim = 2 ;//For 3D it's 3;
-	Matrix Ccr(crrdim, crrdim);
-	ID rcDOF(crrdim);
-	// TODO: get clarified about the dimensions of Crr and rfDOF
-	Ccr(0, 0) = 1.0;
-	Ccr(1, 1) = 1.0; 
-	rcDOF(0) = 0;
-	rcDOF(1) = 1; 
-	for (int nodeCount = 2; nodeCount < numNodes; nodeCount += 2)
-	{
-		theMP = new MP_Constraint(nodeCount + 1, nodeCount + 2, Ccr, rcDOF, rcDOF);
-		theDomain->addMP_Constraint(theMP);
-		s << "equalDOF " << nodeCount + 1 << " "<< nodeCount + 2 << " 1 2" << endln;
-	}
+	for (int nodeCount = 2; nodeCount <= numNodes; nodeCount++)
+		s << "equalDOF " << 2 * nodeCount - 1 << " "<< 2 * nodeCount << " 1 2" << endln;
 	s << "\n\n";
 
 
 
 	s << "# 2.3 Apply pore pressure boundaries for nodes above water table. \n\n";
-	for (int i = 0; i < dryNodes.size(); i++)
+	for (size_t i = 0; i < dryNodes.size(); i++)
 	{
 		theSP = new SP_Constraint(dryNodes[i], 2, 0.0, true);
 		theDomain->addSP_Constraint(theSP);
-		s << "fix " << dryNodes[i] << " 0 0 1" << endln;
+		s << "fix " << 2 * dryNodes[i] - 1 << " 0 0 1" << endln;
+		s << "fix " << 2 * dryNodes[i] << " 0 0 1" << endln;
 	}
 	s << "\n\n";
 
@@ -491,13 +602,12 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	}
 	s << endln;
 
-	for (int i=0; i != soilMatTags.size(); i++)
+	for (size_t i=0; i != soilMatTags.size(); i++)
 		s << "updateMaterialStage -material "<< soilMatTags[i] <<" -stage 0" << endln << endln ; 
 
 
 
 	// create the output streams
-	OPS_Stream *theOutputStream;
 	Recorder *theRecorder;
 
 	// record last node's results
@@ -553,10 +663,30 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 
 	//StaticAnalysis *theAnalysis; // *
 	//theAnalysis = new StaticAnalysis(*theDomain, *theHandler, *theNumberer, *theModel, *theSolnAlgo, *theSOE, *theIntegrator); // *
-	theAnalysis->setConvergenceTest(*theTest);
+	// the analysis already has theTest, setting it again would delete it
+
+	// the state after the gravity stages depends only on the profile. It is
+	// kept in a snapshot stamped with a hash of the model before gravity, and
+	// a later model whose hash matches restores it instead of analyzing again
+	SnapshotChannel theSnapshot;
+	std::string snapshotFile;
+	unsigned long long snapshotKey = 0;
+	double snapshotTime = 0.0;
+	bool restoreGravity = false;
+	if (doAnalysis && useSnapshot)
+	{
+		snapshotFile = theSnapshotFile.empty() ? theAnalysisDir + PATH_SEPARATOR + "gravity.snapshot" : theSnapshotFile;
+		if (this->sendModelState(theSnapshot, true) == 0)
+		{
+			snapshotKey = theSnapshot.getHash();
+			unsigned long long savedKey;
+			restoreGravity = (theSnapshot.load(snapshotFile.c_str(), savedKey, snapshotTime) == 0) && (savedKey == snapshotKey);
+		}
+	}
 
-	int converged;
-	if(doAnalysis)
+	// 0 only once both gravity stages have run and converged
+	int converged = -1;
+	if(doAnalysis && !restoreGravity)
 	{
 	converged = theAnalysis->analyze(10,1.0); 
 	if (!converged)
@@ -583,7 +713,7 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	}
 	s << endln;
 
-	for (int i=0; i != soilMatTags.size(); i++)
+	for (size_t i=0; i != soilMatTags.size(); i++)
 		s << "updateMaterialStage -material "<< soilMatTags[i] <<" -stage 1" << endln ; 
 
 	// add parameters: FirstCall for plastic gravity analysis
@@ -636,16 +766,20 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 
 	if(doAnalysis)
 	{
-	converged = theAnalysis->analyze(10,1.0); 
 	s << "analyze     10 1.0" << endln;
-	if (!converged)
+	if (!restoreGravity)
+	{
+	int plasticConverged = theAnalysis->analyze(10,1.0); 
+	if (!plasticConverged)
 	{
 		opserr << "Converged at time " << theDomain->getCurrentTime() << endln;
 	} else
 	{
 		opserr << "Didn't converge at time " << theDomain->getCurrentTime() << endln;
+		converged = plasticConverged;
 	}
 	opserr << "Finished with plastic gravity analysis..." endln;
+	}
 	s << "puts \"Finished with plastic gravity analysis...\"" << endln << endln;
 	}
 	
@@ -703,6 +837,25 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	}
 	s << endln << endln << endln;
 
+	// put back the state kept by an earlier model, or keep this one
+	if (restoreGravity)
+	{
+		FEM_ObjectBroker theBroker;
+		theSnapshot.rewind();
+		if (this->recvModelState(theSnapshot, theBroker) != 0)
+		{
+			opserr << "Could not restore the gravity state from " << snapshotFile.c_str() << endln;
+			return -1;
+		}
+		theDomain->setCommittedTime(snapshotTime);
+		opserr << "Restored the gravity state from " << snapshotFile.c_str() << endln << endln;
+	} else if (doAnalysis && useSnapshot && (converged == 0))
+	{
+		theSnapshot.clear();
+		if (this->sendModelState(theSnapshot, false) == 0)
+			theSnapshot.save(snapshotFile.c_str(), snapshotKey, theDomain->getCurrentTime());
+	}
+
 
 
 
@@ -749,19 +902,19 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	theDomain->addNode(theNode); // TODO ?
 
 	s << "model BasicBuilder -ndm 2 -ndf 2" << endln << endln; 
-	s << "node " << numNodes + 1 << " 0.0 0.0" << endln;
-	s << "node " << numNodes + 2 << " 0.0 0.0" << endln;
+	s << "node " << 2 * numNodes + 1 << " 0.0 0.0" << endln;
+	s << "node " << 2 * numNodes + 2 << " 0.0 0.0" << endln;
 	
 
 	theSP = new SP_Constraint(numNodes + 1, 0, 0.0, true);
 	theDomain->addSP_Constraint(theSP);
 	theSP = new SP_Constraint(numNodes + 1, 1, 0.0, true);
 	theDomain->addSP_Constraint(theSP);
-	s << "fix " << numNodes + 1 << " 1 1" << endln;
+	s << "fix " << 2 * numNodes + 1 << " 1 1" << endln;
 
 	theSP = new SP_Constraint(numNodes + 2, 1, 0.0, true);
 	theDomain->addSP_Constraint(theSP);
-	s << "fix " << numNodes + 2 << " 0 1" << endln;
+	s << "fix " << 2 * numNodes + 2 << " 0 1" << endln;
 	s << endln;
 
 
@@ -769,13 +922,14 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	s << "# 4.3 Apply equalDOF to the node connected to the column. \n\n";
 
 	int numConn = 1; // for 3D it's 2 
+	MP_Constraint *theMP;
 	Matrix Ccrconn(numConn, numConn);
 	ID rcDOFconn(numConn);
 	Ccrconn(0, 0) = 1.0;
 	rcDOFconn(0) = 0;
 	theMP = new MP_Constraint(1, numNodes + 2, Ccrconn, rcDOFconn, rcDOFconn);
 	theDomain->addMP_Constraint(theMP); //TODO
-	s << "equalDOF " << 1 << " "<< numNodes + 2 << " 1" << endln;
+	s << "equalDOF " << 1 << " "<< 2 * numNodes + 2 << " 1" << endln;
 	
 
 
@@ -792,19 +946,11 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	s << "remove sp 2 1" << endln;
 
 
+
 	s << "# 4.5 Apply equalDOF for the first 4 nodes (3D) or 2 nodes (2D). \n\n";
 
-	int numMP1 = 1;// for 3D it's 2
-	Matrix constrainInXZ(numMP1, numMP1);
-	ID constDOF(numMP1);
 	if (!theModelType.compare("2D")) //2D
-	{
-		constrainInXZ(0, 0) = 1.0;
-		constDOF(0) = 0;
-		theMP = new MP_Constraint(1, 2, constrainInXZ, constDOF, constDOF);
-		theDomain->addMP_Constraint(theMP);
 		s << "equalDOF " << 1 << " "<< 2 << " 1 " << endln;
-	}
 
 
 
@@ -825,7 +971,7 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	//element zeroLength [expr $nElemT+1]  $dashF $dashS -mat [expr $numLayers+1]  -dir 1
 	theEle = new ZeroLength(numElems + 1, 2, numNodes + 1, numNodes + 2, x, y, 1, theViscousMats, directions); //TODO ?
 	theDomain->addElement(theEle);
-	s << "element zeroLength "<<numElems + 1 <<" "<< numNodes + 1 <<" "<< numNodes + 2<<" -mat "<<dashMatTag<<"  -dir 1" << endln;
+	s << "element zeroLength "<<numElems + 1 <<" "<< 2 * numNodes + 1 <<" "<< 2 * numNodes + 2<<" -mat "<<dashMatTag<<"  -dir 1" << endln;
 	s << "\n\n\n";
 	
 
@@ -865,7 +1011,7 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	std::vector<double> dt;
 
 
-    double dT = 0.001; // This is the time step in solution
+    double dT = theTimeStep; // This is the time step in solution
     double motionDT = theMotionX->getDt();//  0.005; // This is the time step in the motion record. TODO: use a funciton to get it
     int nSteps = theMotionX->getNumSteps();//1998;//theMotionX->getNumSteps() ; //1998; // number of motions in the record. TODO: use a funciton to get it
 	int remStep = nSteps * motionDT / dT;
@@ -877,8 +1023,14 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
     // using a stress input with the dashpot
 	if (theMotionX->isInitialized())
 	{
+		if (theMotionX->getVelSeries() == NULL)
+		{
+			opserr << "The rock motion has no velocity to load the dashpot with." << endln;
+			return -1;
+		}
 		LoadPattern *theLP = new LoadPattern(1, vis_C);
-        theLP->setTimeSeries(theMotionX->getVelSeries());
+        // the pattern owns its series, the motion keeps its own for the next model
+        theLP->setTimeSeries(theMotionX->getVelSeries()->getCopy());
 
 		NodalLoad *theLoad;
 		int numLoads = 3; // for 3D it's 4
@@ -920,7 +1072,7 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 
 	s << "constraints Transformation" << endln; 
 	s << "test NormDispIncr 1.0e-4 35 0" << endln; // TODO
-	s << "algorithm   Newton" << endln;
+	s << "algorithm   Newton" << (theAlgorithm == "NewtonInitial" ? " -initial" : "") << endln;
 	s << "numberer    RCM" << endln;
 	s << "system BandGeneral" << endln;
 
@@ -931,7 +1083,7 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	// create analysis objects - I use static analysis for gravity
 	theModel = new AnalysisModel();
 	theTest = new CTestNormDispIncr(1.0e-4, 35, 1);                    // 2. test NormDispIncr 1.0e-7 30 1
-	theSolnAlgo = new NewtonRaphson(*theTest);                              // 3. algorithm   Newton (TODO: another option: KrylovNewton) 
+	theSolnAlgo = new NewtonRaphson(*theTest, theAlgorithm == "NewtonInitial" ? INITIAL_TANGENT : CURRENT_TANGENT); // 3. algorithm   Newton (TODO: another option: KrylovNewton) 
 	//StaticIntegrator *theIntegrator = new LoadControl(0.05, 1, 0.05, 1.0); // *
 	//ConstraintHandler *theHandler = new TransformationConstraintHandler(); // *
 	//TransientIntegrator* theIntegrator = new Newmark(5./6., 4./9.);// * Newmark(0.5, 0.25) // 6. integrator  Newmark $gamma $beta
@@ -954,8 +1106,8 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 
 
 
-	double gamma_dynm = 0.5;
-	double beta_dynm = 0.25;
+	double gamma_dynm = theGamma;
+	double beta_dynm = theBeta;
 	TransientIntegrator* theTransientIntegrator = new Newmark(gamma_dynm, beta_dynm);// * Newmark(0.5, 0.25) // 6. integrator  Newmark $gamma $beta
 	//theTransientIntegrator->setConvergenceTest(*theTest);
 
@@ -1002,13 +1154,13 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	//s << "analysis Transient" << endln << endln;
 	s << "analysis Transient" << endln << endln;
 	
-	// count quad elements
+	// count soil column elements
 	ElementIter &theElementIterh = theDomain->getElements();
 	std::vector<int> quadElem;
 	while ((theEle = theElementIterh()) != 0)
 	{
 		int theEleTag = theEle->getTag();
-		if (theEle->getNumDOF() == 12) // quad ele
+		if (theEle->getClassTag() == ELE_TAG_ShearColumnUP) // soil ele
 			quadElem.push_back(theEleTag);
 	}
 	int numQuadEles = quadElem.size();
@@ -1019,25 +1171,38 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	s << "# ------------------------------------------------------------\n\n";
 
 
+	// the recorders and their files, kept for the checkpoints
+	std::vector<Recorder *> recorders;
+	std::vector<DataFileStream *> dataStreams;
+	std::string outFile;
+
 	// Record the response at the surface
-	std::string outFile = theOutputDir + PATH_SEPARATOR + "surface.acc";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "accel", *theDomain, *theOutputStream, motionDT, true, NULL);
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "accel", *theDomain, *this->openOutput("surface.acc", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
-	outFile = theOutputDir + PATH_SEPARATOR + "surface.vel";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "vel", *theDomain, *theOutputStream, motionDT, true, NULL);
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "vel", *theDomain, *this->openOutput("surface.vel", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
-	outFile = theOutputDir + PATH_SEPARATOR + "surface.disp";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "disp", *theDomain, *theOutputStream, motionDT, true, NULL);
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "disp", *theDomain, *this->openOutput("surface.disp", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
-	s<< "eval \"recorder Node -file out_tcl/surface.disp -time -dT $motionDT -node "<<numNodes<<" -dof 1 2 3  disp\""<<endln;// 1 2
-	s<< "eval \"recorder Node -file out_tcl/surface.acc -time -dT $motionDT -node "<<numNodes<<" -dof 1 2 3  accel\""<<endln;// 1 2
-	s<< "eval \"recorder Node -file out_tcl/surface.vel -time -dT $motionDT -node "<<numNodes<<" -dof 1 2 3 vel\""<<endln;// 3
+	// the live feeds are not part of the checkpoints, a resumed analysis
+	// starts them again
+	std::vector<LiveFeedStream *> liveFeeds;
+	if (useLiveFeed)
+	{
+		outFile = theOutputDir + PATH_SEPARATOR + "surface.live";
+		liveFeeds.push_back(new LiveFeedStream(outFile.c_str()));
+		theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "accel", *theDomain, *liveFeeds.back(), motionDT, true, NULL);
+		theDomain->addRecorder(*theRecorder);
+	}
+
+	s<< "eval \"recorder Node -file out_tcl/surface.disp -time -dT $motionDT -node "<<2 * numNodes<<" -dof 1 2 3  disp\""<<endln;// 1 2
+	s<< "eval \"recorder Node -file out_tcl/surface.acc -time -dT $motionDT -node "<<2 * numNodes<<" -dof 1 2 3  accel\""<<endln;// 1 2
+	s<< "eval \"recorder Node -file out_tcl/surface.vel -time -dT $motionDT -node "<<2 * numNodes<<" -dof 1 2 3 vel\""<<endln;// 3
 
 
 	
@@ -1048,34 +1213,30 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	dofToRecord.resize(1);
 	dofToRecord(0) = 0; // only record the x dof
 
-	outFile = theOutputDir + PATH_SEPARATOR + "base.acc";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "accel", *theDomain, *theOutputStream, motionDT, true, NULL);
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "accel", *theDomain, *this->openOutput("base.acc", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
-	outFile = theOutputDir + PATH_SEPARATOR + "base.vel";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "vel", *theDomain, *theOutputStream, motionDT, true, NULL);
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "vel", *theDomain, *this->openOutput("base.vel", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
-	outFile = theOutputDir + PATH_SEPARATOR + "base.disp";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "disp", *theDomain, *theOutputStream, motionDT, true, NULL);
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "disp", *theDomain, *this->openOutput("base.disp", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
 	s<< "eval \"recorder Node -file out_tcl/base.disp -time -dT $motionDT -node 1 -dof 1 2 3  disp\""<<endln;// 1 2
 	s<< "eval \"recorder Node -file out_tcl/base.acc -time -dT $motionDT -node 1 -dof 1 2 3  accel\""<<endln;// 1 2
 	s<< "eval \"recorder Node -file out_tcl/base.vel -time -dT $motionDT -node 1 -dof 1 2 3 vel\""<<endln;// 3
 
-	// Record pwp at node 17
+	// Record pwp at node 9 (the 9th node from the base), node 17 of the strip
 	dofToRecord.resize(1);
 	dofToRecord(0) = 2; // only record the pore pressure dof
 	ID pwpNodesToRecord(1);
-	pwpNodesToRecord(0) = 17;
-	outFile = theOutputDir + PATH_SEPARATOR + "pwpLiq.out";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &pwpNodesToRecord, 0, "vel", *theDomain, *theOutputStream, motionDT, true, NULL);
+	pwpNodesToRecord(0) = 9;
+	theRecorder = new NodeRecorder(dofToRecord, &pwpNodesToRecord, 0, "vel", *theDomain, *this->openOutput("pwpLiq.out", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
 	s<< "eval \"recorder Node -file out_tcl/pwpLiq.out -time -dT $motionDT -node 17 -dof 3 vel\""<<endln;
 
@@ -1083,55 +1244,79 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	// Record the response of all nodes
 	nodesToRecord.resize(numNodes);
 	for (int i=0;i<numNodes;i++)
-		nodesToRecord(i) = i;
+		nodesToRecord(i) = i + 1;
 	dofToRecord.resize(2);
 	dofToRecord(0) = 0;
 	dofToRecord(1) = 1;
 
-	outFile = theOutputDir + PATH_SEPARATOR + "displacement.out";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "disp", *theDomain, *theOutputStream, motionDT, true, NULL);
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "disp", *theDomain, *this->openOutput("displacement.out", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
-	outFile = theOutputDir + PATH_SEPARATOR + "velocity.out";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "vel", *theDomain, *theOutputStream, motionDT, true, NULL);
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "vel", *theDomain, *this->openOutput("velocity.out", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
-	outFile = theOutputDir + PATH_SEPARATOR + "acceleration.out";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "accel", *theDomain, *theOutputStream, motionDT, true, NULL);
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "accel", *theDomain, *this->openOutput("acceleration.out", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
 	dofToRecord.resize(1);
 	dofToRecord(0) = 2;
-	outFile = theOutputDir + PATH_SEPARATOR + "porePressure.out";
-	theOutputStream = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "vel", *theDomain, *theOutputStream, motionDT, true, NULL);
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "vel", *theDomain, *this->openOutput("porePressure.out", dataStreams), motionDT, true, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
-	s<< "eval \"recorder Node -file out_tcl/displacement.out -time -dT $motionDT -nodeRange 1 "<<numNodes<<" -dof 1 2  disp\""<<endln;
-	s<< "eval \"recorder Node -file out_tcl/velocity.out -time -dT $motionDT -nodeRange 1 "<<numNodes<<" -dof 1 2  vel\""<<endln;
-	s<< "eval \"recorder Node -file out_tcl/acceleration.out -time -dT $motionDT -nodeRange 1 "<<numNodes<<" -dof 1 2  accel\""<<endln;
-	s<< "eval \"recorder Node -file out_tcl/porePressure.out -time -dT $motionDT -nodeRange 1 "<<numNodes<<" -dof 3 vel\""<<endln;
+	// envelopes of the nodal response, reduced as the analysis runs
+	std::vector<ProfileStream *> profileStreams;
+	dofToRecord.resize(2);
+	dofToRecord(0) = 0;
+	dofToRecord(1) = 1;
+
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "disp", *theDomain, *this->openProfile("displacement.prof", profileStreams), motionDT, true, NULL);
+	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
+
+	theRecorder = new NodeRecorder(dofToRecord, &nodesToRecord, 0, "accel", *theDomain, *this->openProfile("acceleration.prof", profileStreams), motionDT, true, NULL);
+	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
+
+	s<< "eval \"recorder Node -file out_tcl/displacement.out -time -dT $motionDT -nodeRange 1 "<<2 * numNodes<<" -dof 1 2  disp\""<<endln;
+	s<< "eval \"recorder Node -file out_tcl/velocity.out -time -dT $motionDT -nodeRange 1 "<<2 * numNodes<<" -dof 1 2  vel\""<<endln;
+	s<< "eval \"recorder Node -file out_tcl/acceleration.out -time -dT $motionDT -nodeRange 1 "<<2 * numNodes<<" -dof 1 2  accel\""<<endln;
+	s<< "eval \"recorder Node -file out_tcl/porePressure.out -time -dT $motionDT -nodeRange 1 "<<2 * numNodes<<" -dof 3 vel\""<<endln;
 
 	
 	// Record element results
-	OPS_Stream* theOutputStream2;
 	ID elemsToRecord(quadElem.size());
-	for (int i=0;i<quadElem.size();i+=1)
+	for (size_t i=0;i<quadElem.size();i+=1)
 		elemsToRecord(i) = quadElem[i];
 	const char* eleArgs = "stress";
-	outFile = theOutputDir + PATH_SEPARATOR + "stress.out";
-	theOutputStream2 = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new ElementRecorder(&elemsToRecord, &eleArgs, 1, true, *theDomain, *theOutputStream2, motionDT, NULL);
+	theRecorder = new ElementRecorder(&elemsToRecord, &eleArgs, 1, true, *theDomain, *this->openOutput("stress.out", dataStreams), motionDT, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
+
+	if (useLiveFeed)
+	{
+		outFile = theOutputDir + PATH_SEPARATOR + "stress.live";
+		liveFeeds.push_back(new LiveFeedStream(outFile.c_str()));
+		theRecorder = new ElementRecorder(&elemsToRecord, &eleArgs, 1, true, *theDomain, *liveFeeds.back(), motionDT, NULL);
+		theDomain->addRecorder(*theRecorder);
+	}
 
 	const char* eleArgsStrain = "strain";
-	outFile = theOutputDir + PATH_SEPARATOR + "strain.out";
-	theOutputStream2 = new DataFileStream(outFile.c_str(), OVERWRITE, 2, 0, false, 6, false);
-	theRecorder = new ElementRecorder(&elemsToRecord, &eleArgsStrain, 1, true, *theDomain, *theOutputStream2, motionDT, NULL);
+	theRecorder = new ElementRecorder(&elemsToRecord, &eleArgsStrain, 1, true, *theDomain, *this->openOutput("strain.out", dataStreams), motionDT, NULL);
+	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
+
+	// envelopes of the element response, max shear strain and ru
+	theRecorder = new ElementRecorder(&elemsToRecord, &eleArgs, 1, true, *theDomain, *this->openProfile("stress.prof", profileStreams), motionDT, NULL);
+	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
+
+	theRecorder = new ElementRecorder(&elemsToRecord, &eleArgsStrain, 1, true, *theDomain, *this->openProfile("strain.prof", profileStreams), motionDT, NULL);
 	theDomain->addRecorder(*theRecorder);
+	recorders.push_back(theRecorder);
 
 	s<< "recorder Element -file out_tcl/stress.out -time -dT $motionDT  -eleRange 1 "<<numQuadEles<<"  stress 3"<<endln;
 	s<< "recorder Element -file out_tcl/strain.out -time -dT $motionDT  -eleRange 1 "<<numQuadEles<<"  strain"<<endln;
@@ -1241,23 +1426,53 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 	if(doAnalysis)
 	{
 
-	double totalTime = dT * nSteps;
-	int success = 0;
+	// carry on from the last checkpoint if asked to
+	std::string checkpointFile = theCheckpointFile.empty() ? theOutputDir + PATH_SEPARATOR + "analysis.checkpoint" : theCheckpointFile;
+	int firstStep = 0;
+	if (resumeAnalysis)
+	{
+		firstStep = this->loadCheckpoint(checkpointFile, remStep, recorders, dataStreams, profileStreams);
+		if (firstStep == -1)
+		{
+			opserr << "No checkpoint to resume from in " << checkpointFile.c_str() << ", starting from the beginning." << endln;
+			firstStep = 0;
+		} else if (firstStep < 0)
+		{
+			opserr << "Could not resume the analysis from " << checkpointFile.c_str() << endln;
+			return -1;
+		} else
+			opserr << "Resuming the analysis from step " << firstStep << " at time " << theDomain->getCurrentTime() << endln;
+	}
+
+	double endTime = theDomain->getCurrentTime() + (remStep - firstStep) * dT;
+	for (size_t i = 0; i < liveFeeds.size(); i++)
+		liveFeeds[i]->setEndTime(endTime);
 
 	opserr << "Analysis started:" << endln;
 	std::stringstream progressBar;
-	for (int analysisCount = 0; analysisCount < remStep; ++analysisCount)
+	bool aborted = false;
+	bool failed = false;
+	for (int analysisCount = firstStep; analysisCount < remStep; ++analysisCount)
 	{
+		if ((!liveFeeds.empty() && liveFeeds[0]->abortRequested()) ||
+			((theProgressCallback != NULL) && (theProgressCallback(analysisCount, remStep, theDomain->getCurrentTime(), theProgressData) != 0)))
+		{
+			opserr << "Site response analysis aborted at time " << theDomain->getCurrentTime() << endln;
+			aborted = true;
+			break;
+		}
+
 		//int converged = theAnalysis->analyze(1, 0.01, 0.005, 0.02, 1);
-		double stepDT = dt[analysisCount];
-		//int converged = theTransientAnalysis->analyze(1, stepDT, stepDT / 2.0, stepDT * 2.0, 1); // *
 		//int converged = theTransientAnalysis->analyze(1, 0.01, 0.005, 0.02, 1);
 		int converged = theTransientAnalysis->analyze(1, dT);
 		if (!converged)
 		{
 			opserr << "Converged at time " << theDomain->getCurrentTime() << endln;
 
-			if (analysisCount % (int)(remStep / 20) == 0)
+			if ((checkpointInterval > 0) && ((analysisCount + 1) % checkpointInterval == 0) && (analysisCount + 1 < remStep))
+				this->saveCheckpoint(checkpointFile, analysisCount + 1, remStep, recorders, dataStreams, profileStreams);
+
+			if ((remStep < 20) || (analysisCount % (remStep / 20) == 0))
 			{
 				progressBar << "\r[";
 				for (int ii = 0; ii < ((int)(20 * analysisCount / remStep)-1); ii++)
@@ -1274,9 +1489,48 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 		else
 		{
 			opserr << "Site response analysis did not converge." << endln;
-			exit(-1);
+			failed = true;
+			break;
 		}
 	}
+	// closing a stream waits for its rows still queued for the writer thread
+	for (size_t i = 0; i < dataStreams.size(); i++)
+		dataStreams[i]->close();
+	// write out the envelopes
+	for (size_t i = 0; i < profileStreams.size(); i++)
+		profileStreams[i]->close();
+	for (size_t i = 0; i < liveFeeds.size(); i++)
+	{
+		liveFeeds[i]->setStatus(failed ? LiveFeedStream::Failed : (aborted ? LiveFeedStream::Aborted : LiveFeedStream::Finished));
+		liveFeeds[i]->close();
+	}
+	if (failed)
+		return -1;
+	// an aborted analysis keeps its last checkpoint to be resumed from
+	if (aborted)
+		return -2;
+	// the analysis is done, there is nothing left to resume
+	if ((checkpointInterval > 0) || resumeAnalysis)
+		remove(checkpointFile.c_str());
+	if (useResultCache)
+	{
+		s.close();
+		ns.close();
+		es.close();
+		std::vector<ResultCache::File> resultFiles;
+		ResultCache::File f;
+		f.dir = 0; f.name = "model.tcl"; resultFiles.push_back(f);
+		f.dir = 1; f.name = "nodesInfo.dat"; resultFiles.push_back(f);
+		f.name = "elementInfo.dat"; resultFiles.push_back(f);
+		f.dir = 2;
+		for (int i = 0; i < numResultFiles; i++)
+		{
+			f.name = resultFileNames[i];
+			resultFiles.push_back(f);
+		}
+		if (!ResultCache(theCacheDir, theCacheMaxBytes).store(resultKey, resultDirs, resultFiles))
+			opserr << "Could not keep the results in " << theCacheDir.c_str() << endln;
+	}
 	opserr << "Site response analysis done..." << endln;
 	progressBar << "\r[";
 	for (int ii = 0; ii < 20; ii++)
@@ -1297,11 +1551,196 @@ int SiteResponseModel::buildEffectiveStressModel2D(bool doAnalysis)
 
 
 
+// takes out of the domain and the material lists what
+// buildEffectiveStressModel2D() put in
+int SiteResponseModel::clearModel()
+{
+	theDomain->clearAll();
+	OPS_clearAllNDMaterial();
+	OPS_clearAllUniaxialMaterial();
+	return 0;
+}
+
+// sends the state of the nodes and elements, and if asked the fixities and
+// equal dofs, in the order recvModelState() expects it
+int SiteResponseModel::sendModelState(Channel &theChannel, bool withConstraints)
+{
+	// changing what is kept makes the snapshots of earlier versions unusable
+	static Vector version(1);
+	version(0) = 1.0;
+	if (theChannel.sendVector(0, 0, version) < 0)
+		return -1;
+
+	Node *theNode;
+	NodeIter &theNodeIter = theDomain->getNodes();
+	while ((theNode = theNodeIter()) != 0)
+		if (theNode->sendSelf(0, theChannel) < 0)
+			return -1;
+
+	Element *theEle;
+	ElementIter &theEleIter = theDomain->getElements();
+	while ((theEle = theEleIter()) != 0)
+		if (theEle->sendSelf(0, theChannel) < 0)
+			return -1;
+
+	if (!withConstraints)
+		return 0;
+
+	// the constraints are sent without their tags, which depend on how many
+	// were created before them
+	static Vector spData(3);
+	SP_Constraint *theSP;
+	SP_ConstraintIter &theSPIter = theDomain->getSPs();
+	while ((theSP = theSPIter()) != 0)
+	{
+		spData(0) = theSP->getNodeTag();
+		spData(1) = theSP->getDOF_Number();
+		spData(2) = theSP->getValue();
+		if (theChannel.sendVector(0, 0, spData) < 0)
+			return -1;
+	}
+
+	static Vector mpData(2);
+	MP_Constraint *theMP;
+	MP_ConstraintIter &theMPIter = theDomain->getMPs();
+	while ((theMP = theMPIter()) != 0)
+	{
+		mpData(0) = theMP->getNodeRetained();
+		mpData(1) = theMP->getNodeConstrained();
+		if ((theChannel.sendVector(0, 0, mpData) < 0) ||
+			(theChannel.sendID(0, 0, theMP->getConstrainedDOFs()) < 0) ||
+			(theChannel.sendID(0, 0, theMP->getRetainedDOFs()) < 0))
+			return -1;
+	}
+
+	return 0;
+}
+
+// receives the state of the nodes and elements sent by sendModelState() into
+// the objects of this model, which has to be built the same way
+int SiteResponseModel::recvModelState(Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+	static Vector version(1);
+	if ((theChannel.recvVector(0, 0, version) < 0) || (version(0) != 1.0))
+		return -1;
+
+	Node *theNode;
+	NodeIter &theNodeIter = theDomain->getNodes();
+	while ((theNode = theNodeIter()) != 0)
+		if (theNode->recvSelf(0, theChannel, theBroker) < 0)
+			return -1;
+
+	Element *theEle;
+	ElementIter &theEleIter = theDomain->getElements();
+	while ((theEle = theEleIter()) != 0)
+		if (theEle->recvSelf(0, theChannel, theBroker) < 0)
+			return -1;
+
+	return 0;
+}
+
+
+// keeps the state of the transient analysis after step, with what the
+// recorders need to carry on appending to their files, in fileName. The
+// file is written next to the old one and then put in its place, so a run
+// killed while writing still has the last checkpoint
+int SiteResponseModel::saveCheckpoint(std::string fileName, int step, int numSteps, std::vector<Recorder*> &recorders,
+	std::vector<DataFileStream*> &dataStreams, std::vector<ProfileStream*> &profileStreams)
+{
+	SnapshotChannel theCheckpoint;
+	static ID header(6);
+	header(0) = theDomain->getNumNodes();
+	header(1) = theDomain->getNumElements();
+	header(2) = numSteps;
+	header(3) = recorders.size();
+	header(4) = dataStreams.size();
+	header(5) = profileStreams.size();
+	if ((theCheckpoint.sendID(0, 0, header) < 0) || (this->sendModelState(theCheckpoint, false) < 0))
+		return -1;
+
+	for (size_t i = 0; i < recorders.size(); i++)
+		if (recorders[i]->sendState(0, theCheckpoint) < 0)
+			return -1;
+
+	// getFileSize() waits for the rows of the stream still queued for the
+	// writer thread
+	Vector fileSizes(dataStreams.size());
+	for (size_t i = 0; i < dataStreams.size(); i++)
+		fileSizes(i) = (double)dataStreams[i]->getFileSize();
+	if (theCheckpoint.sendVector(0, 0, fileSizes) < 0)
+		return -1;
+
+	for (size_t i = 0; i < profileStreams.size(); i++)
+		if (profileStreams[i]->sendSelf(0, theCheckpoint) < 0)
+			return -1;
+
+	std::string tmpFile = fileName + ".tmp";
+	if (theCheckpoint.save(tmpFile.c_str(), step, theDomain->getCurrentTime()) < 0)
+		return -1;
+	remove(fileName.c_str());
+	if (rename(tmpFile.c_str(), fileName.c_str()) != 0)
+	{
+		opserr << "Could not write the checkpoint " << fileName.c_str() << endln;
+		return -1;
+	}
+
+	return 0;
+}
+
+// puts back the state kept by saveCheckpoint() and cuts the output files
+// back to where they were. Returns the step to carry on from, -1 if there is
+// no checkpoint of this model to resume from, or -2 if the checkpoint could
+// not be restored
+int SiteResponseModel::loadCheckpoint(std::string fileName, int numSteps, std::vector<Recorder*> &recorders,
+	std::vector<DataFileStream*> &dataStreams, std::vector<ProfileStream*> &profileStreams)
+{
+	SnapshotChannel theCheckpoint;
+	unsigned long long step;
+	double time;
+	if (theCheckpoint.load(fileName.c_str(), step, time) < 0)
+		return -1;
+
+	static ID header(6);
+	if ((theCheckpoint.recvID(0, 0, header) < 0) ||
+		(header(0) != theDomain->getNumNodes()) || (header(1) != theDomain->getNumElements()) ||
+		(header(2) != numSteps) || (header(3) != (int)recorders.size()) ||
+		(header(4) != (int)dataStreams.size()) || (header(5) != (int)profileStreams.size()))
+	{
+		opserr << "The checkpoint " << fileName.c_str() << " was not written for this model." << endln;
+		return -1;
+	}
+
+	FEM_ObjectBroker theBroker;
+	if (this->recvModelState(theCheckpoint, theBroker) < 0)
+		return -2;
+
+	for (size_t i = 0; i < recorders.size(); i++)
+		if (recorders[i]->recvState(0, theCheckpoint) < 0)
+			return -2;
+
+	Vector fileSizes(dataStreams.size());
+	if (theCheckpoint.recvVector(0, 0, fileSizes) < 0)
+		return -2;
+	for (size_t i = 0; i < dataStreams.size(); i++)
+		if (dataStreams[i]->setFileSize((long long)fileSizes(i)) < 0)
+			return -2;
+
+	for (size_t i = 0; i < profileStreams.size(); i++)
+		if (profileStreams[i]->recvSelf(0, theCheckpoint, theBroker) < 0)
+			return -2;
+
+	theDomain->setCurrentTime(time);
+	theDomain->setCommittedTime(time);
+
+	return (int)step;
+}
+
+
 int SiteResponseModel::subStepAnalyze(double dT, int subStep, int success, int remStep, DirectIntegrationAnalysis* theTransientAnalysis)
 {
 	if (subStep > 10)
 		return -10;
-	for (int i; i < 3; i++)
+	for (int i = 0; i < 3; i++)
 	{
 		opserr << "Try dT = " << dT << endln;
 		success = theTransientAnalysis->analyze(remStep, dT);// 0 means success
@@ -1314,5 +1753,50 @@ int SiteResponseModel::subStepAnalyze(double dT, int subStep, int success, int r
 
 int SiteResponseModel::runEffectiveStressModel2D()
 {
+	return this->buildEffectiveStressModel2D(true);
+}
+
+const MemoryStream *SiteResponseModel::getOutput(std::string name) const
+{
+	std::map<std::string, MemoryStream*>::const_iterator theOutput = theOutputs.find(name);
+	return (theOutput != theOutputs.end()) ? theOutput->second : NULL;
+}
+
+const ProfileStream *SiteResponseModel::getProfile(std::string name) const
+{
+	std::map<std::string, ProfileStream*>::const_iterator theProfile = theProfiles.find(name);
+	return (theProfile != theProfiles.end()) ? theProfile->second : NULL;
+}
+
+// the stream of the output name, a file in the output directory or, for a
+// model kept in memory, the rows themselves; the recorder it is given to owns it
+OPS_Stream *SiteResponseModel::openOutput(std::string name, std::vector<DataFileStream*> &dataStreams)
+{
+	if (keepOutputsInMemory)
+	{
+		MemoryStream *theStream = new MemoryStream();
+		theOutputs[name] = theStream;
+		return theStream;
+	}
+
+	std::string outFile = theOutputDir + PATH_SEPARATOR + name;
+	dataStreams.push_back(new DataFileStream(outFile.c_str(), OVERWRITE, 2, theOutputCSV, false, theOutputPrecision, false, true));
+	return dataStreams.back();
+}
 
+OPS_Stream *SiteResponseModel::openProfile(std::string name, std::vector<ProfileStream*> &profileStreams)
+{
+	std::string outFile = theOutputDir + PATH_SEPARATOR + name;
+	profileStreams.push_back(new ProfileStream(keepOutputsInMemory ? NULL : outFile.c_str()));
+	if (keepOutputsInMemory)
+		theProfiles[name] = profileStreams.back();
+	return profileStreams.back();
+}
+
+std::string SiteResponseModel::getEngineSettings() const
+{
+	char settings[256];
+	sprintf(settings, "%s Newmark %.17g %.17g dT %.17g %s %d", theAlgorithm.c_str(), theGamma, theBeta,
+		theTimeStep, theOutputCSV ? "csv" : "text", theOutputPrecision);
+	return settings;
 }
@@ -25,8 +25,26 @@
 
 #include "DirectIntegrationAnalysis.h"
 
+#include <map>
+#include <vector>
+
+class Channel;
+class FEM_ObjectBroker;
+class Recorder;
+class DataFileStream;
+class ProfileStream;
+class MemoryStream;
+class OPS_Stream;
+
 #define MAX_FREQUENCY 50.0
 #define NODES_PER_WAVELENGTH 10
+// identifies the results of this engine in the result cache; change it when
+// a change of the engine changes its results
+#define SRT_ENGINE_VERSION "SiteResponseTool engine 1.0"
+
+// called before every step of the transient analysis with the number of
+// steps done so far; a callback that returns anything but 0 stops the analysis
+typedef int (*SiteResponseProgress)(int step, int numSteps, double time, void *data);
 
 class SiteResponseModel {
 
@@ -41,11 +59,62 @@ public:
 	int   runEffectiveStressModel2D();
     void  setOutputDir(std::string outDir) { theOutputDir = outDir; }
     void setConfigFile(std::string configFile) { theConfigFile = configFile; }
+    // the configuration as the text of SRT.json, used instead of the file
+    void  setConfig(std::string config) { theConfigText = config; }
     void  setTclOutputDir(std::string outDir) { theTclOutputDir = outDir; }
     void  setAnalysisDir(std::string anaDir) { theAnalysisDir = anaDir; }
+    // the state after gravity is kept in this file and restored by the next
+    // model of the same profile; an empty name turns it off. The default is
+    // gravity.snapshot in the analysis directory
+    void  setGravitySnapshot(std::string fileName) { theSnapshotFile = fileName; useSnapshot = !fileName.empty(); }
+    // every interval steps the state of the transient analysis is kept in a
+    // checkpoint file, analysis.checkpoint in the output directory if no name
+    // is given; 0 turns it off. A resumed analysis carries on from the last
+    // checkpoint and appends to the outputs written up to it
+    void  setCheckpoint(int interval, std::string fileName = "") { checkpointInterval = interval; theCheckpointFile = fileName; }
+    void  setResume(bool resume) { resumeAnalysis = resume; }
+    // while the analysis runs the surface acceleration and the element stresses
+    // are published to surface.live and stress.live in the output directory,
+    // where a viewer can follow them and ask for the analysis to stop; off
+    // unless turned on here
+    void  setLiveFeed(bool liveFeed) { useLiveFeed = liveFeed; }
+    // the outputs of an analysis are kept in a result cache in dir of at most
+    // maxBytes, and an analysis of the same configuration and motion copies
+    // them from there instead of running; an empty dir, the default, turns
+    // it off
+    void  setResultCache(std::string dir, long long maxBytes = 1LL << 30) { theCacheDir = dir; theCacheMaxBytes = maxBytes; }
+    // the dynamic stage is solved by Newton iterations that form the tangent
+    // every iteration ("Newton") or keep the initial one ("NewtonInitial"),
+    // with a Newmark integrator of gamma and beta, in steps of dT
+    void  setAlgorithm(std::string algorithm) { theAlgorithm = algorithm; }
+    void  setIntegrator(double gamma, double beta) { theGamma = gamma; theBeta = beta; }
+    void  setTimeStep(double dT) { theTimeStep = dT; }
+    // the outputs are columns separated by spaces or, with csv, by commas,
+    // written with precision significant digits
+    void  setOutputFormat(bool csv, int precision = 6) { theOutputCSV = csv ? 1 : 0; theOutputPrecision = precision; }
+    // the settings above, the results of the engine depend on them
+    std::string getEngineSettings() const;
+    // the outputs are kept in memory instead of the output directory, and no
+    // other file is read or written: there is no tcl file, snapshot,
+    // checkpoint, live feed or result cache. The outputs are found by the
+    // names of their files and are there until the model is built again
+    void  setOutputsInMemory(bool inMemory) { keepOutputsInMemory = inMemory; }
+    const MemoryStream *getOutput(std::string name) const;
+    const ProfileStream *getProfile(std::string name) const;
+    void  setProgressCallback(SiteResponseProgress callback, void *data) { theProgressCallback = callback; theProgressData = data; }
 	int subStepAnalyze(double dT, int subStep, int success, int remStep, DirectIntegrationAnalysis* theTransientAnalysis);
 
 private:
+	int clearModel();
+	int sendModelState(Channel &theChannel, bool withConstraints);
+	int recvModelState(Channel &theChannel, FEM_ObjectBroker &theBroker);
+	int saveCheckpoint(std::string fileName, int step, int numSteps, std::vector<Recorder*> &recorders,
+		std::vector<DataFileStream*> &dataStreams, std::vector<ProfileStream*> &profileStreams);
+	OPS_Stream *openOutput(std::string name, std::vector<DataFileStream*> &dataStreams);
+	OPS_Stream *openProfile(std::string name, std::vector<ProfileStream*> &profileStreams);
+	int loadCheckpoint(std::string fileName, int numSteps, std::vector<Recorder*> &recorders,
+		std::vector<DataFileStream*> &dataStreams, std::vector<ProfileStream*> &profileStreams);
+
 	Domain *theDomain;
 	SiteLayering    SRM_layering;
 	OutcropMotion*  theMotionX;
@@ -53,8 +122,30 @@ private:
 	std::string     theOutputDir;
 	std::string 	theModelType;
     std::string 	theConfigFile;
+    std::string 	theConfigText;
     std::string     theTclOutputDir;
     std::string     theAnalysisDir;
+    std::string     theSnapshotFile;
+    bool            useSnapshot;
+    std::string     theCheckpointFile;
+    int             checkpointInterval;
+    bool            resumeAnalysis;
+    bool            useLiveFeed;
+    std::string     theCacheDir;
+    long long       theCacheMaxBytes;
+    std::string     theAlgorithm;
+    double          theGamma;
+    double          theBeta;
+    double          theTimeStep;
+    int             theOutputCSV;
+    int             theOutputPrecision;
+    bool            keepOutputsInMemory;
+    std::map<std::string, MemoryStream*> theOutputs;
+    std::map<std::string, ProfileStream*> theProfiles;
+    SiteResponseProgress theProgressCallback;
+    void           *theProgressData;
+    // the last build left its model in the domain
+    bool            theModelBuilt;
 };
 
 
@@ -0,0 +1,37 @@
+#include "LayerDiff.h"
+
+#include <string>
+
+LayerDiff::LayerDiff()
+{
+}
+
+// FNV-1a over the serialized value, the keys of json objects are sorted so
+// the same value always gives the same text
+unsigned long long LayerDiff::hashValue(const json &value, unsigned long long seed)
+{
+	std::string text = value.dump();
+	unsigned long long hash = seed;
+	for (size_t i = 0; i < text.size(); i++)
+	{
+		hash ^= (unsigned char)text[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+unsigned long long LayerDiff::hashLayer(const json &layer, const json &material, unsigned long long seed)
+{
+	return hashValue(material, hashValue(layer, seed));
+}
+
+int LayerDiff::update(const std::vector<unsigned long long> &layerHashes)
+{
+	int numUnchanged = 0;
+	while (numUnchanged < (int)layerHashes.size() && numUnchanged < (int)theHashes.size()
+		&& layerHashes[numUnchanged] == theHashes[numUnchanged])
+		numUnchanged++;
+
+	theHashes = layerHashes;
+	return numUnchanged;
+}
@@ -0,0 +1,36 @@
+#ifndef LAYERDIFF_H
+#define LAYERDIFF_H
+
+#include <vector>
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+// Tells a builder how many layers at the bottom of the profile are the same
+// as in the last profile it built. The soil column is numbered from the
+// bottom up, so the nodes and elements of those layers keep their tags and
+// coordinates and can be kept; the layers from the first changed one up are
+// built again.
+class LayerDiff {
+
+public:
+	LayerDiff();
+
+	// hash of a layer, its material and whatever else the builder puts in
+	// seed (e.g. the width of the column)
+	static unsigned long long hashLayer(const json &layer, const json &material, unsigned long long seed);
+	static unsigned long long hashValue(const json &value, unsigned long long seed = 14695981039346656037ULL);
+
+	// compares the hashes of the layers, from the bottom up, with the ones
+	// of the last call and keeps them for the next. Returns the number of
+	// layers at the bottom that did not change
+	int update(const std::vector<unsigned long long> &layerHashes);
+	// forgets the last profile, the next update() keeps nothing
+	void clear() { theHashes.clear(); }
+
+	int numLayers() const { return theHashes.size(); }
+
+private:
+	std::vector<unsigned long long> theHashes;
+};
+
+#endif
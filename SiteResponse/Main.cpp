@@ -9,100 +9,864 @@
 **                                                                       **
 ** ********************************************************************* */
 
+// Runs site response analyses from the command line:
+//
+//   siteresponse run   SRT.json [options]   runs one analysis
+//   siteresponse batch jobs.txt [options]   runs the analyses listed in a file
+//   siteresponse bench SRT.json [options]   times an analysis run several times
+//   siteresponse regional sites.csv [options]
+//                                           runs the sites of a catalogue and
+//                                           sums up each in a line of a table
+//
+// Each line of a batch file is a configuration file, optionally followed by
+// a motion; the outputs of the n-th job go to <output dir>/<n>. The older
+// form, siteresponse SRT.json analysisDir outputDir [options], writes the
+// tcl file of the model and runs the analysis only if asked to keep or use
+// checkpoints or a result cache.
+//
+// The sites of a regional run are analyzed in memory, in as many processes
+// as there are cores, and only their summaries are written, to regional.csv
+// in the output directory; see SiteCatalogue.h for the catalogue.
 
-
-
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <exception>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include "EffectiveFEModel.h"
 #include "siteLayering.h"
 #include "soillayer.h"
 #include "outcropMotion.h"
+#include "SiteCatalogue.h"
 
 #include "StandardStream.h"
 #include "FileStream.h"
+#include "DummyStream.h"
 #include "OPS_Stream.h"
 
+#if defined(WIN32) || defined(_WIN32)
+#include <direct.h>
+#define PATH_SEPARATOR "\\"
+#else
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define PATH_SEPARATOR "/"
+#endif
+
 
 StandardStream sserr;
-FileStream ferr("log");
-OPS_Stream *opserrPtr = &ferr;
+FileStream ferr;
+DummyStream quietStream;
+OPS_Stream *opserrPtr = &sserr;
 OPS_Stream *opsoutPtr = &sserr;
 
-/*
-SiteLayering setupDummyLayers()
+// the settings of the analyses, from the command line
+struct RunOptions
 {
-	SiteLayering res;
-	res.addNewLayer(SoilLayer("Clay1", 2.0,  98.78, 184.79, 2.05, 200.0, 1.0, 1.0));
-	res.addNewLayer(SoilLayer("Clay2", 6.0, 100.76, 188.50, 1.97, 200.0, 1.0, 1.0));
-	res.addNewLayer(SoilLayer("Clay3", 5.0,  98.53, 184.34, 2.06, 200.0, 1.0, 1.0));
-	res.addNewLayer(SoilLayer("Clay4", 2.4,  98.53, 184.34, 2.06, 200.0, 1.0, 1.0));
-	res.addNewLayer(SoilLayer("Clay5", 2.6,  98.53, 184.34, 2.06, 200.0, 1.0, 1.0));
-	res.addNewLayer(SoilLayer("Rock", 0.0, 1000.0, 3000.0, 2.5, 0.0, 0.0, 0.0));
+	std::string configFile;
+	std::string templateFile;
+	std::string motionFile;
+	std::string analysisDir;
+	std::string outputDir;
+	std::string logFile;
+	std::string algorithm;
+	double gamma;
+	double beta;
+	double dT;
+	bool csv;
+	int precision;
+	int checkpointInterval;
+	bool resume;
+	std::string cacheDir;
+	long long cacheSize;
+	bool useSnapshot;
+	bool liveFeed;
+	bool tclOnly;
+	bool quiet;
+	int threads;
+	int repeat;
 
-	return res;
+	RunOptions() : algorithm("Newton"), gamma(0.5), beta(0.25), dT(0.001), csv(false), precision(6),
+		checkpointInterval(0), resume(false), cacheSize(1024), useSnapshot(true), liveFeed(false),
+		tclOnly(false), quiet(false), threads(0), repeat(3) {}
+};
+
+static void printUsage()
+{
+	opserr << "Usage: siteresponse run   SRT.json [options]" << endln;
+	opserr << "       siteresponse batch jobs.txt [options]" << endln;
+	opserr << "       siteresponse bench SRT.json [options]" << endln;
+	opserr << "       siteresponse regional sites.csv|sites.jsonl [options]" << endln << endln;
+	opserr << "  --motion FILE          the rock motion, a .at2 or .bbp file or the base name of" << endln;
+	opserr << "                         the .time/.vel files (default: Rock in the analysis directory)" << endln;
+	opserr << "  --analysis-dir DIR     where model.tcl is written (default: the directory of SRT.json)" << endln;
+	opserr << "  --output-dir DIR       where the outputs go (default: out_tcl in the analysis" << endln;
+	opserr << "                         directory, batch_out for a batch or regional_out)" << endln;
+	opserr << "  --template FILE        the SRT.json the sites of a catalogue start from" << endln;
+	opserr << "                         (default: SRT.json in the directory of the catalogue)" << endln;
+	opserr << "  --algorithm NAME       Newton or NewtonInitial (default: Newton)" << endln;
+	opserr << "  --integrator NAME      Newmark average, linear or damped (default: average)" << endln;
+	opserr << "  --dt SECONDS           time step of the analysis (default: 0.001)" << endln;
+	opserr << "  --format text|csv      format of the outputs (default: text)" << endln;
+	opserr << "  --precision DIGITS     significant digits of the outputs (default: 6)" << endln;
+	opserr << "  --threads N            analyses of a batch or sites run at once (default: the" << endln;
+	opserr << "                         number of cores)" << endln;
+	opserr << "  --repeat N             times a bench runs the analysis (default: 3)" << endln;
+	opserr << "  --checkpoint N         keep the state of the analysis every N steps" << endln;
+	opserr << "  --resume               carry on from the last checkpoint" << endln;
+	opserr << "  --cache DIR            reuse the results of identical analyses kept in DIR" << endln;
+	opserr << "  --cache-size MB        size of the result cache (default: 1024)" << endln;
+	opserr << "  --no-snapshot          do not keep or restore the state after gravity" << endln;
+	opserr << "  --live                 publish the surface motion and stresses while running" << endln;
+	opserr << "  --tcl-only             only write the tcl file of the model" << endln;
+	opserr << "  --log FILE             where the log goes (default: log in the output directory)" << endln;
+	opserr << "  --quiet                do not show the progress of the analysis" << endln;
 }
-*/
 
-int main(int argc, char** argv)
+static std::string directoryOf(const std::string& fileName)
 {
+	size_t pos = fileName.find_last_of("/\\");
+	if (pos == std::string::npos)
+		return ".";
+	if (pos == 0)
+		return fileName.substr(0, 1);
+	return fileName.substr(0, pos);
+}
 
-	if (argc < 3)
+// makes dir and the directories above it that are missing
+static bool makeDir(const std::string& dir)
+{
+	for (size_t pos = dir.find_first_of("/\\", 1); ; pos = dir.find_first_of("/\\", pos + 1))
+	{
+		std::string path = dir.substr(0, pos);
+#if defined(WIN32) || defined(_WIN32)
+		_mkdir(path.c_str());
+#else
+		mkdir(path.c_str(), 0755);
+#endif
+		if (pos == std::string::npos)
+			break;
+	}
+	struct stat info;
+	return (stat(dir.c_str(), &info) == 0) && (info.st_mode & S_IFDIR);
+}
+
+// reads the options from argv[first] on; the other arguments are added to args
+static bool parseOptions(int argc, char** argv, int first, RunOptions& options, std::vector<std::string>& args)
+{
+	for (int i = first; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if ((arg == "--motion") && hasValue)
+			options.motionFile = argv[++i];
+		else if ((arg == "--analysis-dir") && hasValue)
+			options.analysisDir = argv[++i];
+		else if ((arg == "--output-dir") && hasValue)
+			options.outputDir = argv[++i];
+		else if ((arg == "--template") && hasValue)
+			options.templateFile = argv[++i];
+		else if ((arg == "--log") && hasValue)
+			options.logFile = argv[++i];
+		else if ((arg == "--algorithm") && hasValue)
+		{
+			options.algorithm = argv[++i];
+			if ((options.algorithm != "Newton") && (options.algorithm != "NewtonInitial"))
+			{
+				opserr << "Unknown algorithm " << argv[i] << endln;
+				return false;
+			}
+		}
+		else if ((arg == "--integrator") && hasValue)
+		{
+			std::string integrator = argv[++i];
+			// average and linear acceleration, and a Newmark with numerical damping
+			if (integrator == "average")
+			{
+				options.gamma = 0.5;
+				options.beta = 0.25;
+			} else if (integrator == "linear")
+			{
+				options.gamma = 0.5;
+				options.beta = 1.0 / 6.0;
+			} else if (integrator == "damped")
+			{
+				options.gamma = 0.6;
+				options.beta = 0.3025;
+			} else
+			{
+				opserr << "Unknown integrator " << argv[i] << endln;
+				return false;
+			}
+		}
+		else if ((arg == "--dt") && hasValue)
+			options.dT = atof(argv[++i]);
+		else if ((arg == "--format") && hasValue)
+		{
+			std::string format = argv[++i];
+			if ((format != "text") && (format != "csv"))
+			{
+				opserr << "Unknown output format " << argv[i] << endln;
+				return false;
+			}
+			options.csv = format == "csv";
+		}
+		else if ((arg == "--precision") && hasValue)
+			options.precision = atoi(argv[++i]);
+		else if ((arg == "--threads") && hasValue)
+			options.threads = atoi(argv[++i]);
+		else if ((arg == "--repeat") && hasValue)
+			options.repeat = atoi(argv[++i]);
+		else if ((arg == "--checkpoint") && hasValue)
+			options.checkpointInterval = atoi(argv[++i]);
+		else if (arg == "--resume")
+			options.resume = true;
+		else if ((arg == "--cache") && hasValue)
+			options.cacheDir = argv[++i];
+		else if ((arg == "--cache-size") && hasValue)
+			options.cacheSize = atoll(argv[++i]);
+		else if (arg == "--no-snapshot")
+			options.useSnapshot = false;
+		else if (arg == "--live")
+			options.liveFeed = true;
+		else if (arg == "--tcl-only")
+			options.tclOnly = true;
+		else if (arg == "--quiet")
+			options.quiet = true;
+		else if ((arg.size() > 2) && (arg.compare(0, 2, "--") == 0))
+		{
+			opserr << "Unknown option " << arg.c_str() << endln;
+			return false;
+		}
+		else
+			args.push_back(arg);
+	}
+
+	if ((options.dT <= 0.0) || (options.precision < 1) || (options.repeat < 1) || (options.cacheSize <= 0))
 	{
-		opserr << ">>> SiteResponseTool: Not enough arguments. <<<" << endln;
-		std::getchar();
+		opserr << "The time step, precision, repeat count and cache size have to be positive." << endln;
+		return false;
+	}
+	return true;
+}
+
+// fills in the directories and files that were not given
+static void completeOptions(RunOptions& options)
+{
+	if (options.analysisDir.empty())
+		options.analysisDir = directoryOf(options.configFile);
+	if (options.motionFile.empty())
+		options.motionFile = options.analysisDir + PATH_SEPARATOR + "Rock";
+	if (options.outputDir.empty())
+		options.outputDir = options.analysisDir + PATH_SEPARATOR + "out_tcl";
+	if (options.logFile.empty())
+		options.logFile = options.outputDir + PATH_SEPARATOR + "log";
+}
+
+static bool loadMotion(const RunOptions& options, OutcropMotion& motion)
+{
+	motion.setMotion(options.motionFile.c_str());
+	if (!motion.isInitialized() || (motion.getNumSteps() < 1))
+	{
+		opserr << "Could not read the motion " << options.motionFile.c_str() << endln;
+		return false;
+	}
+	return true;
+}
+
+// runs an analysis with its messages in the log file; returns 0 if it is done
+static int runAnalysis(const RunOptions& options, OutcropMotion& motion)
+{
+	if (!makeDir(options.analysisDir) || !makeDir(options.outputDir))
+	{
+		opserr << "Could not make the directories " << options.analysisDir.c_str() << " and " << options.outputDir.c_str() << endln;
 		return -1;
 	}
+	if (ferr.setFile(options.logFile.c_str()) < 0)
+		return -1;
 
-	std::string configureFile = argv[1];
-	std::string anaDir = argv[2];
-	std::string outDir = argv[3];
-	SiteResponseModel *model;
+	SiteResponseModel model("2D", &motion);
+	model.setConfigFile(options.configFile);
+	model.setAnalysisDir(options.analysisDir);
+	model.setOutputDir(options.outputDir);
+	model.setTclOutputDir(options.outputDir);
+	model.setAlgorithm(options.algorithm);
+	model.setIntegrator(options.gamma, options.beta);
+	model.setTimeStep(options.dT);
+	model.setOutputFormat(options.csv, options.precision);
+	model.setCheckpoint(options.checkpointInterval);
+	model.setResume(options.resume);
+	model.setLiveFeed(options.liveFeed);
+	if (!options.useSnapshot)
+		model.setGravitySnapshot("");
+	if (!options.cacheDir.empty())
+		model.setResultCache(options.cacheDir, options.cacheSize * 1024 * 1024);
 
-	//./siteresponse ../test/siteLayering.loc -bbp ../test/9130326.nwhp.vel.bbp out thisLog
-    // read the layering file
-    std::string layersFN("/Users/simcenter/Codes/SimCenter/SiteResponseTool/test/siteLayering.loc");
-    std::string bbpOName(".");
-    SiteLayering siteLayers(layersFN.c_str());
-    int t = siteLayers.getNumLayers();
+	OPS_Stream *theOutput = opsoutPtr;
+	opserrPtr = &ferr;
+	if (options.quiet)
+		opsoutPtr = &quietStream;
+	int result;
+	try
+	{
+		result = model.buildEffectiveStressModel2D(!options.tclOnly);
+	}
+	catch (std::exception& e)
+	{
+		opserr << "Site response analysis failed: " << e.what() << endln;
+		result = -1;
+	}
+	ferr.close();
+	opserrPtr = &sserr;
+	opsoutPtr = theOutput;
 
+	if (result != 0)
+		opserr << "Site response analysis of " << options.configFile.c_str() << " failed, see " << options.logFile.c_str() << endln;
+	return result;
+}
 
-    // read the motion
-    OutcropMotion motionX;
-    //OutcropMotion motionZ;
+static int runCommand(RunOptions& options)
+{
+	completeOptions(options);
+	OutcropMotion motion;
+	if (!loadMotion(options, motion))
+		return -1;
+	return runAnalysis(options, motion);
+}
 
-    int inputStyle = 2; // bbp=1 opensees=2
+// each job runs in a process of its own, as the engine keeps global state;
+// returns 0, or 1 if the analysis failed
+static int runJob(const RunOptions& options)
+{
+	OutcropMotion motion;
+	if (!loadMotion(options, motion))
+		return 1;
+	return (runAnalysis(options, motion) == 0) ? 0 : 1;
+}
+
+static int batchCommand(const std::string& jobsFile, RunOptions& options)
+{
+	std::ifstream file(jobsFile.c_str());
+	if (!file.is_open())
+	{
+		opserr << "Could not read the list of jobs " << jobsFile.c_str() << endln;
+		return -1;
+	}
+
+	std::string batchDir = options.outputDir.empty() ? std::string("batch_out") : options.outputDir;
+	std::vector<RunOptions> jobs;
+	std::string line;
+	while (std::getline(file, line))
+	{
+		std::istringstream values(line);
+		std::string configFile, motionFile;
+		if (!(values >> configFile) || (configFile[0] == '#'))
+			continue;
+		values >> motionFile;
+
+		// the jobs share nothing but the configuration and the motion: the tcl
+		// file, the snapshot and the log of a job are kept with its outputs
+		RunOptions job = options;
+		job.configFile = configFile;
+		job.analysisDir = directoryOf(configFile);
+		if (!motionFile.empty())
+			job.motionFile = motionFile;
+		job.logFile = "";
+		completeOptions(job);
+		std::ostringstream jobDir;
+		jobDir << batchDir << PATH_SEPARATOR << jobs.size() + 1;
+		job.analysisDir = jobDir.str();
+		job.outputDir = jobDir.str();
+		job.logFile = job.outputDir + PATH_SEPARATOR + "log";
+		job.quiet = true;
+		jobs.push_back(job);
+	}
+	if (jobs.empty())
+	{
+		opserr << "There are no jobs in " << jobsFile.c_str() << endln;
+		return -1;
+	}
+	if (!makeDir(batchDir))
+	{
+		opserr << "Could not make the directory " << batchDir.c_str() << endln;
+		return -1;
+	}
+
+	int numThreads = options.threads;
+	if (numThreads < 1)
+		numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+	std::vector<int> status(jobs.size(), 1);
+	std::vector<double> seconds(jobs.size(), 0.0);
+	typedef std::chrono::steady_clock Clock;
+	std::vector<Clock::time_point> started(jobs.size());
+
+#if defined(WIN32) || defined(_WIN32)
+	numThreads = 1;
+#endif
+	if (numThreads == 1)
+	{
+		for (size_t n = 0; n < jobs.size(); n++)
+		{
+			started[n] = Clock::now();
+			status[n] = runJob(jobs[n]);
+			seconds[n] = std::chrono::duration<double>(Clock::now() - started[n]).count();
+			opserr << "Job " << (int)n + 1 << " " << (status[n] == 0 ? "done" : "failed") << " in " << seconds[n] << " s" << endln;
+		}
+	}
+#if !defined(WIN32) && !defined(_WIN32)
+	else
+	{
+		// keep numThreads jobs running, starting the next one when one is done
+		std::map<pid_t, size_t> running;
+		size_t next = 0;
+		while ((next < jobs.size()) || !running.empty())
+		{
+			if ((next < jobs.size()) && ((int)running.size() < numThreads))
+			{
+				started[next] = Clock::now();
+				// the child leaves with _exit, exit would run the atexit handlers
+				// of the parent and flush its stdio buffers a second time
+				pid_t pid = fork();
+				if (pid == 0)
+					_exit(runJob(jobs[next]));
+				if (pid < 0)
+					opserr << "Could not start job " << (int)next + 1 << endln;
+				else
+					running[pid] = next;
+				next++;
+				continue;
+			}
 
-    if (inputStyle == 1)
-    {
-        std::string bbpFName("/Users/simcenter/Codes/SimCenter/SiteResponseTool/test/9130326.nwhp.vel.bbp");
-        bbpOName = std::string("out");
-        std::string bbpLName = std::string("thisLog");
-        //ferr.setFile(bbpLName.c_str(), APPEND);
-        // read bbp style motion
-        motionX.setBBPMotion(bbpFName.c_str(), 1);
-        //motionZ.setBBPMotion(bbpFName.c_str(), 2);
+			int exitStatus;
+			pid_t pid = waitpid(-1, &exitStatus, 0);
+			if (pid < 0)
+				break;
+			std::map<pid_t, size_t>::iterator job = running.find(pid);
+			if (job == running.end())
+				continue;
+			size_t n = job->second;
+			running.erase(job);
+			status[n] = (WIFEXITED(exitStatus) && (WEXITSTATUS(exitStatus) == 0)) ? 0 : 1;
+			seconds[n] = std::chrono::duration<double>(Clock::now() - started[n]).count();
+			opserr << "Job " << (int)n + 1 << " " << (status[n] == 0 ? "done" : "failed") << " in " << seconds[n] << " s" << endln;
+		}
+	}
+#endif
 
-        model = new SiteResponseModel(siteLayers, "2D", &motionX);
-        model->setOutputDir(bbpOName);
-    }
-    else {
-        std::string bbpLName = "Log";
-        //std::string motionXFN("/Users/simcenter/Codes/SimCenter/SiteResponseTool/test/RSN766_G02_000_VEL");
-        std::string motionXFN(anaDir+"/Rock");//TODO: may not work on windows
-        motionX.setMotion(motionXFN.c_str());
-        bbpOName = "out";
-        model = new SiteResponseModel("2D", &motionX);
-        model->setOutputDir(bbpOName);
-        model->setAnalysisDir(anaDir);
-        model->setTclOutputDir(outDir);
-        model->setConfigFile(configureFile);
+	// a line for each job in the summary
+	std::string summaryFile = batchDir + PATH_SEPARATOR + "batch.csv";
+	FILE *summary = fopen(summaryFile.c_str(), "w");
+	int numFailed = 0;
+	if (summary != NULL)
+		fprintf(summary, "job,config,motion,status,seconds\n");
+	for (size_t n = 0; n < jobs.size(); n++)
+	{
+		if (status[n] != 0)
+			numFailed++;
+		if (summary != NULL)
+			fprintf(summary, "%d,%s,%s,%s,%.3f\n", (int)n + 1, jobs[n].configFile.c_str(), jobs[n].motionFile.c_str(),
+				status[n] == 0 ? "done" : "failed", seconds[n]);
+	}
+	if (summary != NULL)
+		fclose(summary);
 
-        bool runAnalysis = false;
-    	model->buildEffectiveStressModel2D(runAnalysis);
+	opserr << (int)jobs.size() - numFailed << " of " << (int)jobs.size() << " jobs done, see " << summaryFile.c_str() << endln;
+	return (numFailed > 0) ? 1 : 0;
+}
 
-    }
+// the sites left to a worker of a regional run, [begin, end) packed in one
+// word: the worker takes them from the front and, when it has none left, the
+// others steal half of theirs from the back, so a worker held up by a few
+// slow (liquefying) sites does not keep the others waiting
+struct SiteQueue
+{
+	std::atomic<unsigned long long> range;
+	// the site the worker is analyzing, -1 if none
+	int current;
+};
 
+// what became of a site
+struct SiteResult
+{
+	// -1 if it was not analyzed, 0 if it was, 1 if the analysis failed
+	int status;
+	double seconds;
+	SiteMetrics metrics;
+};
 
+static unsigned long long packRange(unsigned int begin, unsigned int end)
+{
+	return ((unsigned long long)begin << 32) | end;
+}
+
+// the next site of worker w, taken from its own sites or stolen from the
+// worker with the most left; -1 when there are none left anywhere
+static int takeSite(SiteQueue* queues, int numWorkers, int w)
+{
+	while (true)
+	{
+		unsigned long long range = queues[w].range.load();
+		unsigned int begin = range >> 32, end = range & 0xffffffff;
+		while (begin < end)
+		{
+			if (queues[w].range.compare_exchange_weak(range, packRange(begin + 1, end)))
+				return begin;
+			begin = range >> 32;
+			end = range & 0xffffffff;
+		}
+
+		int victim = -1;
+		unsigned int mostLeft = 0;
+		for (int v = 0; v < numWorkers; v++)
+		{
+			range = queues[v].range.load();
+			unsigned int numLeft = (range & 0xffffffff) - std::min<unsigned int>(range >> 32, range & 0xffffffff);
+			if ((v != w) && (numLeft > mostLeft))
+			{
+				victim = v;
+				mostLeft = numLeft;
+			}
+		}
+		if (victim < 0)
+			return -1;
 
+		range = queues[victim].range.load();
+		begin = range >> 32;
+		end = range & 0xffffffff;
+		if (begin >= end)
+			continue;
+		unsigned int numStolen = (end - begin + 1) / 2;
+		if (queues[victim].range.compare_exchange_strong(range, packRange(begin, end - numStolen)))
+		{
+			queues[w].range.store(packRange(end - numStolen + 1, end));
+			return end - numStolen;
+		}
+	}
+}
+
+// analyzes a site in memory; the motions are read once by each worker
+static SiteResult runSite(const SiteCatalogue::Site& site, const RunOptions& options, std::map<std::string, OutcropMotion*>& motions)
+{
+	SiteResult result;
+	result.status = 1;
+	memset(&result.metrics, 0, sizeof(result.metrics));
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	RunOptions siteOptions = options;
+	if (!site.motion.empty())
+		siteOptions.motionFile = site.motion;
+	std::map<std::string, OutcropMotion*>::iterator motion = motions.find(siteOptions.motionFile);
+	if (motion == motions.end())
+	{
+		OutcropMotion* theMotion = new OutcropMotion();
+		if (!loadMotion(siteOptions, *theMotion))
+		{
+			delete theMotion;
+			theMotion = NULL;
+		}
+		motion = motions.insert(std::make_pair(siteOptions.motionFile, theMotion)).first;
+	}
+
+	if (motion->second != NULL)
+	{
+		SiteResponseModel model("2D", motion->second);
+		model.setConfig(site.config.dump());
+		model.setOutputsInMemory(true);
+		model.setAlgorithm(options.algorithm);
+		model.setIntegrator(options.gamma, options.beta);
+		model.setTimeStep(options.dT);
+
+		OPS_Stream* theOutput = opsoutPtr;
+		opserrPtr = &ferr;
+		opsoutPtr = &quietStream;
+		opserr << "Site " << site.id.c_str() << endln;
+		int status;
+		try
+		{
+			status = model.buildEffectiveStressModel2D(true);
+		}
+		catch (std::exception& e)
+		{
+			opserr << "Site response analysis failed: " << e.what() << endln;
+			status = -1;
+		}
+		opserrPtr = &sserr;
+		opsoutPtr = theOutput;
+
+		if ((status == 0) && SiteCatalogue::getMetrics(model, result.metrics))
+			result.status = 0;
+	}
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	opserr << "Site " << site.id.c_str() << " " << (result.status == 0 ? "done" : "failed") << " in " << result.seconds << " s" << endln;
+	return result;
+}
+
+// worker w analyzes sites until there are none left
+static int regionalWorker(const SiteCatalogue& catalogue, const RunOptions& options, SiteQueue* queues, int numWorkers, int w, SiteResult* results)
+{
+	if (ferr.setFile(options.logFile.c_str(), APPEND) < 0)
+		return 1;
+
+	std::map<std::string, OutcropMotion*> motions;
+	int n;
+	while ((n = takeSite(queues, numWorkers, w)) >= 0)
+	{
+		queues[w].current = n;
+		results[n] = runSite(catalogue.getSite(n), options, motions);
+		queues[w].current = -1;
+	}
+
+	for (std::map<std::string, OutcropMotion*>::iterator m = motions.begin(); m != motions.end(); ++m)
+		delete m->second;
+	ferr.close();
+	return 0;
+}
+
+static int regionalCommand(const std::string& catalogueFile, RunOptions& options)
+{
+	options.configFile = options.templateFile.empty() ? directoryOf(catalogueFile) + PATH_SEPARATOR + "SRT.json" : options.templateFile;
+	if (options.outputDir.empty())
+		options.outputDir = "regional_out";
+	completeOptions(options);
+
+	json templateConfig;
+	std::ifstream templateFile(options.configFile.c_str());
+	try
+	{
+		templateConfig = json::parse(templateFile);
+	}
+	catch (std::exception& e)
+	{
+		opserr << "Could not read the template " << options.configFile.c_str() << ": " << e.what() << endln;
+		return -1;
+	}
+
+	SiteCatalogue catalogue(templateConfig);
+	if (!catalogue.read(catalogueFile))
+	{
+		opserr << catalogue.getError().c_str() << endln;
+		return -1;
+	}
+	int numSites = catalogue.getNumSites();
+
+	if (!makeDir(options.outputDir) || (ferr.setFile(options.logFile.c_str()) < 0))
+	{
+		opserr << "Could not make the directory " << options.outputDir.c_str() << endln;
+		return -1;
+	}
+	ferr.close();
+
+	int numWorkers = options.threads;
+	if (numWorkers < 1)
+		numWorkers = std::max(1, (int)std::thread::hardware_concurrency());
+#if defined(WIN32) || defined(_WIN32)
+	numWorkers = 1;
+#endif
+	numWorkers = std::min(numWorkers, numSites);
+
+	// the queues and the results are shared by the workers, which are
+	// processes as the engine keeps global state
+	size_t sharedSize = numWorkers * sizeof(SiteQueue) + numSites * sizeof(SiteResult);
+#if defined(WIN32) || defined(_WIN32)
+	char* shared = (char*)malloc(sharedSize);
+#else
+	char* shared = (char*)mmap(NULL, sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shared == MAP_FAILED)
+		shared = NULL;
+#endif
+	if (shared == NULL)
+	{
+		opserr << "Could not share the sites between the workers" << endln;
+		return -1;
+	}
+	SiteQueue* queues = (SiteQueue*)shared;
+	SiteResult* results = (SiteResult*)(shared + numWorkers * sizeof(SiteQueue));
+	for (int w = 0; w < numWorkers; w++)
+	{
+		new (&queues[w].range) std::atomic<unsigned long long>(packRange(w * numSites / numWorkers, (w + 1) * numSites / numWorkers));
+		queues[w].current = -1;
+	}
+	for (int n = 0; n < numSites; n++)
+	{
+		results[n].status = -1;
+		results[n].seconds = 0.0;
+		memset(&results[n].metrics, 0, sizeof(results[n].metrics));
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	if (numWorkers == 1)
+		regionalWorker(catalogue, options, queues, numWorkers, 0, results);
+#if !defined(WIN32) && !defined(_WIN32)
+	else
+	{
+		// a worker that dies takes the site it was analyzing with it, another
+		// one carries on with the rest of its sites
+		std::map<pid_t, int> workers;
+		for (int w = 0; w < numWorkers; w++)
+		{
+			pid_t pid = fork();
+			if (pid == 0)
+				_exit(regionalWorker(catalogue, options, queues, numWorkers, w, results));
+			if (pid > 0)
+				workers[pid] = w;
+		}
+		while (!workers.empty())
+		{
+			int exitStatus;
+			pid_t pid = waitpid(-1, &exitStatus, 0);
+			if (pid < 0)
+				break;
+			std::map<pid_t, int>::iterator worker = workers.find(pid);
+			if (worker == workers.end())
+				continue;
+			int w = worker->second;
+			workers.erase(worker);
+			if (WIFEXITED(exitStatus) && (WEXITSTATUS(exitStatus) == 0))
+				continue;
+
+			if (queues[w].current >= 0)
+			{
+				results[queues[w].current].status = 1;
+				opserr << "Site " << catalogue.getSite(queues[w].current).id.c_str() << " failed, its worker died" << endln;
+				queues[w].current = -1;
+			}
+			if (takeSite(queues, numWorkers, w) < 0)
+				continue;
+			// the site taken above is handed back to the new worker
+			queues[w].range.fetch_sub(1ULL << 32);
+			pid = fork();
+			if (pid == 0)
+				_exit(regionalWorker(catalogue, options, queues, numWorkers, w, results));
+			if (pid > 0)
+				workers[pid] = w;
+		}
+	}
+#endif
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// a line for each site, in the order of the catalogue
+	std::string tableFile = options.outputDir + PATH_SEPARATOR + "regional.csv";
+	FILE* table = fopen(tableFile.c_str(), "w");
+	if (table == NULL)
+		opserr << "Could not write the table " << tableFile.c_str() << endln;
+	else
+		fprintf(table, "site,motion,status,seconds,base_pga_g,surface_pga_g,amplification,max_ru,max_shear_strain,settlement_m\n");
+	int numFailed = 0;
+	for (int n = 0; n < numSites; n++)
+	{
+		const SiteCatalogue::Site& site = catalogue.getSite(n);
+		const SiteResult& result = results[n];
+		if (result.status != 0)
+			numFailed++;
+		if (table == NULL)
+			continue;
+		fprintf(table, "%s,%s,%s,%.3f", site.id.c_str(), site.motion.empty() ? options.motionFile.c_str() : site.motion.c_str(),
+			result.status == 0 ? "done" : "failed", result.seconds);
+		if (result.status == 0)
+			fprintf(table, ",%.6g,%.6g,%.6g,%.6g,%.6g,%.6g\n", result.metrics.basePGA, result.metrics.surfacePGA,
+				result.metrics.amplification, result.metrics.maxRu, result.metrics.maxStrain, result.metrics.settlement);
+		else
+			fprintf(table, ",,,,,,\n");
+	}
+	if (table != NULL)
+		fclose(table);
+
+#if defined(WIN32) || defined(_WIN32)
+	free(shared);
+#else
+	munmap(shared, sharedSize);
+#endif
+
+	opserr << numSites - numFailed << " of " << numSites << " sites done in " << seconds << " s, see " << tableFile.c_str() << endln;
+	return (numFailed > 0) ? 1 : 0;
+}
+
+// runs the whole analysis, gravity included, repeat times in this process
+static int benchCommand(RunOptions& options)
+{
+	completeOptions(options);
+	options.useSnapshot = false;
+	options.cacheDir = "";
+	options.tclOnly = false;
+	options.quiet = true;
+
+	OutcropMotion motion;
+	if (!loadMotion(options, motion))
+		return -1;
+	int numSteps = (int)(motion.getNumSteps() * motion.getDt() / options.dT);
+
+	double minTime = 0.0, maxTime = 0.0, totalTime = 0.0;
+	for (int n = 0; n < options.repeat; n++)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		if (runAnalysis(options, motion) != 0)
+			return -1;
+		double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		opserr << "Run " << n + 1 << ": " << time << " s" << endln;
+		minTime = (n == 0) ? time : std::min(minTime, time);
+		maxTime = std::max(maxTime, time);
+		totalTime += time;
+	}
+
+	double meanTime = totalTime / options.repeat;
+	opserr << "Runs: " << options.repeat << "  min " << minTime << " s  mean " << meanTime << " s  max " << maxTime << " s" << endln;
+	opserr << numSteps << " steps of " << options.dT << " s, " << numSteps / minTime << " steps/s" << endln;
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printUsage();
+		return -1;
+	}
+
+	RunOptions options;
+	std::vector<std::string> args;
+	std::string command = argv[1];
+	if ((command == "run") || (command == "batch") || (command == "bench") || (command == "regional"))
+	{
+		if (!parseOptions(argc, argv, 2, options, args) || (args.size() != 1))
+		{
+			printUsage();
+			return -1;
+		}
+		if (command == "batch")
+			return batchCommand(args[0], options);
+		if (command == "regional")
+			return regionalCommand(args[0], options);
+
+		options.configFile = args[0];
+		if (command == "bench")
+			return benchCommand(options);
+		return runCommand(options);
+	}
+
+	// siteresponse SRT.json analysisDir outputDir [options]
+	if ((argc < 4) || !parseOptions(argc, argv, 4, options, args) || !args.empty())
+	{
+		printUsage();
+		return -1;
+	}
+	options.configFile = argv[1];
+	options.analysisDir = argv[2];
+	options.outputDir = argv[3];
+	options.logFile = "log";
+	options.liveFeed = true;
+	options.tclOnly = (options.checkpointInterval == 0) && !options.resume && options.cacheDir.empty();
+	return runCommand(options);
 }
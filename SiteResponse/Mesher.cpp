@@ -13,16 +13,44 @@ m_configureFile(jsonFile)
 
 }
 
+Mesher::~Mesher()
+{
+    truncate(0);
+}
+
+void Mesher::clearMesh()
+{
+    truncate(0);
+    m_layerDiff.clear();
+    m_layerNumElements.clear();
+}
+
+// drops the elements from numElements up and the nodes above them
+void Mesher::truncate(int numElements)
+{
+    size_t numNodesKept = numElements > 0 ? 2 + 2*numElements : 0;
+    for (size_t n = numElements; n < elements.size(); n++)
+        delete elements[n];
+    for (size_t n = numNodesKept; n < nodes.size(); n++)
+        delete nodes[n];
+    if (elements.size() > (size_t)numElements)
+        elements.resize(numElements);
+    if (nodes.size() > numNodesKept)
+        nodes.resize(numNodesKept);
+}
+
 
 bool Mesher::mesh2DColumn(){
-    nodes.clear();
-    elements.clear();
+    m_changed = true;
 
     //std::string configFile = "/Users/simcenter/Codes/SimCenter/SiteResponseTool/bin/SRT.json";
     //std::string configFile = "SRT.json";
     std::ifstream i(m_configureFile);
     if(!i)
+    {
+        clearMesh();
         return false;// failed to open SRT.json TODO: print to log
+    }
 
     json j;
     i >> j;
@@ -51,25 +79,24 @@ bool Mesher::mesh2DColumn(){
     catch (std::exception& e)
     {
         std::cerr << "Standard exception: " << e.what() << std::endl;
+        clearMesh();
         return false;
     }
     catch(std::string str)
     {
         std::cerr << str << std::endl;
+        clearMesh();
         return false;
     }
 
     json soilProfile,soilLayers,layer;
     Nodex* node;
     Quadx* elem;
-    node = new Nodex(1, 0.0, 0.0, 0.0);
-    nodes.push_back(node);
-    node = new Nodex(2, 0.0, eSizeH, 0.0);
-    nodes.push_back(node);
     int numNodes = 2;
     double ycrd = 0.0;
     int numEles = 0;
     m_eSizeH = eSizeH;
+    m_numLayers = 0;
 
     soilProfile = j["soilProfile"];
 
@@ -81,8 +108,34 @@ bool Mesher::mesh2DColumn(){
         soilLayers = soilProfile["soilLayers"];
         std::sort(soilLayers.begin(),soilLayers.end(),
                   [](const json &a, const json &b) { return a["id"] > b["id"]; });
+
+        // keep the layers at the bottom that did not change, with the
+        // nodes and elements they had
+        std::vector<unsigned long long> layerHashes;
+        unsigned long long seed = LayerDiff::hashValue(eSizeH);
         for (auto l:soilLayers)
+            layerHashes.push_back(LayerDiff::hashLayer(l, json(), seed));
+        int numKept = m_layerDiff.update(layerHashes);
+        numKept = std::min(numKept, (int)m_layerNumElements.size());
+        m_changed = (numKept < (int)soilLayers.size()) || (m_layerNumElements.size() != soilLayers.size());
+        m_layerNumElements.resize(numKept);
+        for (int n = 0; n < numKept; n++)
+            numEles += m_layerNumElements[n];
+        truncate(numEles);
+        if (nodes.empty())
+        {
+            node = new Nodex(1, 0.0, 0.0, 0.0);
+            nodes.push_back(node);
+            node = new Nodex(2, 0.0, eSizeH, 0.0);
+            nodes.push_back(node);
+        }
+        numNodes += 2*numEles;
+        ycrd = numEles > 0 ? nodes.back()->y() : 0.0;
+        m_numLayers = numKept;
+
+        for (size_t n = numKept; n < soilLayers.size(); n++)
         {
+            const json &l = soilLayers[n];
             int eTag = l["id"];
             double eSizeV = l["eSize"];
             if (eSizeV<minESizeV)
@@ -96,6 +149,7 @@ bool Mesher::mesh2DColumn(){
             int matTag = l["material"];
             std::string color = l["color"];
 
+            int numEleBefore = numEles;
             if (thickness>0.000001)
             {
             int numEleThisLayer = static_cast<int> (std::round(thickness / eSizeV));
@@ -118,6 +172,7 @@ bool Mesher::mesh2DColumn(){
             }
 
             std::cout << "eleTag: " << eTag << std::endl;
+            m_layerNumElements.push_back(numEles - numEleBefore);
             m_numLayers += 1;
         }
         m_totalHeight = ycrd;
@@ -127,11 +182,13 @@ bool Mesher::mesh2DColumn(){
     catch (std::exception& e)
     {
         std::cout << "Standard exception: " << e.what() << std::endl;
+        clearMesh();
         return false;
     }
     catch(std::string str)
     {
         std::cerr << str << std::endl;
+        clearMesh();
         return false;
     }
     return true;
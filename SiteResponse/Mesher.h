@@ -8,6 +8,7 @@
 #include <string>
 #include <iomanip>
 #include <nlohmann/json.hpp>
+#include "LayerDiff.h"
 using json = nlohmann::json;
 
 
@@ -65,7 +66,12 @@ class Mesher
 public:
     Mesher();
     Mesher(std::string jsonFile);
+    ~Mesher();
+    // meshes the column of SRT.json; the layers at the bottom that did not
+    // change since the last call keep their nodes and elements
     bool mesh2DColumn();
+    // whether the last mesh2DColumn() changed the mesh
+    bool changed(){return m_changed;}
 
     std::vector<Nodex*> nodes;
     std::vector<Quadx*> elements;
@@ -84,7 +90,13 @@ public:
     double m_totalHeight = 0.0;// not safe here, but I just ...
 
 private:
+    void truncate(int numElements);
+    void clearMesh();
+
     double m_eSizeH = 0.0;
+    bool m_changed = true;
+    LayerDiff m_layerDiff;
+    std::vector<int> m_layerNumElements;// elements in each layer, from the bottom up
 
     int m_numLayers = 0;
     int m_numNodes = 0;
@@ -0,0 +1,137 @@
+// Builds a motion library out of ground motion files:
+//
+//   buildmotionlibrary library.mlib [-metadata file] [-list file] motion ...
+//
+// Each motion is named the way OutcropMotion takes it (a .at2 file, a .bbp
+// file or the base name of the .time/.acc/.vel/.disp files). -list reads more
+// motion names from a file, one per line. -metadata reads lines of
+// "ID magnitude distance" for the records.
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "motionLibrary.h"
+
+#include "StandardStream.h"
+#include "OPS_Stream.h"
+#include "OPS_Globals.h"
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+OPS_Stream *opsoutPtr = &sserr;
+
+static bool readMetadata(const char* fName, std::map<std::string, std::pair<double, double> >& metadata)
+{
+	std::ifstream file(fName);
+	if (!file.is_open())
+		return false;
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() || (line[0] == '#') || (line[0] == '%'))
+			continue;
+		for (size_t i = 0; i < line.size(); i++)
+			if (line[i] == ',')
+				line[i] = ' ';
+		std::istringstream values(line);
+		std::string id;
+		double magnitude, distance;
+		if (values >> id >> magnitude >> distance)
+			metadata[id] = std::make_pair(magnitude, distance);
+	}
+	return true;
+}
+
+static bool readList(const char* fName, std::vector<std::string>& motionNames)
+{
+	std::ifstream file(fName);
+	if (!file.is_open())
+		return false;
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		size_t start = line.find_first_not_of(" \t\r");
+		size_t end = line.find_last_not_of(" \t\r");
+		if ((start == std::string::npos) || (line[start] == '#'))
+			continue;
+		motionNames.push_back(line.substr(start, end - start + 1));
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		opserr << "Usage: buildmotionlibrary library.mlib [-metadata file] [-list file] motion ..." << endln;
+		return -1;
+	}
+
+	std::map<std::string, std::pair<double, double> > metadata;
+	std::vector<std::string> motionNames;
+	for (int i = 2; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "-metadata") == 0) && (i + 1 < argc))
+		{
+			if (!readMetadata(argv[++i], metadata))
+			{
+				opserr << "Could not read the metadata file " << argv[i] << endln;
+				return -1;
+			}
+		}
+		else if ((strcmp(argv[i], "-list") == 0) && (i + 1 < argc))
+		{
+			if (!readList(argv[++i], motionNames))
+			{
+				opserr << "Could not read the list of motions " << argv[i] << endln;
+				return -1;
+			}
+		}
+		else
+			motionNames.push_back(argv[i]);
+	}
+
+	MotionLibraryWriter theWriter;
+	if (!theWriter.open(argv[1]))
+		return -1;
+
+	int numSkipped = 0;
+	MotionLibraryWriter::Motion theMotion;
+	for (size_t i = 0; i < motionNames.size(); i++)
+	{
+		if (!MotionLibraryWriter::readMotion(motionNames[i].c_str(), theMotion))
+		{
+			opserr << "Could not read the motion " << motionNames[i].c_str() << ", skipped." << endln;
+			numSkipped++;
+			continue;
+		}
+
+		std::map<std::string, std::pair<double, double> >::const_iterator data = metadata.find(theMotion.id);
+		if (data != metadata.end())
+		{
+			theMotion.magnitude = data->second.first;
+			theMotion.distance = data->second.second;
+		}
+
+		if (!theWriter.addMotion(theMotion))
+			numSkipped++;
+	}
+
+	int numRecords = theWriter.close();
+	if (numRecords < 0)
+		return -1;
+
+	opserr << "Wrote " << numRecords << " records to " << argv[1];
+	if (numSkipped > 0)
+		opserr << ", skipped " << numSkipped;
+	opserr << endln;
+
+	return (numSkipped > 0) ? 1 : 0;
+}
@@ -0,0 +1,254 @@
+#include "ResultCache.h"
+#include "LayerDiff.h"
+#include "outcropMotion.h"
+#include "Vector.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(WIN32) || defined(_WIN32)
+#include <direct.h>
+#define PATH_SEPARATOR "\\"
+#else
+#define PATH_SEPARATOR "/"
+#endif
+
+static const char resultMagic[8] = {'S','R','T','R','S','L','T','1'};
+
+ResultCache::ResultCache(std::string dir, long long maxBytes)
+	: theDir(dir), theMaxBytes(maxBytes)
+{
+#if defined(WIN32) || defined(_WIN32)
+	_mkdir(theDir.c_str());
+#else
+	mkdir(theDir.c_str(), 0755);
+#endif
+}
+
+unsigned long long ResultCache::hashBytes(const void *data, size_t numBytes, unsigned long long seed)
+{
+	const unsigned char *bytes = (const unsigned char *)data;
+	unsigned long long hash = seed;
+	for (size_t i = 0; i < numBytes; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+unsigned long long ResultCache::makeKey(const json &config, OutcropMotion *motion, const std::string &engine)
+{
+	json canonical = config;
+	if (canonical.count("basicSettings"))
+	{
+		canonical["basicSettings"].erase("groundMotion");
+		canonical["basicSettings"].erase("OpenSeesPath");
+	}
+	if (canonical.count("soilProfile") && canonical["soilProfile"].count("soilLayers"))
+		for (auto &l : canonical["soilProfile"]["soilLayers"])
+			l.erase("color");
+
+	unsigned long long key = LayerDiff::hashValue(json(engine));
+	key = LayerDiff::hashValue(canonical, key);
+
+	if (motion != NULL)
+	{
+		int numSteps = motion->getNumSteps();
+		key = hashBytes(&numSteps, sizeof(numSteps), key);
+
+		// the points of each series the motion has, whichever of them it was
+		// read with
+		PathTimeSeries *series[3] = { motion->getAccSeries(), motion->getVelSeries(), motion->getDispSeries() };
+		for (int s = 0; s < 3; s++)
+		{
+			if (series[s] == NULL || series[s]->getPath() == NULL || series[s]->getTime() == NULL)
+				continue;
+			const Vector &path = *series[s]->getPath();
+			const Vector &time = *series[s]->getTime();
+			key = hashBytes(&s, sizeof(s), key);
+			for (int i = 0; i < path.Size(); i++)
+			{
+				double value = path(i);
+				key = hashBytes(&value, sizeof(double), key);
+			}
+			for (int i = 0; i < time.Size(); i++)
+			{
+				double t = time(i);
+				key = hashBytes(&t, sizeof(double), key);
+			}
+		}
+	}
+	return key;
+}
+
+std::string ResultCache::entryFile(unsigned long long key) const
+{
+	char name[32];
+	sprintf(name, "%016llx.result", key);
+	return theDir + PATH_SEPARATOR + name;
+}
+
+void ResultCache::readIndex(std::vector<Entry> &entries) const
+{
+	entries.clear();
+	std::ifstream index(theDir + PATH_SEPARATOR + "index");
+	std::string keyText;
+	long long size;
+	while (index >> keyText >> size)
+	{
+		Entry e;
+		e.key = strtoull(keyText.c_str(), NULL, 16);
+		e.size = size;
+		entries.push_back(e);
+	}
+}
+
+bool ResultCache::writeIndex(const std::vector<Entry> &entries) const
+{
+	std::string indexFile = theDir + PATH_SEPARATOR + "index";
+	std::string tmpFile = indexFile + ".tmp";
+	FILE *index = fopen(tmpFile.c_str(), "w");
+	if (index == NULL)
+		return false;
+	for (int i = 0; i < (int)entries.size(); i++)
+		fprintf(index, "%016llx %lld\n", entries[i].key, entries[i].size);
+	if (fclose(index) != 0)
+		return false;
+	remove(indexFile.c_str());
+	return rename(tmpFile.c_str(), indexFile.c_str()) == 0;
+}
+
+bool ResultCache::fetch(unsigned long long key, const std::vector<std::string> &dirs)
+{
+	std::vector<Entry> entries;
+	this->readIndex(entries);
+	int n = 0;
+	while (n < (int)entries.size() && entries[n].key != key)
+		n++;
+	if (n == (int)entries.size())
+		return false;
+
+	FILE *theFile = fopen(this->entryFile(key).c_str(), "rb");
+	char magic[sizeof(resultMagic)];
+	unsigned long long savedKey = 0;
+	int numFiles = 0;
+	bool ok = (theFile != NULL) &&
+		(fread(magic, sizeof(magic), 1, theFile) == 1) &&
+		(memcmp(magic, resultMagic, sizeof(magic)) == 0) &&
+		(fread(&savedKey, sizeof(savedKey), 1, theFile) == 1) && (savedKey == key) &&
+		(fread(&numFiles, sizeof(numFiles), 1, theFile) == 1);
+
+	std::vector<char> buffer;
+	for (int i = 0; ok && i < numFiles; i++)
+	{
+		int dir, nameLength;
+		long long size;
+		ok = (fread(&dir, sizeof(dir), 1, theFile) == 1) && (dir >= 0) && (dir < (int)dirs.size()) &&
+			(fread(&nameLength, sizeof(nameLength), 1, theFile) == 1) && (nameLength > 0) && (nameLength < 4096);
+		if (!ok)
+			break;
+		std::string name(nameLength, ' ');
+		ok = (fread(&name[0], 1, nameLength, theFile) == (size_t)nameLength) &&
+			(fread(&size, sizeof(size), 1, theFile) == 1) && (size >= 0);
+		if (!ok)
+			break;
+		buffer.resize(size);
+		ok = (size == 0) || (fread(&buffer[0], 1, size, theFile) == (size_t)size);
+		if (!ok)
+			break;
+
+		std::string outFile = dirs[dir] + PATH_SEPARATOR + name;
+		FILE *out = fopen(outFile.c_str(), "wb");
+		ok = (out != NULL) && ((size == 0) || (fwrite(&buffer[0], 1, size, out) == (size_t)size));
+		if (out != NULL)
+			ok = (fclose(out) == 0) && ok;
+	}
+	if (theFile != NULL)
+		fclose(theFile);
+
+	// a broken entry is dropped, the analysis runs again and stores a new one
+	Entry e = entries[n];
+	entries.erase(entries.begin() + n);
+	if (ok)
+		entries.push_back(e);
+	else
+		remove(this->entryFile(key).c_str());
+	this->writeIndex(entries);
+
+	return ok;
+}
+
+bool ResultCache::store(unsigned long long key, const std::vector<std::string> &dirs, const std::vector<File> &files)
+{
+	std::string fileName = this->entryFile(key);
+	std::string tmpFile = fileName + ".tmp";
+	FILE *theFile = fopen(tmpFile.c_str(), "wb");
+	if (theFile == NULL)
+		return false;
+
+	int numFiles = files.size();
+	bool ok = (fwrite(resultMagic, sizeof(resultMagic), 1, theFile) == 1) &&
+		(fwrite(&key, sizeof(key), 1, theFile) == 1) &&
+		(fwrite(&numFiles, sizeof(numFiles), 1, theFile) == 1);
+
+	std::vector<char> buffer;
+	for (int i = 0; ok && i < numFiles; i++)
+	{
+		std::ifstream in(dirs[files[i].dir] + PATH_SEPARATOR + files[i].name, std::ios::binary);
+		if (!in)
+		{
+			ok = false;
+			break;
+		}
+		buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		int nameLength = files[i].name.size();
+		long long size = buffer.size();
+		ok = (fwrite(&files[i].dir, sizeof(int), 1, theFile) == 1) &&
+			(fwrite(&nameLength, sizeof(nameLength), 1, theFile) == 1) &&
+			(fwrite(files[i].name.c_str(), 1, nameLength, theFile) == (size_t)nameLength) &&
+			(fwrite(&size, sizeof(size), 1, theFile) == 1) &&
+			((size == 0) || (fwrite(&buffer[0], 1, size, theFile) == (size_t)size));
+	}
+	long long entrySize = ftell(theFile);
+	ok = (fclose(theFile) == 0) && ok;
+
+	// an entry larger than the whole cache is not kept
+	if (!ok || entrySize > theMaxBytes)
+	{
+		remove(tmpFile.c_str());
+		return false;
+	}
+	remove(fileName.c_str());
+	if (rename(tmpFile.c_str(), fileName.c_str()) != 0)
+		return false;
+
+	std::vector<Entry> entries;
+	this->readIndex(entries);
+	for (int n = 0; n < (int)entries.size(); n++)
+		if (entries[n].key == key)
+			entries.erase(entries.begin() + n--);
+	Entry e;
+	e.key = key;
+	e.size = entrySize;
+	entries.push_back(e);
+
+	long long totalSize = 0;
+	for (int n = 0; n < (int)entries.size(); n++)
+		totalSize += entries[n].size;
+	int numDropped = 0;
+	while (totalSize > theMaxBytes)
+	{
+		totalSize -= entries[numDropped].size;
+		remove(this->entryFile(entries[numDropped].key).c_str());
+		numDropped++;
+	}
+	entries.erase(entries.begin(), entries.begin() + numDropped);
+
+	return this->writeIndex(entries);
+}
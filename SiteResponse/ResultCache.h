@@ -0,0 +1,61 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+class OutcropMotion;
+
+// Keeps the outputs of finished analyses so that an analysis of the same
+// profile and motion by the same engine is not run again. An entry is found
+// by a key hashing the configuration, the motion and the engine, and holds
+// the output files in a single file, <key>.result, in the cache directory.
+// The index file lists the entries from the least to the most recently used
+// with their sizes; when the cache grows past its size the least recently
+// used entries are dropped.
+class ResultCache {
+
+public:
+	// a file of an entry, a name in one of the directories given to
+	// fetch() and store()
+	struct File {
+		int dir;
+		std::string name;
+	};
+
+	ResultCache(std::string dir, long long maxBytes = 1LL << 30);
+
+	// the parts of the configuration that do not change the results (the
+	// colors of the layers, where the motion and OpenSees were read from)
+	// are left out of the key; the motion is hashed by its number of steps and
+	// the points of its series
+	static unsigned long long makeKey(const json &config, OutcropMotion *motion, const std::string &engine);
+	static unsigned long long hashBytes(const void *data, size_t numBytes, unsigned long long seed);
+
+	// copies the files of the entry of key into dirs and makes it the most
+	// recently used; returns false if there is no such entry
+	bool fetch(unsigned long long key, const std::vector<std::string> &dirs);
+	// keeps the files as the entry of key, and drops the least recently used
+	// entries until the cache fits in its size
+	bool store(unsigned long long key, const std::vector<std::string> &dirs, const std::vector<File> &files);
+
+	std::string getDir() const { return theDir; }
+	long long getMaxBytes() const { return theMaxBytes; }
+
+private:
+	struct Entry {
+		unsigned long long key;
+		long long size;
+	};
+
+	std::string entryFile(unsigned long long key) const;
+	void readIndex(std::vector<Entry> &entries) const;
+	bool writeIndex(const std::vector<Entry> &entries) const;
+
+	std::string theDir;
+	long long theMaxBytes;
+};
+
+#endif
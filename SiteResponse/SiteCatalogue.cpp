@@ -0,0 +1,322 @@
+#include "SiteCatalogue.h"
+#include "EffectiveFEModel.h"
+#include "MemoryStream.h"
+#include "ProfileStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+static const double gravity = 9.81;
+
+// the values of a line of a csv file, without the spaces and quotes around them
+static std::vector<std::string> splitCSV(const std::string &line)
+{
+	std::vector<std::string> values;
+	std::istringstream in(line);
+	std::string value;
+	while (std::getline(in, value, ','))
+	{
+		size_t first = value.find_first_not_of(" \t\r\"");
+		size_t last = value.find_last_not_of(" \t\r\"");
+		values.push_back((first == std::string::npos) ? std::string() : value.substr(first, last - first + 1));
+	}
+	return values;
+}
+
+// a number if the text is one, the text otherwise
+static json csvValue(const std::string &text)
+{
+	if (text.empty())
+		return json(text);
+	char *end;
+	if (text.find_first_of(".eE") == std::string::npos)
+	{
+		long value = strtol(text.c_str(), &end, 10);
+		if (*end == '\0')
+			return json(value);
+	}
+	double value = strtod(text.c_str(), &end);
+	if (*end == '\0')
+		return json(value);
+	return json(text);
+}
+
+SiteCatalogue::SiteCatalogue(const json &templateConfig)
+	: theTemplate(templateConfig)
+{
+	// the top soil layer and the rock of the template give the fields the
+	// layers of the catalogue leave out
+	json layers = json::array();
+	if (theTemplate.count("soilProfile") && theTemplate["soilProfile"].count("soilLayers"))
+		layers = theTemplate["soilProfile"]["soilLayers"];
+	std::sort(layers.begin(), layers.end(),
+		[](const json &a, const json &b) { return a["id"] < b["id"]; });
+	for (auto &l : layers)
+	{
+		bool isRock = l.count("name") && (l["name"] == "Rock");
+		if (isRock && theRockDefaults.is_null())
+			theRockDefaults = l;
+		else if (!isRock && theSoilDefaults.is_null())
+			theSoilDefaults = l;
+	}
+	if (theSoilDefaults.is_null())
+		theSoilDefaults = json::object();
+	theSoilDefaults.erase("id");
+	theSoilDefaults.erase("name");
+	if (!theRockDefaults.is_null())
+		theRockDefaults.erase("id");
+}
+
+bool SiteCatalogue::read(const std::string &fileName)
+{
+	theSites.clear();
+	theError.clear();
+
+	std::ifstream in(fileName.c_str());
+	if (!in.is_open())
+	{
+		theError = "Could not read the catalogue " + fileName;
+		return false;
+	}
+
+	std::string extension;
+	size_t dot = fileName.find_last_of('.');
+	if (dot != std::string::npos)
+		extension = fileName.substr(dot + 1);
+	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+	bool ok = (extension == "csv") ? this->readCSV(in) : this->readJSONLines(in);
+	if (ok && theSites.empty())
+	{
+		theError = "There are no sites in " + fileName;
+		ok = false;
+	}
+	return ok;
+}
+
+bool SiteCatalogue::readJSONLines(std::istream &in)
+{
+	std::string line;
+	for (int lineNumber = 1; std::getline(in, line); lineNumber++)
+	{
+		if (line.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+
+		json site;
+		try
+		{
+			site = json::parse(line);
+		}
+		catch (std::exception &e)
+		{
+			theError = "Line " + std::to_string(lineNumber) + " of the catalogue is not JSON: " + e.what();
+			return false;
+		}
+		if (!site.is_object())
+		{
+			theError = "Line " + std::to_string(lineNumber) + " of the catalogue is not a site";
+			return false;
+		}
+
+		std::string id = std::to_string(theSites.size() + 1);
+		if (site.count("id"))
+			id = site["id"].is_string() ? site["id"].get<std::string>() : site["id"].dump();
+		std::string motion = site.count("motion") ? site["motion"].get<std::string>() : std::string();
+
+		json layers;
+		if (site.count("soilLayers"))
+			layers = site["soilLayers"];
+		else if (site.count("soilProfile") && site["soilProfile"].count("soilLayers"))
+			layers = site["soilProfile"]["soilLayers"];
+		json settings = site.count("basicSettings") ? site["basicSettings"] : json::object();
+		json materials = site.count("materials") ? site["materials"] : json();
+
+		if (!this->addSite(id, motion, settings, layers, materials))
+			return false;
+	}
+	return true;
+}
+
+bool SiteCatalogue::readCSV(std::istream &in)
+{
+	std::string line;
+	std::vector<std::string> header;
+	while (header.empty() && std::getline(in, line))
+		if (line.find_first_not_of(" \t\r") != std::string::npos)
+			header = splitCSV(line);
+
+	int siteColumn = -1, motionColumn = -1;
+	for (int i = 0; i < (int)header.size(); i++)
+	{
+		if (header[i] == "site")
+			siteColumn = i;
+		else if (header[i] == "motion")
+			motionColumn = i;
+	}
+	if (siteColumn < 0)
+	{
+		theError = "The catalogue has no site column";
+		return false;
+	}
+
+	json settings = json::object();
+	if (theTemplate.count("basicSettings"))
+		settings = theTemplate["basicSettings"];
+
+	// the rows of a site are one after the other, a site ends where the
+	// next one starts
+	std::string id, motion;
+	json siteSettings, layers;
+	for (int lineNumber = 2; std::getline(in, line); lineNumber++)
+	{
+		if (line.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+		std::vector<std::string> values = splitCSV(line);
+		values.resize(header.size());
+		if (values[siteColumn].empty())
+		{
+			theError = "Line " + std::to_string(lineNumber) + " of the catalogue has no site";
+			return false;
+		}
+
+		if (values[siteColumn] != id)
+		{
+			if (!id.empty() && !this->addSite(id, motion, siteSettings, layers, json()))
+				return false;
+			id = values[siteColumn];
+			motion = (motionColumn >= 0) ? values[motionColumn] : std::string();
+			siteSettings = json::object();
+			for (int i = 0; i < (int)header.size(); i++)
+				if (settings.count(header[i]) && !values[i].empty())
+					siteSettings[header[i]] = csvValue(values[i]);
+			layers = json::array();
+		}
+
+		json layer = json::object();
+		for (int i = 0; i < (int)header.size(); i++)
+			if ((i != siteColumn) && (i != motionColumn) && !settings.count(header[i]) && !values[i].empty())
+				layer[header[i]] = csvValue(values[i]);
+		layers.push_back(layer);
+	}
+	if (!id.empty())
+		return this->addSite(id, motion, siteSettings, layers, json());
+	return true;
+}
+
+bool SiteCatalogue::addSite(std::string id, std::string motion, json settings, json layers, json materials)
+{
+	Site site;
+	site.id = id;
+	site.motion = motion;
+	site.config = theTemplate;
+
+	for (auto s = settings.begin(); s != settings.end(); ++s)
+		site.config["basicSettings"][s.key()] = s.value();
+	if (!materials.is_null())
+		site.config["materials"] = materials;
+
+	if (!layers.is_null())
+	{
+		if (!layers.is_array() || layers.empty())
+		{
+			theError = "Site " + id + " has no layers";
+			return false;
+		}
+
+		json profile = json::array();
+		for (int i = 0; i < (int)layers.size(); i++)
+		{
+			json layer = layers[i];
+			bool isRock = layer.count("name") && (layer["name"] == "Rock");
+			if (isRock && (i != (int)layers.size() - 1))
+			{
+				theError = "The rock of site " + id + " is not its last layer";
+				return false;
+			}
+			if (isRock && theRockDefaults.is_null())
+			{
+				theError = "The template has no rock for site " + id;
+				return false;
+			}
+			if (!layer.count("name"))
+				layer["name"] = "Layer " + std::to_string(i + 1);
+			const json &defaults = isRock ? theRockDefaults : theSoilDefaults;
+			for (auto d = defaults.begin(); d != defaults.end(); ++d)
+				if (!layer.count(d.key()))
+					layer[d.key()] = d.value();
+			profile.push_back(layer);
+		}
+		if (profile.back()["name"] != "Rock")
+		{
+			if (theRockDefaults.is_null())
+			{
+				theError = "The template has no rock for site " + id;
+				return false;
+			}
+			profile.push_back(theRockDefaults);
+		}
+
+		// the builder takes the layers from the largest id, the bottom, up
+		for (int i = 0; i < (int)profile.size(); i++)
+			profile[i]["id"] = i + 1;
+		site.config["soilProfile"]["soilLayers"] = profile;
+	}
+
+	// a material is the n-th of the list, the builder finds it by position
+	int numMaterials = site.config.count("materials") ? (int)site.config["materials"].size() : 0;
+	for (auto &l : site.config["soilProfile"]["soilLayers"])
+	{
+		if (!l.count("material") || !l["material"].is_number() ||
+			(l["material"].get<int>() < 1) || (l["material"].get<int>() > numMaterials))
+		{
+			theError = "A layer of site " + id + " has no material of the " + std::to_string(numMaterials) + " there are";
+			return false;
+		}
+	}
+
+	theSites.push_back(site);
+	return true;
+}
+
+bool SiteCatalogue::getMetrics(const SiteResponseModel &model, SiteMetrics &metrics)
+{
+	const MemoryStream *surfaceAcc = model.getOutput("surface.acc");
+	const MemoryStream *baseAcc = model.getOutput("base.acc");
+	const MemoryStream *surfaceDisp = model.getOutput("surface.disp");
+	const ProfileStream *stress = model.getProfile("stress.prof");
+	const ProfileStream *strain = model.getProfile("strain.prof");
+	if ((surfaceAcc == NULL) || (baseAcc == NULL) || (surfaceDisp == NULL) || (stress == NULL) || (strain == NULL) ||
+		(surfaceAcc->getNumRows() < 1) || (baseAcc->getNumRows() < 1) || (surfaceDisp->getNumRows() < 1) ||
+		(surfaceAcc->getNumColumns() < 2) || (baseAcc->getNumColumns() < 2) || (surfaceDisp->getNumColumns() < 3))
+		return false;
+
+	// the rows of the node outputs start with the time, then the horizontal
+	// and vertical dofs
+	metrics.surfacePGA = 0.0;
+	for (int i = 0; i < surfaceAcc->getNumRows(); i++)
+		metrics.surfacePGA = std::max(metrics.surfacePGA, fabs(surfaceAcc->getData()[i * surfaceAcc->getNumColumns() + 1]));
+	metrics.surfacePGA /= gravity;
+	metrics.basePGA = 0.0;
+	for (int i = 0; i < baseAcc->getNumRows(); i++)
+		metrics.basePGA = std::max(metrics.basePGA, fabs(baseAcc->getData()[i * baseAcc->getNumColumns() + 1]));
+	metrics.basePGA /= gravity;
+	metrics.amplification = (metrics.basePGA > 0.0) ? metrics.surfacePGA / metrics.basePGA : 0.0;
+
+	const double *disp = surfaceDisp->getData();
+	int lastRow = surfaceDisp->getNumRows() - 1;
+	metrics.settlement = disp[2] - disp[lastRow * surfaceDisp->getNumColumns() + 2];
+
+	// the elements give sxx, syy and sxy, and exx, eyy and gxy; ru is the
+	// drop of the vertical effective stress from its value after gravity
+	metrics.maxRu = 0.0;
+	for (int i = 1; i < stress->getNumColumns(); i += 3)
+		metrics.maxRu = std::max(metrics.maxRu, stress->getMaxDrop()(i));
+	metrics.maxStrain = 0.0;
+	for (int i = 2; i < strain->getNumColumns(); i += 3)
+		metrics.maxStrain = std::max(metrics.maxStrain, strain->getAbsMax()(i));
+
+	return true;
+}
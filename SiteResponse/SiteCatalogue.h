@@ -0,0 +1,83 @@
+#ifndef SITECATALOGUE_H
+#define SITECATALOGUE_H
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+class SiteResponseModel;
+
+// the summary of the analysis of a site, a few numbers that fit in a line
+// of a table: the peak accelerations (g) at the base and at the surface and
+// their ratio, the largest ru and shear strain of the elements, and the
+// settlement of the surface during the shaking (m). The settlement is the
+// drop of the surface from the first to the last step of the transient
+// analysis; it is a proxy, the reconsolidation after the shaking is not in it
+struct SiteMetrics {
+	double basePGA;
+	double surfacePGA;
+	double amplification;
+	double maxRu;
+	double maxStrain;
+	double settlement;
+};
+
+// A catalogue of sites, each a layered profile and the motion it is shaken
+// by. The sites start from a template configuration (an SRT.json) and
+// change what the catalogue gives for them, so a catalogue can be as short
+// as a layer table per site. It is read from
+//
+//  - JSON Lines, a site per line:
+//      {"id": "S1", "motion": "motions/M1", "basicSettings": {...},
+//       "soilLayers": [...], "materials": [...]}
+//    the settings are merged into the ones of the template, the layers and
+//    the materials, if given, replace them;
+//
+//  - CSV with a header, a layer per row and the rows of a site one after
+//    the other, from the top down. The "site" and "motion" columns name the
+//    site and its motion, a column named after one of the basicSettings of
+//    the template sets it for the site (from the first row of the site), and
+//    the others are fields of the layer ("thickness", "vs", "density",
+//    "material", "Dr", ...). The materials are the ones of the template.
+//
+// The layers are numbered from the top down, as the builder expects. A field
+// a layer does not give is the one of the first soil layer of the template,
+// or of its rock for the rock, and a profile that does not end with a layer
+// named "Rock" gets the rock of the template.
+class SiteCatalogue {
+
+public:
+	struct Site {
+		std::string id;
+		std::string motion;
+		json config;
+	};
+
+	SiteCatalogue(const json &templateConfig);
+
+	// reads the sites of a .csv file or, for any other name, of a JSON Lines
+	// file; returns false, with the reason in getError(), if it could not
+	bool read(const std::string &fileName);
+
+	int getNumSites() const { return theSites.size(); }
+	const Site &getSite(int i) const { return theSites[i]; }
+	std::string getError() const { return theError; }
+
+	// the summary of a site from the outputs of its analysis, which must have
+	// been kept in memory; returns false if they are not there
+	static bool getMetrics(const SiteResponseModel &model, SiteMetrics &metrics);
+
+private:
+	bool readJSONLines(std::istream &in);
+	bool readCSV(std::istream &in);
+	bool addSite(std::string id, std::string motion, json settings, json layers, json materials);
+
+	json theTemplate;
+	json theSoilDefaults;
+	json theRockDefaults;
+	std::vector<Site> theSites;
+	std::string theError;
+};
+
+#endif
@@ -0,0 +1,288 @@
+#include "SiteResponseAPI.h"
+#include "EffectiveFEModel.h"
+#include "outcropMotion.h"
+#include "MemoryStream.h"
+#include "ProfileStream.h"
+
+#include "DummyStream.h"
+#include "OPS_Stream.h"
+
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+// the log goes to the callback of the run, or nowhere
+DummyStream theDummyStream;
+OPS_Stream *opserrPtr = &theDummyStream;
+OPS_Stream *opsoutPtr = &theDummyStream;
+
+// the runs of all the models take turns
+static std::mutex theRunMutex;
+
+// An OPS_Stream that hands the log of a run to its callback a line at a
+// time, and keeps the last line as the error of a run that failed.
+class LogStream : public OPS_Stream
+{
+public:
+	LogStream(SRT_LogCallback callback, void *data) : OPS_Stream(0), theCallback(callback), theData(data) {}
+	~LogStream() { this->flushLine(); }
+
+	int tag(const char *) { return 0; }
+	int tag(const char *, const char *) { return 0; }
+	int endTag() { return 0; }
+	int attr(const char *name, int value) { return 0; }
+	int attr(const char *name, double value) { return 0; }
+	int attr(const char *name, const char *value) { return 0; }
+	int write(Vector &data) { return 0; }
+	int sendSelf(int commitTag, Channel &theChannel) { return 0; }
+	int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker) { return 0; }
+
+	OPS_Stream& write(const char *s, int n) { return this->add(std::string(s, n)); }
+	OPS_Stream& operator<<(char c) { return this->add(std::string(1, c)); }
+	OPS_Stream& operator<<(const char *s) { return this->add(s); }
+	OPS_Stream& operator<<(int n) { return this->format(n); }
+	OPS_Stream& operator<<(unsigned int n) { return this->format(n); }
+	OPS_Stream& operator<<(long n) { return this->format(n); }
+	OPS_Stream& operator<<(unsigned long n) { return this->format(n); }
+	OPS_Stream& operator<<(short n) { return this->format(n); }
+	OPS_Stream& operator<<(unsigned short n) { return this->format(n); }
+	OPS_Stream& operator<<(bool b) { return this->format(b); }
+	OPS_Stream& operator<<(double n) { return this->format(n); }
+	OPS_Stream& operator<<(float n) { return this->format(n); }
+
+	const std::string &getLastLine() const { return lastLine; }
+
+private:
+	template <class T> OPS_Stream& format(T value)
+	{
+		std::ostringstream text;
+		text << value;
+		return this->add(text.str());
+	}
+
+	OPS_Stream& add(const std::string &text)
+	{
+		for (size_t i = 0; i < text.size(); i++)
+		{
+			if (text[i] == '\n')
+				this->flushLine();
+			else
+				line += text[i];
+		}
+		return *this;
+	}
+
+	void flushLine()
+	{
+		if (line.empty())
+			return;
+		if (theCallback != NULL)
+			theCallback(line.c_str(), theData);
+		lastLine = line;
+		line.clear();
+	}
+
+	SRT_LogCallback theCallback;
+	void *theData;
+	std::string line;
+	std::string lastLine;
+};
+
+struct SRT_Model
+{
+	std::string config;
+	OutcropMotion *motion;
+	SiteResponseModel *model;
+	std::string algorithm;
+	double gamma;
+	double beta;
+	double dT;
+	std::string error;
+};
+
+int srt_api_version(void)
+{
+	return SRT_API_VERSION;
+}
+
+const char *srt_engine_version(void)
+{
+	return SRT_ENGINE_VERSION;
+}
+
+SRT_Model *srt_model_create(const char *configJSON, size_t length)
+{
+	if (configJSON == NULL)
+		return NULL;
+	std::string config(configJSON, length);
+	try
+	{
+		json::parse(config);
+	}
+	catch (std::exception &)
+	{
+		return NULL;
+	}
+
+	SRT_Model *theModel = new SRT_Model;
+	theModel->config = config;
+	theModel->motion = NULL;
+	theModel->model = NULL;
+	theModel->algorithm = "Newton";
+	theModel->gamma = 0.5;
+	theModel->beta = 0.25;
+	theModel->dT = 0.001;
+	return theModel;
+}
+
+void srt_model_destroy(SRT_Model *model)
+{
+	if (model == NULL)
+		return;
+	delete model->model;
+	delete model->motion;
+	delete model;
+}
+
+const char *srt_model_error(const SRT_Model *model)
+{
+	return (model != NULL) ? model->error.c_str() : "";
+}
+
+int srt_model_set_motion(SRT_Model *model, const double *time, const double *velocity, int numPoints)
+{
+	if (model == NULL)
+		return SRT_ERROR;
+
+	OutcropMotion *motion = new OutcropMotion();
+	motion->setMotion(time, velocity, numPoints);
+	if (!motion->isInitialized())
+	{
+		delete motion;
+		model->error = "A motion needs at least two points of time and velocity.";
+		return SRT_ERROR;
+	}
+
+	// the model of the last run goes with the motion it was made for
+	delete model->model;
+	model->model = NULL;
+	delete model->motion;
+	model->motion = motion;
+	return SRT_OK;
+}
+
+int srt_model_set_time_step(SRT_Model *model, double dT)
+{
+	if ((model == NULL) || !(dT > 0.0))
+		return SRT_ERROR;
+	model->dT = dT;
+	return SRT_OK;
+}
+
+int srt_model_set_integrator(SRT_Model *model, double gamma, double beta)
+{
+	if ((model == NULL) || !(gamma > 0.0) || !(beta > 0.0))
+		return SRT_ERROR;
+	model->gamma = gamma;
+	model->beta = beta;
+	return SRT_OK;
+}
+
+int srt_model_set_algorithm(SRT_Model *model, const char *name)
+{
+	if ((model == NULL) || (name == NULL))
+		return SRT_ERROR;
+	std::string algorithm(name);
+	if ((algorithm != "Newton") && (algorithm != "NewtonInitial"))
+	{
+		model->error = "Unknown algorithm " + algorithm;
+		return SRT_ERROR;
+	}
+	model->algorithm = algorithm;
+	return SRT_OK;
+}
+
+int srt_model_run(SRT_Model *model, SRT_ProgressCallback progress, SRT_LogCallback log, void *userData)
+{
+	if (model == NULL)
+		return SRT_ERROR;
+	if (model->motion == NULL)
+	{
+		model->error = "There is no motion to run the analysis with.";
+		return SRT_ERROR;
+	}
+
+	std::lock_guard<std::mutex> lock(theRunMutex);
+
+	// every run builds a model of its own, the outputs of the last one go with it
+	delete model->model;
+	model->model = new SiteResponseModel("2D", model->motion);
+	model->model->setConfig(model->config);
+	model->model->setOutputsInMemory(true);
+	model->model->setAlgorithm(model->algorithm);
+	model->model->setIntegrator(model->gamma, model->beta);
+	model->model->setTimeStep(model->dT);
+	model->model->setProgressCallback(progress, userData);
+
+	LogStream theLog(log, userData);
+	opserrPtr = &theLog;
+	int result;
+	try
+	{
+		result = model->model->buildEffectiveStressModel2D(true);
+	}
+	catch (std::exception &e)
+	{
+		theLog << "Site response analysis failed: " << e.what() << "\n";
+		result = SRT_ERROR;
+	}
+	theLog << "\n";
+	opserrPtr = &theDummyStream;
+
+	model->model->setProgressCallback(NULL, NULL);
+	if (result == 0)
+	{
+		model->error.clear();
+		return SRT_OK;
+	}
+	model->error = theLog.getLastLine();
+	return (result == -2) ? SRT_ABORTED : SRT_ERROR;
+}
+
+const double *srt_model_result(const SRT_Model *model, const char *name, int *numRows, int *numColumns)
+{
+	const MemoryStream *theOutput = NULL;
+	if ((model != NULL) && (model->model != NULL) && (name != NULL))
+		theOutput = model->model->getOutput(name);
+
+	if (numRows != NULL)
+		*numRows = (theOutput != NULL) ? theOutput->getNumRows() : 0;
+	if (numColumns != NULL)
+		*numColumns = (theOutput != NULL) ? theOutput->getNumColumns() : 0;
+	return (theOutput != NULL) ? theOutput->getData() : NULL;
+}
+
+int srt_model_profile(const SRT_Model *model, const char *name, double *values, int maxColumns)
+{
+	const ProfileStream *theProfile = NULL;
+	if ((model != NULL) && (model->model != NULL) && (name != NULL))
+		theProfile = model->model->getProfile(name);
+	if (theProfile == NULL)
+		return -1;
+
+	int numColumns = theProfile->getNumColumns();
+	for (int i = 0; (values != NULL) && (i < numColumns) && (i < maxColumns); i++)
+	{
+		values[6 * i] = theProfile->getMin()(i);
+		values[6 * i + 1] = theProfile->getMax()(i);
+		values[6 * i + 2] = theProfile->getAbsMax()(i);
+		values[6 * i + 3] = theProfile->getAbsMaxTime()(i);
+		values[6 * i + 4] = theProfile->getMaxGrowth()(i);
+		values[6 * i + 5] = theProfile->getMaxDrop()(i);
+	}
+	return numColumns;
+}
@@ -0,0 +1,84 @@
+#ifndef SITERESPONSEAPI_H
+#define SITERESPONSEAPI_H
+
+/*
+ * The C interface of libsiteresponse, for programs that run site response
+ * analyses in their own process. A model is made from the text of an
+ * SRT.json configuration and a motion given as arrays; it runs with no file
+ * read or written, and its outputs are then read as arrays named after the
+ * files the siteresponse program writes:
+ *
+ *   surface.acc, surface.vel, surface.disp, base.acc, base.vel, base.disp,
+ *   pwpLiq.out, displacement.out, velocity.out, acceleration.out,
+ *   porePressure.out, stress.out, strain.out
+ *
+ * with the time in the first column, and the envelopes displacement.prof,
+ * acceleration.prof, stress.prof and strain.prof.
+ *
+ * The engine keeps global state, so the runs of a process take turns; run
+ * sites in parallel in separate processes.
+ */
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#  if defined(SRT_BUILD_LIBRARY)
+#    define SRT_API __declspec(dllexport)
+#  else
+#    define SRT_API __declspec(dllimport)
+#  endif
+#else
+#  define SRT_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the version of this interface, changed when it changes */
+#define SRT_API_VERSION 1
+
+#define SRT_OK        0
+#define SRT_ERROR    -1
+#define SRT_ABORTED  -2
+
+typedef struct SRT_Model SRT_Model;
+
+/* called before every step of the analysis; returning anything but 0 stops it */
+typedef int (*SRT_ProgressCallback)(int step, int numSteps, double time, void *userData);
+/* called with every line of the log of the analysis */
+typedef void (*SRT_LogCallback)(const char *message, void *userData);
+
+SRT_API int srt_api_version(void);
+SRT_API const char *srt_engine_version(void);
+
+/* NULL if the text is not JSON */
+SRT_API SRT_Model *srt_model_create(const char *configJSON, size_t length);
+SRT_API void srt_model_destroy(SRT_Model *model);
+/* what went wrong in the last call that failed */
+SRT_API const char *srt_model_error(const SRT_Model *model);
+
+/* the velocity of the rock outcrop in m/s at the given times; the arrays are copied */
+SRT_API int srt_model_set_motion(SRT_Model *model, const double *time, const double *velocity, int numPoints);
+/* the settings of the analysis: the time step (0.001 s), the Newmark gamma
+   and beta (0.5, 0.25) and the algorithm, "Newton" or "NewtonInitial" */
+SRT_API int srt_model_set_time_step(SRT_Model *model, double dT);
+SRT_API int srt_model_set_integrator(SRT_Model *model, double gamma, double beta);
+SRT_API int srt_model_set_algorithm(SRT_Model *model, const char *name);
+
+/* SRT_OK, SRT_ERROR or SRT_ABORTED; the callbacks may be NULL */
+SRT_API int srt_model_run(SRT_Model *model, SRT_ProgressCallback progress, SRT_LogCallback log, void *userData);
+
+/* the rows of an output, row after row, or NULL if there is no such output;
+   the array is the model's and is there until the model runs again */
+SRT_API const double *srt_model_result(const SRT_Model *model, const char *name, int *numRows, int *numColumns);
+/* the number of columns of an envelope, -1 if there is no such envelope;
+   writes min, max, absMax, timeOfAbsMax, maxGrowth and maxDrop of at most
+   maxColumns columns to values */
+SRT_API int srt_model_profile(const SRT_Model *model, const char *name, double *values, int maxColumns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
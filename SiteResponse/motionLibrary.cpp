@@ -0,0 +1,481 @@
+#include "motionLibrary.h"
+#include "motionReader.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "OPS_Globals.h"
+
+#define MOTIONLIBRARY_VERSION   1
+#define MOTIONLIBRARY_BYTEORDER 0x01020304
+
+#define MOTIONLIBRARY_HAS_ACC   1
+#define MOTIONLIBRARY_HAS_VEL   2
+#define MOTIONLIBRARY_HAS_DISP  4
+#define MOTIONLIBRARY_UNIFORM   8
+
+static const char libraryMagic[8] = { 'S', 'R', 'T', 'M', 'L', 'I', 'B', '\0' };
+
+// the first 64 bytes of a library
+struct LibraryHeader
+{
+	char               magic[8];
+	unsigned int       version;
+	unsigned int       byteOrder;    // tells a file written on another byte order
+	unsigned int       numRecords;
+	unsigned int       entrySize;
+	unsigned long long indexOffset;
+	unsigned long long fileSize;
+	char               reserved[24];
+};
+
+MotionLibrary::MotionLibrary() :
+	m_data(NULL),
+	m_size(0),
+	m_numRecords(0),
+	m_index(NULL)
+#ifdef _WIN32
+	, m_file(NULL),
+	m_mapping(NULL)
+#endif
+{
+
+}
+
+MotionLibrary::MotionLibrary(const char* fName) :
+	m_data(NULL),
+	m_size(0),
+	m_numRecords(0),
+	m_index(NULL)
+#ifdef _WIN32
+	, m_file(NULL),
+	m_mapping(NULL)
+#endif
+{
+	this->open(fName);
+}
+
+MotionLibrary::~MotionLibrary()
+{
+	this->close();
+}
+
+int
+MotionLibrary::open(const char* fName)
+{
+	this->close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(fName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return -1;
+	LARGE_INTEGER fileSize;
+	HANDLE mapping = NULL;
+	const void* data = NULL;
+	if (GetFileSizeEx(file, &fileSize) && (fileSize.QuadPart > 0))
+		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping != NULL)
+		data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == NULL)
+	{
+		if (mapping != NULL)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		return -1;
+	}
+	m_file = file;
+	m_mapping = mapping;
+	m_size = (size_t)fileSize.QuadPart;
+#else
+	int file = ::open(fName, O_RDONLY);
+	if (file < 0)
+		return -1;
+	struct stat fileStat;
+	void* data = MAP_FAILED;
+	if ((fstat(file, &fileStat) == 0) && (fileStat.st_size > 0))
+		data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_SHARED, file, 0);
+	// the mapping stays valid once the file is closed
+	::close(file);
+	if (data == MAP_FAILED)
+		return -1;
+	m_size = (size_t)fileStat.st_size;
+#endif
+	m_data = (const char*)data;
+
+	// check that this is a library written on a machine like this one
+	const LibraryHeader* header = (const LibraryHeader*)m_data;
+	if ((m_size < sizeof(LibraryHeader)) ||
+		(memcmp(header->magic, libraryMagic, sizeof(libraryMagic)) != 0) ||
+		(header->version != MOTIONLIBRARY_VERSION) ||
+		(header->byteOrder != MOTIONLIBRARY_BYTEORDER) ||
+		(header->entrySize != sizeof(MotionLibraryWriter::Entry)) ||
+		(header->fileSize != m_size) ||
+		(header->indexOffset > m_size) ||
+		((m_size - header->indexOffset) / header->entrySize < header->numRecords))
+	{
+		opserr << "File " << fName << " is not a motion library." << endln;
+		this->close();
+		return -1;
+	}
+
+	m_numRecords = header->numRecords;
+	m_index = m_data + header->indexOffset;
+
+	return m_numRecords;
+}
+
+void
+MotionLibrary::close()
+{
+	if (m_data != NULL)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle((HANDLE)m_mapping);
+		CloseHandle((HANDLE)m_file);
+		m_file = NULL;
+		m_mapping = NULL;
+#else
+		munmap((void*)m_data, m_size);
+#endif
+	}
+
+	m_data = NULL;
+	m_size = 0;
+	m_numRecords = 0;
+	m_index = NULL;
+}
+
+bool
+MotionLibrary::getRecord(int i, MotionRecord& record) const
+{
+	if ((m_data == NULL) || (i < 0) || (i >= m_numRecords))
+		return false;
+
+	const MotionLibraryWriter::Entry& entry = ((const MotionLibraryWriter::Entry*)m_index)[i];
+
+	// the arrays have to lie between the header and the index
+	unsigned long long numArrays = 1;
+	for (unsigned int flag = MOTIONLIBRARY_HAS_ACC; flag <= MOTIONLIBRARY_HAS_DISP; flag <<= 1)
+		if (entry.flags & flag)
+			numArrays++;
+	unsigned long long dataEnd = (unsigned long long)(m_index - m_data);
+	if ((entry.id[sizeof(entry.id) - 1] != '\0') ||
+		(entry.dataOffset < sizeof(LibraryHeader)) || (entry.dataOffset % sizeof(double) != 0) ||
+		(entry.dataOffset > dataEnd) ||
+		((dataEnd - entry.dataOffset) / (numArrays * sizeof(double)) < entry.numPoints))
+	{
+		opserr << "Record " << i << " of the motion library is corrupt." << endln;
+		return false;
+	}
+
+	const double* data = (const double*)(m_data + entry.dataOffset);
+	record.id = entry.id;
+	record.numPoints = entry.numPoints;
+	record.dt = entry.dt;
+	record.uniform = ((entry.flags & MOTIONLIBRARY_UNIFORM) != 0);
+	record.pga = entry.pga;
+	record.magnitude = entry.magnitude;
+	record.distance = entry.distance;
+	record.time = data;
+	data += entry.numPoints;
+	record.acc = NULL;
+	record.vel = NULL;
+	record.disp = NULL;
+	if (entry.flags & MOTIONLIBRARY_HAS_ACC)
+	{
+		record.acc = data;
+		data += entry.numPoints;
+	}
+	if (entry.flags & MOTIONLIBRARY_HAS_VEL)
+	{
+		record.vel = data;
+		data += entry.numPoints;
+	}
+	if (entry.flags & MOTIONLIBRARY_HAS_DISP)
+		record.disp = data;
+
+	return true;
+}
+
+bool
+MotionLibrary::findRecord(const char* id, MotionRecord& record) const
+{
+	if (m_data == NULL)
+		return false;
+
+	// the index is sorted by ID
+	const MotionLibraryWriter::Entry* entries = (const MotionLibraryWriter::Entry*)m_index;
+	int low = 0;
+	int high = m_numRecords - 1;
+	while (low <= high)
+	{
+		int mid = low + (high - low) / 2;
+		int comp = strncmp(id, entries[mid].id, sizeof(entries[mid].id));
+		if (comp == 0)
+			return this->getRecord(mid, record);
+		if (comp < 0)
+			high = mid - 1;
+		else
+			low = mid + 1;
+	}
+
+	return false;
+}
+
+MotionLibraryWriter::MotionLibraryWriter() :
+	m_file(NULL),
+	m_offset(0)
+{
+
+}
+
+MotionLibraryWriter::~MotionLibraryWriter()
+{
+	if (m_file != NULL)
+		this->close();
+}
+
+bool
+MotionLibraryWriter::open(const char* fName)
+{
+	if (m_file != NULL)
+		this->close();
+
+	m_entries.clear();
+	m_ids.clear();
+
+	m_file = fopen(fName, "wb");
+	if (m_file == NULL)
+	{
+		opserr << "Could not open " << fName << " to write the motion library." << endln;
+		return false;
+	}
+
+	// room for the header, written when the index is
+	LibraryHeader header;
+	memset(&header, 0, sizeof(header));
+	if (fwrite(&header, sizeof(header), 1, m_file) != 1)
+	{
+		fclose(m_file);
+		m_file = NULL;
+		return false;
+	}
+	m_offset = sizeof(header);
+
+	return true;
+}
+
+bool
+MotionLibraryWriter::addMotion(const Motion& theMotion)
+{
+	if (m_file == NULL)
+		return false;
+
+	Entry entry;
+	memset(&entry, 0, sizeof(entry));
+	size_t numPoints = theMotion.time.size();
+
+	if (theMotion.id.empty() || (theMotion.id.size() >= sizeof(entry.id)))
+	{
+		opserr << "Motion ID \"" << theMotion.id.c_str() << "\" is empty or longer than " << int(sizeof(entry.id) - 1) << " characters." << endln;
+		return false;
+	}
+	if (m_ids.count(theMotion.id) > 0)
+	{
+		opserr << "Motion " << theMotion.id.c_str() << " is already in the library." << endln;
+		return false;
+	}
+	if ((numPoints == 0) ||
+		(!theMotion.acc.empty() && (theMotion.acc.size() != numPoints)) ||
+		(!theMotion.vel.empty() && (theMotion.vel.size() != numPoints)) ||
+		(!theMotion.disp.empty() && (theMotion.disp.size() != numPoints)) ||
+		(theMotion.acc.empty() && theMotion.vel.empty() && theMotion.disp.empty()))
+	{
+		opserr << "Motion " << theMotion.id.c_str() << " has no data or arrays of different sizes." << endln;
+		return false;
+	}
+
+	strncpy(entry.id, theMotion.id.c_str(), sizeof(entry.id) - 1);
+	entry.dataOffset = m_offset;
+	entry.numPoints = numPoints;
+	entry.magnitude = theMotion.magnitude;
+	entry.distance = theMotion.distance;
+
+	// the average time step, as OutcropMotion takes it
+	const std::vector<double>& time = theMotion.time;
+	if (theMotion.dt > 0.0)
+	{
+		entry.flags |= MOTIONLIBRARY_UNIFORM;
+		entry.dt = theMotion.dt;
+	}
+	else if (numPoints > 1)
+	{
+		std::vector<double> dt(numPoints);
+		std::adjacent_difference(time.begin(), time.end(), dt.begin());
+		entry.dt = std::accumulate(dt.begin() + 1, dt.end(), 0.0) / double(numPoints - 1);
+	}
+
+	// the peak acceleration, from the velocity if there is no acceleration
+	if (!theMotion.acc.empty())
+	{
+		for (size_t i = 0; i < numPoints; i++)
+			entry.pga = std::max(entry.pga, fabs(theMotion.acc[i]));
+	}
+	else if (!theMotion.vel.empty())
+	{
+		for (size_t i = 1; i < numPoints; i++)
+			if (time[i] > time[i - 1])
+				entry.pga = std::max(entry.pga, fabs(theMotion.vel[i] - theMotion.vel[i - 1]) / (time[i] - time[i - 1]) / 9.81);
+	}
+
+	bool ok = (fwrite(&time[0], sizeof(double), numPoints, m_file) == numPoints);
+	if (!theMotion.acc.empty())
+	{
+		entry.flags |= MOTIONLIBRARY_HAS_ACC;
+		ok = ok && (fwrite(&theMotion.acc[0], sizeof(double), numPoints, m_file) == numPoints);
+	}
+	if (!theMotion.vel.empty())
+	{
+		entry.flags |= MOTIONLIBRARY_HAS_VEL;
+		ok = ok && (fwrite(&theMotion.vel[0], sizeof(double), numPoints, m_file) == numPoints);
+	}
+	if (!theMotion.disp.empty())
+	{
+		entry.flags |= MOTIONLIBRARY_HAS_DISP;
+		ok = ok && (fwrite(&theMotion.disp[0], sizeof(double), numPoints, m_file) == numPoints);
+	}
+	if (!ok)
+	{
+		opserr << "Could not write motion " << theMotion.id.c_str() << " to the library." << endln;
+		return false;
+	}
+
+	unsigned long long numArrays = 1;
+	for (unsigned int flag = MOTIONLIBRARY_HAS_ACC; flag <= MOTIONLIBRARY_HAS_DISP; flag <<= 1)
+		if (entry.flags & flag)
+			numArrays++;
+	m_offset += numArrays * numPoints * sizeof(double);
+	m_entries.push_back(entry);
+	m_ids.insert(theMotion.id);
+
+	return true;
+}
+
+int
+MotionLibraryWriter::close()
+{
+	if (m_file == NULL)
+		return -1;
+
+	std::sort(m_entries.begin(), m_entries.end(),
+		[](const Entry& a, const Entry& b) { return strncmp(a.id, b.id, sizeof(a.id)) < 0; });
+
+	LibraryHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, libraryMagic, sizeof(libraryMagic));
+	header.version = MOTIONLIBRARY_VERSION;
+	header.byteOrder = MOTIONLIBRARY_BYTEORDER;
+	header.numRecords = m_entries.size();
+	header.entrySize = sizeof(Entry);
+	header.indexOffset = m_offset;
+	header.fileSize = m_offset + m_entries.size() * sizeof(Entry);
+
+	bool ok = true;
+	if (!m_entries.empty())
+		ok = (fwrite(&m_entries[0], sizeof(Entry), m_entries.size(), m_file) == m_entries.size());
+	ok = ok && (fseek(m_file, 0, SEEK_SET) == 0) && (fwrite(&header, sizeof(header), 1, m_file) == 1);
+	ok = (fclose(m_file) == 0) && ok;
+	m_file = NULL;
+
+	int numRecords = m_entries.size();
+	m_entries.clear();
+	m_ids.clear();
+
+	if (!ok)
+	{
+		opserr << "Could not write the index of the motion library." << endln;
+		return -1;
+	}
+	return numRecords;
+}
+
+bool
+MotionLibraryWriter::readMotion(const char* motionName, Motion& theMotion)
+{
+	theMotion = Motion();
+
+	std::string name(motionName);
+	size_t slash = name.find_last_of("/\\");
+	std::string baseName = (slash == std::string::npos) ? name : name.substr(slash + 1);
+	size_t dot = baseName.find_last_of('.');
+	std::string extension = (dot == std::string::npos) ? std::string() : baseName.substr(dot + 1);
+	for (size_t i = 0; i < extension.size(); i++)
+		extension[i] = tolower(extension[i]);
+
+	if (extension == "at2")
+	{
+		// the acceleration is in g's
+		double dt;
+		if (MotionReader::readAT2(motionName, theMotion.acc, dt) <= 0)
+			return false;
+		theMotion.time.resize(theMotion.acc.size());
+		for (size_t i = 0; i < theMotion.time.size(); i++)
+			theMotion.time[i] = i * dt;
+		theMotion.dt = dt;
+		theMotion.id = baseName.substr(0, dot);
+		return true;
+	}
+
+	if (extension == "bbp")
+	{
+		// time in the first column, velocity in cm/s in the second
+		std::vector<double> values;
+		int numColumns;
+		int numRows = MotionReader::readColumns(motionName, values, numColumns);
+		if ((numRows <= 0) || (numColumns < 2))
+			return false;
+		theMotion.time.resize(numRows);
+		theMotion.vel.resize(numRows);
+		for (int i = 0; i < numRows; i++)
+		{
+			theMotion.time[i] = values[i * numColumns];
+			theMotion.vel[i] = values[i * numColumns + 1] / 100.0;
+		}
+		theMotion.id = baseName.substr(0, dot);
+		return true;
+	}
+
+	// acceleration in g's, velocity in m/s and displacement in m; a file
+	// that is not there is left empty, one that is not a list of numbers
+	// fails the motion
+	const char* extensions[] = { ".time", ".acc", ".vel", ".disp" };
+	std::vector<double>* arrays[] = { &theMotion.time, &theMotion.acc, &theMotion.vel, &theMotion.disp };
+	for (int i = 0; i < 4; i++)
+	{
+		std::string fileName = name + extensions[i];
+		int badLine;
+		if (MotionReader::readValues(fileName.c_str(), *arrays[i], badLine) == -2)
+		{
+			opserr << "Line " << badLine << " of " << fileName.c_str() << " is not a list of numbers." << endln;
+			return false;
+		}
+	}
+	if (theMotion.time.empty())
+		return false;
+	theMotion.id = baseName;
+
+	return !theMotion.acc.empty() || !theMotion.vel.empty() || !theMotion.disp.empty();
+}
@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+#ifndef MOTIONLIBRARY_H
+#define MOTIONLIBRARY_H
+
+// A motion library is a single binary file holding a suite of ground motions
+// ready to be used without parsing. The file starts with a header, followed
+// by the data of the records, each an array of time values and the arrays of
+// acceleration (g), velocity (m/s) and displacement (m) stored for it, all as
+// native doubles, and ends with an index of fixed size entries sorted by
+// record ID. Opening a library maps the file read-only into memory, so the
+// arrays of a record are used where they lie and one open library can be
+// shared by any number of threads.
+
+// a record of an open library; the arrays point into the mapped file
+struct MotionRecord
+{
+	const char*   id;
+	int           numPoints;
+	double        dt;          // average time step
+	bool          uniform;     // time is i*dt, e.g. read from a .at2 file
+	double        pga;         // peak ground acceleration in g
+	double        magnitude;   // 0 if not known
+	double        distance;    // in km, 0 if not known
+	const double* time;
+	const double* acc;         // NULL if the record has no acceleration
+	const double* vel;         // NULL if the record has no velocity
+	const double* disp;        // NULL if the record has no displacement
+};
+
+class MotionLibrary
+{
+public:
+	MotionLibrary();
+	MotionLibrary(const char* fName);
+	~MotionLibrary();
+
+	// maps the library. Returns the number of records or -1 if the file
+	// could not be opened or is not a motion library
+	int  open(const char* fName);
+	void close();
+
+	bool isOpen() const { return (m_data != NULL); };
+	int  getNumRecords() const { return m_numRecords; };
+
+	// record i in the order of the index, i.e. sorted by ID
+	bool getRecord(int i, MotionRecord& record) const;
+	bool findRecord(const char* id, MotionRecord& record) const;
+
+private:
+	MotionLibrary(const MotionLibrary&);
+	MotionLibrary& operator=(const MotionLibrary&);
+
+	const char* m_data;
+	size_t      m_size;
+	int         m_numRecords;
+	const char* m_index;
+#ifdef _WIN32
+	void*       m_file;
+	void*       m_mapping;
+#endif
+};
+
+// writes a motion library one record at a time; only the index is kept in
+// memory until close()
+class MotionLibraryWriter
+{
+public:
+	// a motion in the units of the library
+	struct Motion
+	{
+		std::string         id;
+		double              dt;          // > 0 if time is i*dt
+		double              magnitude;
+		double              distance;
+		std::vector<double> time;
+		std::vector<double> acc;
+		std::vector<double> vel;
+		std::vector<double> disp;
+
+		Motion() : dt(0.0), magnitude(0.0), distance(0.0) {};
+	};
+
+	MotionLibraryWriter();
+	~MotionLibraryWriter();
+
+	bool open(const char* fName);
+	bool addMotion(const Motion& theMotion);
+	// writes the index. Returns the number of records written or -1
+	int  close();
+
+	// reads a motion named the way OutcropMotion::setMotion() takes it: a
+	// PEER NGA .at2 file, a .bbp file, or the base name of the .time, .acc,
+	// .vel and .disp files. The ID is the file name without its directory
+	// and the .at2 or .bbp extension
+	static bool readMotion(const char* motionName, Motion& theMotion);
+
+private:
+	struct Entry
+	{
+		char               id[64];
+		unsigned long long dataOffset;
+		unsigned int       numPoints;
+		unsigned int       flags;
+		double             dt;
+		double             pga;
+		double             magnitude;
+		double             distance;
+		double             reserved[2];
+	};
+
+	FILE*                 m_file;
+	unsigned long long    m_offset;
+	std::vector<Entry>    m_entries;
+	std::set<std::string> m_ids;
+
+	friend class MotionLibrary;
+};
+
+#endif
@@ -0,0 +1,354 @@
+#include "motionReader.h"
+#include <cstdio>
+#include <cstdlib>
+#include <clocale>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <locale>
+
+// powers of ten that are exact as doubles
+static const double exactPowers[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static bool isSeparator(char c)
+{
+	return (c == ' ') || (c == '\t') || (c == ',') || (c == '\r');
+}
+
+bool
+MotionReader::readFile(const char* fName, std::vector<char>& buffer)
+{
+	buffer.clear();
+	FILE* file = fopen(fName, "rb");
+	if (file == NULL)
+		return false;
+
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	if (size > 0)
+	{
+		buffer.resize(size);
+		size_t numRead = fread(&buffer[0], 1, size, file);
+		buffer.resize(numRead);
+	}
+	fclose(file);
+
+	return true;
+}
+
+const char*
+MotionReader::nextLine(const char* p, const char* end)
+{
+	const char* eol = (const char*)memchr(p, '\n', end - p);
+	return (eol == NULL) ? end : eol + 1;
+}
+
+// When the digits fit in the 53 bits of a double and the power of ten is
+// exact, a single multiply or divide gives the correctly rounded value;
+// anything else, nan and inf included, goes through the library with a '.'
+// decimal point.
+bool
+MotionReader::parseNumber(const char*& p, const char* end, double& value)
+{
+	const char* start = p;
+	const char* q = p;
+
+	bool negative = false;
+	if ((q < end) && ((*q == '-') || (*q == '+')))
+	{
+		negative = (*q == '-');
+		q++;
+	}
+
+	unsigned long long mantissa = 0;
+	int numDigits = 0;
+	int numSignificant = 0;
+	int exponent = 0;
+
+	while ((q < end) && (*q >= '0') && (*q <= '9'))
+	{
+		if ((numSignificant > 0) || (*q != '0'))
+		{
+			if (numSignificant < 19)
+				mantissa = mantissa * 10 + (*q - '0');
+			else
+				exponent++;
+			numSignificant++;
+		}
+		numDigits++;
+		q++;
+	}
+	if ((q < end) && (*q == '.'))
+	{
+		q++;
+		while ((q < end) && (*q >= '0') && (*q <= '9'))
+		{
+			if ((numSignificant > 0) || (*q != '0'))
+			{
+				if (numSignificant < 19)
+				{
+					mantissa = mantissa * 10 + (*q - '0');
+					exponent--;
+				}
+				numSignificant++;
+			}
+			else
+				exponent--;
+			numDigits++;
+			q++;
+		}
+	}
+
+	if (numDigits == 0)
+	{
+		// not a number unless the library reads it, as nan or inf
+		while ((q < end) && !isSeparator(*q) && (*q != '\n'))
+			q++;
+	}
+	else if ((q < end) && ((*q == 'e') || (*q == 'E') || (*q == 'd') || (*q == 'D')))
+	{
+		const char* e = q + 1;
+		bool negativeExp = false;
+		if ((e < end) && ((*e == '-') || (*e == '+')))
+		{
+			negativeExp = (*e == '-');
+			e++;
+		}
+		if ((e < end) && (*e >= '0') && (*e <= '9'))
+		{
+			int exp = 0;
+			while ((e < end) && (*e >= '0') && (*e <= '9'))
+			{
+				if (exp < 100000)
+					exp = exp * 10 + (*e - '0');
+				e++;
+			}
+			exponent += negativeExp ? -exp : exp;
+			q = e;
+		}
+	}
+
+	if ((q < end) && !isSeparator(*q) && (*q != '\n'))
+		return false;
+
+	if ((numDigits > 0) && (mantissa == 0))
+	{
+		value = negative ? -0.0 : 0.0;
+		p = q;
+		return true;
+	}
+
+	if ((numDigits > 0) && (numSignificant <= 19) && (mantissa <= (1ULL << 53)) && (exponent >= -22) && (exponent <= 22))
+	{
+		value = (double)mantissa;
+		if (exponent < 0)
+			value /= exactPowers[-exponent];
+		else
+			value *= exactPowers[exponent];
+		if (negative)
+			value = -value;
+		p = q;
+		return true;
+	}
+
+	std::string token(start, q);
+	for (size_t i = 0; i < token.size(); i++)
+		if ((token[i] == 'd') || (token[i] == 'D'))
+			token[i] = 'e';
+
+	// strtod follows the C locale, which a GUI may have changed
+	bool pointIsDecimal = (localeconv()->decimal_point[0] == '.');
+	if (pointIsDecimal)
+	{
+		char* tokenEnd;
+		value = strtod(token.c_str(), &tokenEnd);
+		if (token.empty() || (*tokenEnd != '\0'))
+			return false;
+	}
+	else
+	{
+		std::istringstream number(token);
+		number.imbue(std::locale::classic());
+		number >> value;
+		if (number.fail() || (number.peek() != EOF))
+			return false;
+	}
+	p = q;
+	return true;
+}
+
+int
+MotionReader::readValues(const char* fName, std::vector<double>& values, int& badLine)
+{
+	values.clear();
+	badLine = 0;
+	std::vector<char> buffer;
+	if (!readFile(fName, buffer))
+		return -1;
+
+	const char* p = buffer.empty() ? NULL : &buffer[0];
+	const char* end = p + buffer.size();
+	values.reserve(buffer.size() / 8);
+
+	for (int line = 1; p < end; line++)
+	{
+		const char* eol = nextLine(p, end);
+		if ((*p == '#') || (*p == '%'))
+		{
+			p = eol;
+			continue;
+		}
+
+		double value;
+		while (p < eol)
+		{
+			while ((p < eol) && (isSeparator(*p) || (*p == '\n')))
+				p++;
+			if (p == eol)
+				break;
+			if (!parseNumber(p, eol, value))
+			{
+				badLine = line;
+				return -2;
+			}
+			values.push_back(value);
+		}
+	}
+
+	return values.size();
+}
+
+int
+MotionReader::readColumns(const char* fName, std::vector<double>& values, int& numColumns)
+{
+	values.clear();
+	numColumns = 0;
+	std::vector<char> buffer;
+	if (!readFile(fName, buffer))
+		return -1;
+
+	const char* p = buffer.empty() ? NULL : &buffer[0];
+	const char* end = p + buffer.size();
+	std::vector<double> row;
+	int numRows = 0;
+
+	while (p < end)
+	{
+		const char* eol = nextLine(p, end);
+		if ((*p == '#') || (*p == '%'))
+		{
+			p = eol;
+			continue;
+		}
+
+		row.clear();
+		double value;
+		while (p < eol)
+		{
+			while ((p < eol) && (isSeparator(*p) || (*p == '\n')))
+				p++;
+			if ((p == eol) || !parseNumber(p, eol, value))
+				break;
+			row.push_back(value);
+		}
+		p = eol;
+
+		if (row.empty())
+			continue;
+		if (numColumns == 0)
+		{
+			numColumns = row.size();
+			values.reserve(buffer.size() / (8 * numColumns) * numColumns);
+		}
+		if ((int)row.size() < numColumns)
+			continue;
+
+		values.insert(values.end(), row.begin(), row.begin() + numColumns);
+		numRows++;
+	}
+
+	return numRows;
+}
+
+int
+MotionReader::readAT2(const char* fName, std::vector<double>& acc, double& dt)
+{
+	acc.clear();
+	dt = 0.0;
+	std::vector<char> buffer;
+	if (!readFile(fName, buffer))
+		return -1;
+
+	const char* p = buffer.empty() ? NULL : &buffer[0];
+	const char* end = p + buffer.size();
+
+	// skip the first three header lines
+	for (int i = 0; (i < 3) && (p < end); i++)
+		p = nextLine(p, end);
+	if (p >= end)
+		return -1;
+
+	// the fourth line is either "NPTS=  5590, DT=   .0050 SEC" (NGA West2)
+	// or "  5590    .0050    NPTS, DT" (older PEER)
+	const char* eol = nextLine(p, end);
+	std::string header(p, eol);
+	int numPoints = -1;
+	double values[2];
+	int numValues = 0;
+
+	size_t nptsLoc = header.find("NPTS=");
+	size_t dtLoc = header.find("DT=");
+	if ((nptsLoc != std::string::npos) && (dtLoc != std::string::npos))
+	{
+		const char* q = header.c_str() + nptsLoc + 5;
+		const char* qEnd = header.c_str() + header.size();
+		while ((q < qEnd) && (*q == ' '))
+			q++;
+		if (parseNumber(q, qEnd, values[0]))
+			numValues++;
+		q = header.c_str() + dtLoc + 3;
+		while ((q < qEnd) && (*q == ' '))
+			q++;
+		if (parseNumber(q, qEnd, values[1]))
+			numValues++;
+	}
+	else
+	{
+		const char* q = p;
+		while ((q < eol) && (numValues < 2))
+		{
+			while ((q < eol) && (isSeparator(*q) || (*q == '\n')))
+				q++;
+			if ((q == eol) || !parseNumber(q, eol, values[numValues]))
+				break;
+			numValues++;
+		}
+	}
+
+	if (numValues < 2)
+		return -1;
+	numPoints = (int)values[0];
+	dt = values[1];
+	if ((numPoints < 0) || (dt <= 0.0))
+		return -1;
+
+	// then the acceleration, any number of values per line
+	p = eol;
+	acc.reserve(numPoints);
+	double value;
+	while ((p < end) && ((int)acc.size() < numPoints))
+	{
+		while ((p < end) && (isSeparator(*p) || (*p == '\n')))
+			p++;
+		if ((p == end) || !parseNumber(p, end, value))
+			break;
+		acc.push_back(value);
+	}
+
+	return acc.size();
+}
@@ -0,0 +1,40 @@
+#include <vector>
+
+#ifndef MOTIONREADER_H
+#define MOTIONREADER_H
+
+// Reads ground motion files in one go: the whole file is read into memory
+// with a single call and the numbers are parsed straight out of the buffer,
+// without a stream or a string per line, and the arrays grow with the data.
+// Lines starting with # or % are comments. Numbers are always read with a
+// '.' as the decimal point whatever the locale.
+class MotionReader
+{
+public:
+	// all the numbers in the file, row after row. Returns the number of
+	// values read, -1 if the file could not be opened or -2 if something
+	// other than a number is found, in which case badLine is its line
+	static int readValues(const char* fName, std::vector<double>& values, int& badLine);
+
+	// the rows of a file of columns. numColumns is taken from the first row,
+	// rows with fewer values are skipped and extra values are dropped.
+	// Returns the number of rows read or -1 if the file could not be opened
+	static int readColumns(const char* fName, std::vector<double>& values, int& numColumns);
+
+	// a PEER NGA .AT2 file: four header lines, the fourth giving NPTS and DT,
+	// followed by the acceleration in g. Returns the number of points read
+	// or -1 if the file could not be opened or the header is not understood
+	static int readAT2(const char* fName, std::vector<double>& acc, double& dt);
+
+	// parses the number at p, which ends at end or at a space, tab, comma
+	// or line break, and moves p past it. Returns false, with p left where
+	// it is, if there is no number there. The result files of the UI are
+	// read with it too
+	static bool parseNumber(const char*& p, const char* end, double& value);
+
+private:
+	static bool readFile(const char* fName, std::vector<char>& buffer);
+	static const char* nextLine(const char* p, const char* end);
+};
+
+#endif
@@ -15,58 +15,38 @@
 
 #include "outcropMotion.h"
 #include <string>
-#include <fstream>
-#include <sstream>
+#include <cctype>
 #include <numeric>
 
 #include "Vector.h"
+#include "motionReader.h"
+#include "motionLibrary.h"
 
-bool fileExists(const char* fileName)
+// the time steps between the points of a time array
+int readDT(const std::vector<double>& time, int& numSteps, std::vector<double>& dt)
 {
-	// open the file to see if it exists
-	std::ifstream file(fileName);
-	if (file)
-		return true;
+	numSteps = 0;
+	if (time.size() < 1)
+		return -1;
 
-	return false;
+	dt.reserve(dt.size() + time.size() - 1);
+	for (size_t i = 1; i < time.size(); i++)
+	{
+		dt.push_back(time[i] - time[i - 1]);
+		++numSteps;
+	}
+	return 1;
 }
 
-int readDT(const char* fileName, int& numSteps, std::vector<double>& dt)
+// the values of one of the files of a motion; a file that is there but is
+// not a list of numbers is reported and gives -2
+static int readMotionFile(const std::string& fName, std::vector<double>& values)
 {
-	int res = -1;
-	numSteps = 0;
-	std::ifstream file(fileName);
-	if (file)
-	{
-		std::string line;
-		res = 1;
-		double t_n, t_n1;
-
-		// find the first non-empty line
-		while (getline(file, line))
-		{
-			// skip comment lines
-			if ((line == "") || (line[0] == '%') || (line[0] == '#'))
-				continue;
-			std::istringstream lines(line);
-			lines >> t_n;
-			break;
-		}
-
-		// count number of lines and calculate the dt for each step
-		while (getline(file, line))
-		{
-			// skip comment lines
-			if ((line == "") || (line[0] == '%') || (line[0] == '#'))
-				continue;
-			std::istringstream lines(line);
-            lines >> t_n1;
-			dt.push_back(t_n1 - t_n);
-			t_n = t_n1;
-			++numSteps;
-		}
-	}
-	return res;
+	int badLine;
+	int numValues = MotionReader::readValues(fName.c_str(), values, badLine);
+	if (numValues == -2)
+		opserr << "Line " << badLine << " of " << fName.c_str() << " is not a list of numbers." << endln;
+	return numValues;
 }
 
 OutcropMotion::OutcropMotion() :
@@ -91,42 +71,123 @@ OutcropMotion::OutcropMotion(const char* fName):
 	this->setMotion(fName);
 }
 
+OutcropMotion::OutcropMotion(const MotionLibrary& theLibrary, const char* recordID):
+	theGroundMotion(NULL),
+	theAccSeries(),
+	theVelSeries(),
+	theDispSeries(),
+	isThisInitialized(false),
+	m_numSteps(0)
+{
+	this->setLibraryMotion(theLibrary, recordID);
+}
+
 OutcropMotion::~OutcropMotion() 
 {
+	this->clearMotion();
+}
 
+void
+OutcropMotion::clearMotion()
+{
+	// the ground motion deletes the series it was given
+	if (theGroundMotion != NULL)
+		delete theGroundMotion;
+	else
+	{
+		delete theAccSeries;
+		delete theVelSeries;
+		delete theDispSeries;
+	}
+	theGroundMotion = NULL;
+	theAccSeries = NULL;
+	theVelSeries = NULL;
+	theDispSeries = NULL;
+
+	m_numSteps = 0;
+	m_dt.clear();
+	m_dt_avg = 0.0;
+}
+
+void
+OutcropMotion::integrateAcceleration()
+{
+	if ((theVelSeries != NULL) || (theAccSeries == NULL) || (theAccSeries->getTime() == NULL))
+		return;
+
+	// trapezoidal rule over the points of the record, from rest
+	const Vector& Time = *theAccSeries->getTime();
+	Vector Path(Time.Size());
+	double accPrev = theAccSeries->getFactor(Time(0));
+	for (int i = 1; i < Time.Size(); i++)
+	{
+		double acc = theAccSeries->getFactor(Time(i));
+		Path(i) = Path(i - 1) + 0.5 * (acc + accPrev) * (Time(i) - Time(i - 1));
+		accPrev = acc;
+	}
+	theVelSeries = new PathTimeSeries(2, Path, Time, 1.0, true);
 }
 
 void
 OutcropMotion::setMotion(const char* fName)
 {
+	this->clearMotion();
 	isThisInitialized = true;
 
-	// assuming time, displacement, velocity and acceleration are located in different files
+	// PEER NGA and BBP records are read directly
 	std::string motionName(fName);
+	std::string extension = motionName.substr(motionName.find_last_of('.') + 1);
+	for (size_t i = 0; i < extension.size(); i++)
+		extension[i] = tolower(extension[i]);
+	if ((motionName.find('.') != std::string::npos) && (extension == "at2"))
+	{
+		this->setAT2Motion(fName);
+		return;
+	}
+	if ((motionName.find('.') != std::string::npos) && (extension == "bbp"))
+	{
+		this->setBBPMotion(fName, 1);
+		return;
+	}
+
+	// assuming time, displacement, velocity and acceleration are located in different files
 	std::string timeFName = motionName + ".time";
 	std::string accFName = motionName + ".acc";
 	std::string velFName = motionName + ".vel";
 	std::string dispFName = motionName + ".disp";
 
 	// check to see if the time file exists
-	if (readDT(timeFName.c_str(), m_numSteps, m_dt) > 0)
+	std::vector<double> time;
+	std::vector<double> path;
+	if ((readMotionFile(timeFName, time) >= 0) && (readDT(time, m_numSteps, m_dt) > 0))
     {
         if (m_dt.size()>0)
             this->m_dt_avg = std::accumulate( m_dt.begin(), m_dt.end(), 0.0)/ double(m_dt.size());
+		Vector Time(&time[0], time.size());
+
 		// assuming acceleration is in g's
-		if (fileExists(accFName.c_str()))
-			theAccSeries = new PathTimeSeries(1, accFName.c_str(), timeFName.c_str(), 9.81, true);
+		int numAcc = readMotionFile(accFName, path);
+		if (numAcc > 0)
+			theAccSeries = new PathTimeSeries(1, Vector(&path[0], path.size()), Time, 9.81, true);
 
 		// assuming velocity is in m/s
-		if (fileExists(velFName.c_str()))
-			theVelSeries = new PathTimeSeries(2, velFName.c_str(), timeFName.c_str(), 1.0, true);
+		int numVel = readMotionFile(velFName, path);
+		if (numVel > 0)
+			theVelSeries = new PathTimeSeries(2, Vector(&path[0], path.size()), Time, 1.0, true);
 
 		// assuming displcement is in m
-		if (fileExists(dispFName.c_str()))
-			theDispSeries = new PathTimeSeries(3, dispFName.c_str(), timeFName.c_str(), 1.0, true);
+		int numDisp = readMotionFile(dispFName, path);
+		if (numDisp > 0)
+			theDispSeries = new PathTimeSeries(3, Vector(&path[0], path.size()), Time, 1.0, true);
 
+		// a motion given by its acceleration only is applied as a velocity
+		this->integrateAcceleration();
+
+		// a file that could not be read leaves the motion unusable
+		if ((numAcc == -2) || (numVel == -2) || (numDisp == -2))
+			isThisInitialized = false;
 		// create a ground motion. It's useful for UniformExcitatpon or MultipleSupport 
-		if ((theAccSeries != NULL) || (theVelSeries != NULL) || (theDispSeries != NULL))
+		else if ((theAccSeries != NULL) || (theVelSeries != NULL) || (theDispSeries != NULL))
 			theGroundMotion = new GroundMotion(theDispSeries, theVelSeries, theAccSeries, NULL);
 		else
 		{
@@ -141,53 +202,60 @@ OutcropMotion::setMotion(const char* fName)
                 //opserr << "The file " << timeFName.c_str() << " containing the array of time does not exist." << endln;
 	}
 }
-void                
-OutcropMotion::setBBPMotion(const char* fName, int colNum)
+
+void
+OutcropMotion::setAT2Motion(const char* fName)
 {
-	Vector Path(100000);
-	Vector Time(100000);
-	m_numSteps = 0;
-	std::ifstream file(fName);
-	if (file)
+	std::vector<double> acc;
+	double dt;
+	this->clearMotion();
+	if (MotionReader::readAT2(fName, acc, dt) > 0)
 	{
-		std::string line;
-		double t_n, t_n1;
-		double dummy;
+		Vector Path(&acc[0], acc.size());
+		Vector Time(acc.size());
+		for (int i = 0; i < Time.Size(); i++)
+			Time(i) = i * dt;
+		m_dt.assign(acc.size() - 1, dt);
+		m_numSteps = acc.size() - 1;
+		m_dt_avg = dt;
 
-		// find the first non-empty line
-		while (getline(file, line))
-		{
-			// skip comment lines
-			if ((line == "") || (line[0] == '%') || (line[0] == '#'))
-				continue;
-			std::istringstream lines(line);
-			lines >> t_n;
-			for (int ii = 0; ii < colNum - 1; ii++)
-				lines >> dummy;
-			lines >> Path(0);
-			break;
-		}
+		// the acceleration is in g's
+		theAccSeries = new PathTimeSeries(1, Path, Time, 9.81, true);
+		this->integrateAcceleration();
+		theGroundMotion = new GroundMotion(theDispSeries, theVelSeries, theAccSeries, NULL);
+		isThisInitialized = true;
+	}
+	else {
+		isThisInitialized = false;
+		opserr << "File " << fName << " does not exist or is not a PEER NGA record." << endln;
+	}
+}
 
-		// count number of lines and calculate the dt for each step
-		while (getline(file, line))
+void                
+OutcropMotion::setBBPMotion(const char* fName, int colNum)
+{
+	std::vector<double> values;
+	int numColumns;
+	this->clearMotion();
+	int numRows = MotionReader::readColumns(fName, values, numColumns);
+	if (numRows >= 0)
+	{
+		// time in the first column, velocity in cm/s in column colNum
+		if ((numRows > 0) && (colNum < numColumns))
 		{
-			// skip comment lines
-			if ((line == "") || (line[0] == '%') || (line[0] == '#'))
-				continue;
-			std::istringstream lines(line);
-			lines >> t_n1;
-			m_dt.push_back(t_n1 - t_n);
-			t_n = t_n1;
-			++m_numSteps;
-			for (int ii = 0; ii < colNum - 1; ii++)
-				lines >> dummy;
-			lines >> dummy;
-			Path(m_numSteps) = dummy / 100.0;
-			Time(m_numSteps) = t_n1;
+			std::vector<double> time(numRows);
+			Vector Path(numRows);
+			for (int i = 0; i < numRows; i++)
+			{
+				time[i] = values[i * numColumns];
+				Path(i) = values[i * numColumns + colNum] / 100.0;
+			}
+			Vector Time(&time[0], numRows);
+			readDT(time, m_numSteps, m_dt);
+			if (m_dt.size() > 0)
+				m_dt_avg = std::accumulate(m_dt.begin(), m_dt.end(), 0.0) / double(m_dt.size());
+			theVelSeries = new PathTimeSeries(2, Path, Time, 1.0, false);
 		}
-		Path.resize(m_numSteps+1);
-		Time.resize(m_numSteps+1);
-		theVelSeries = new PathTimeSeries(2, Path, Time, 1.0, false);
 		isThisInitialized = true;
 		
 		// create a ground motion. It's useful for UniformExcitatpon or MultipleSupport 
@@ -206,3 +274,59 @@ OutcropMotion::setBBPMotion(const char* fName, int colNum)
 	}
 	return;
 }
+
+void
+OutcropMotion::setLibraryMotion(const MotionLibrary& theLibrary, const char* recordID)
+{
+	MotionRecord record;
+	this->clearMotion();
+	if (theLibrary.findRecord(recordID, record))
+	{
+		// the library holds the arrays in the units setMotion() reads them in
+		if (record.acc != NULL)
+			theAccSeries = new PathTimeSeries(1, record.acc, record.time, record.numPoints, 9.81, true);
+		if (record.vel != NULL)
+			theVelSeries = new PathTimeSeries(2, record.vel, record.time, record.numPoints, 1.0, true);
+		if (record.disp != NULL)
+			theDispSeries = new PathTimeSeries(3, record.disp, record.time, record.numPoints, 1.0, true);
+
+		m_numSteps = record.numPoints - 1;
+		if (record.uniform)
+			m_dt.assign(m_numSteps, record.dt);
+		else
+		{
+			m_dt.reserve(m_numSteps);
+			for (int i = 1; i < record.numPoints; i++)
+				m_dt.push_back(record.time[i] - record.time[i - 1]);
+		}
+		m_dt_avg = record.dt;
+
+		this->integrateAcceleration();
+		theGroundMotion = new GroundMotion(theDispSeries, theVelSeries, theAccSeries, NULL);
+		isThisInitialized = true;
+	}
+	else {
+		isThisInitialized = false;
+		opserr << "Record " << recordID << " is not in the motion library." << endln;
+	}
+}
+
+void
+OutcropMotion::setMotion(const double* time, const double* velocity, int numPoints)
+{
+	this->clearMotion();
+	if ((time != NULL) && (velocity != NULL) && (numPoints > 1))
+	{
+		std::vector<double> timeValues(time, time + numPoints);
+		readDT(timeValues, m_numSteps, m_dt);
+		m_dt_avg = std::accumulate(m_dt.begin(), m_dt.end(), 0.0) / double(m_dt.size());
+
+		theVelSeries = new PathTimeSeries(2, Vector(const_cast<double*>(velocity), numPoints), Vector(&timeValues[0], numPoints), 1.0, true);
+		theGroundMotion = new GroundMotion(theDispSeries, theVelSeries, theAccSeries, NULL);
+		isThisInitialized = true;
+	}
+	else {
+		isThisInitialized = false;
+		opserr << "A motion needs at least two points of time and velocity." << endln;
+	}
+}
@@ -18,6 +18,8 @@
 #include "PathTimeSeries.h"
 #include "GroundMotion.h"
 
+class MotionLibrary;
+
 #ifndef OUTCROPMOTION_H
 #define OUTCROPMOTION_H
 
@@ -26,7 +28,13 @@ class OutcropMotion
 public:
 	OutcropMotion();
 	OutcropMotion(const char* fName);
+	// the series view the arrays of the mapped record, the library has to
+	// stay open as long as this motion is used
+	OutcropMotion(const MotionLibrary& theLibrary, const char* recordID);
 	~OutcropMotion();
+	// owns its series and ground motion, so it is not copied
+	OutcropMotion(const OutcropMotion&) = delete;
+	OutcropMotion& operator=(const OutcropMotion&) = delete;
 
 	PathTimeSeries*  getDispSeries() { return theDispSeries; };
 	PathTimeSeries*  getVelSeries() { return theVelSeries; };
@@ -39,8 +47,18 @@ public:
 	int                 getNumSteps() { return m_numSteps; };
 	void                setMotion(const char* fName);
     void                setBBPMotion(const char* fName, int colNum);
+	void                setAT2Motion(const char* fName);
+	void                setLibraryMotion(const MotionLibrary& theLibrary, const char* recordID);
+	// a velocity record in m/s given as arrays, which are copied
+	void                setMotion(const double* time, const double* velocity, int numPoints);
 
 private:
+	// deletes the motion read before, the set methods start from nothing
+	void clearMotion();
+	// the velocity of a motion read as an acceleration only, which the
+	// dashpot at the base of the model is loaded with
+	void integrateAcceleration();
+
 	PathTimeSeries* theAccSeries;
 	PathTimeSeries* theVelSeries;
 	PathTimeSeries* theDispSeries;
@@ -5,6 +5,8 @@ INCLUDEPATH += $$PWD/ \
 	     += $$PWD/SiteResponse \
 	     += $$PWD/UI
 
+QT += concurrent
+
 unix: {
 # You need to modify this section if your blas and lapack is in a different place
 
@@ -26,6 +28,9 @@ SOURCES += \
     $$PWD/UI/BonzaTableModel.cpp \
     $$PWD/UI/SiteResponse.cpp \
     $$PWD/UI/TabManager.cpp \
+    $$PWD/UI/ResponseDataService.cpp \
+    $$PWD/UI/LiveResultsMonitor.cpp \
+    $$PWD/UI/MeshItem.cpp \
     #SiteResponse/Mesher.cpp \
     $$PWD/UI/JsonManager.cpp \
     $$PWD/UI/ElementModel.cpp \
@@ -35,11 +40,13 @@ SOURCES += \
     $$PWD/FEM/ElasticIsotropicMaterial.cpp \
     $$PWD/FEM/VariableTimeStepDirectIntegrationAnalysis.cpp \
     $$PWD/FEM/SSPquadUP.cpp \
+    $$PWD/FEM/ShearColumnUP.cpp \
     $$PWD/FEM/SSPquad.cpp \
     $$PWD/FEM/Analysis.cpp \
     $$PWD/FEM/AnalysisModel.cpp \
     $$PWD/FEM/ArrayOfTaggedObjects.cpp \
     $$PWD/FEM/ArrayOfTaggedObjectsIter.cpp \
+    $$PWD/FEM/AsyncStreamWriter.cpp \
     $$PWD/FEM/BandGenLinLapackSolver.cpp \
     $$PWD/FEM/BandGenLinSOE.cpp \
     $$PWD/FEM/BandGenLinSolver.cpp \
@@ -83,6 +90,7 @@ SOURCES += \
     $$PWD/FEM/FE_EleIter.cpp \
     $$PWD/FEM/FE_Element.cpp \
     $$PWD/FEM/FEM_ObjectBroker.cpp \
+    $$PWD/FEM/FEM_ObjectBrokerAllClasses.cpp \
     $$PWD/FEM/FiberResponse.cpp \
     $$PWD/FEM/File.cpp \
     $$PWD/FEM/FileIter.cpp \
@@ -120,6 +128,7 @@ SOURCES += \
     $$PWD/FEM/NDMaterial.cpp \
     $$PWD/FEM/Newmark.cpp \
     $$PWD/FEM/NewtonRaphson.cpp \
+    $$PWD/FEM/NodalKinematicState.cpp \
     $$PWD/FEM/NodalLoad.cpp \
     $$PWD/FEM/NodalLoadIter.cpp \
     $$PWD/FEM/Node.cpp \
@@ -137,6 +146,9 @@ SOURCES += \
     $$PWD/FEM/PlaneStressMaterial.cpp \
     $$PWD/FEM/PlateFiberMaterial.cpp \
     $$PWD/FEM/Pressure_Constraint.cpp \
+    $$PWD/FEM/ProfileStream.cpp \
+    $$PWD/FEM/LiveFeedStream.cpp \
+    $$PWD/FEM/MemoryStream.cpp \
     $$PWD/FEM/PySimple1.cpp \
     $$PWD/FEM/QzSimple1.cpp \
     $$PWD/FEM/RCM.cpp \
@@ -155,6 +167,7 @@ SOURCES += \
     $$PWD/FEM/SingleDomParamIter.cpp \
     $$PWD/FEM/SingleDomPC_Iter.cpp \
     $$PWD/FEM/SingleDomSP_Iter.cpp \
+    $$PWD/FEM/SnapshotChannel.cpp \
     $$PWD/FEM/SolutionAlgorithm.cpp \
     $$PWD/FEM/SP_Constraint.cpp \
     $$PWD/FEM/SSPbrick.cpp \
@@ -186,11 +199,17 @@ SOURCES += \
     #$$PWD/FEM/ElasticIsotropicPlaneStress2D.cpp \
     $$PWD/SiteResponse/EffectiveFEModel.cpp \
     $$PWD/SiteResponse/Mesher.cpp \
+    $$PWD/SiteResponse/LayerDiff.cpp \
+    $$PWD/SiteResponse/ResultCache.cpp \
+    $$PWD/SiteResponse/SiteCatalogue.cpp \
     $$PWD/SiteResponse/soillayer.cpp \
     $$PWD/SiteResponse/siteLayering.cpp \
+    $$PWD/SiteResponse/motionReader.cpp \
+    $$PWD/SiteResponse/motionLibrary.cpp \
     $$PWD/SiteResponse/outcropMotion.cpp \
     #$$PWD/SiteResponse/FEModel3D.cpp
     $$PWD/UI/ProfileManager.cpp \
+    $$PWD/UI/ResultFile.cpp \
     $$PWD/UI/PostProcessor.cpp
 
 HEADERS  += \
@@ -202,6 +221,9 @@ HEADERS  += \
     $$PWD/UI/BonzaTableModel.h \
     $$PWD/UI/SiteResponse.h \
     $$PWD/UI/TabManager.h \
+    $$PWD/UI/ResponseDataService.h \
+    $$PWD/UI/LiveResultsMonitor.h \
+    $$PWD/UI/MeshItem.h \
     #SiteResponse/Mesher.h \
     $$PWD/UI/JsonManager.h \
     $$PWD/UI/ElementModel.h \
@@ -211,6 +233,7 @@ HEADERS  += \
     $$PWD/FEM/AnalysisModel.h \
     $$PWD/FEM/ArrayOfTaggedObjects.h \
     $$PWD/FEM/ArrayOfTaggedObjectsIter.h \
+    $$PWD/FEM/AsyncStreamWriter.h \
     $$PWD/FEM/BandGenLinLapackSolver.h \
     $$PWD/FEM/BandGenLinSOE.h \
     $$PWD/FEM/BandGenLinSolver.h \
@@ -259,6 +282,7 @@ HEADERS  += \
     $$PWD/FEM/FE_EleIter.h \
     $$PWD/FEM/FE_Element.h \
     $$PWD/FEM/FEM_ObjectBroker.h \
+    $$PWD/FEM/FEM_ObjectBrokerAllClasses.h \
     $$PWD/FEM/Fiber.h \
     $$PWD/FEM/FiberResponse.h \
     $$PWD/FEM/File.h \
@@ -300,6 +324,7 @@ HEADERS  += \
     $$PWD/FEM/NDMaterial.h \
     $$PWD/FEM/Newmark.h \
     $$PWD/FEM/NewtonRaphson.h \
+    $$PWD/FEM/NodalKinematicState.h \
     $$PWD/FEM/NodalLoad.h \
     $$PWD/FEM/NodalLoadIter.h \
     $$PWD/FEM/Node.h \
@@ -322,6 +347,9 @@ HEADERS  += \
     $$PWD/FEM/PlateFiberMaterial.h \
     $$PWD/FEM/Pressure_Constraint.h \
     $$PWD/FEM/Pressure_ConstraintIter.h \
+    $$PWD/FEM/ProfileStream.h \
+    $$PWD/FEM/LiveFeedStream.h \
+    $$PWD/FEM/MemoryStream.h \
     $$PWD/FEM/PySimple1.h \
     $$PWD/FEM/QzSimple1.h \
     $$PWD/FEM/RCM.h \
@@ -340,6 +368,7 @@ HEADERS  += \
     $$PWD/FEM/SingleDomParamIter.h \
     $$PWD/FEM/SingleDomPC_Iter.h \
     $$PWD/FEM/SingleDomSP_Iter.h \
+    $$PWD/FEM/SnapshotChannel.h \
     $$PWD/FEM/SolutionAlgorithm.h \
     $$PWD/FEM/SP_Constraint.h \
     $$PWD/FEM/SP_ConstraintIter.h \
@@ -375,12 +404,19 @@ HEADERS  += \
     #$$PWD/FEM/ElasticIsotropicPlaneStress2D.h \
     $$PWD/FEM/SSPquad.h \
     $$PWD/FEM/SSPquadUP.h \
+    $$PWD/FEM/ShearColumnUP.h \
     $$PWD/SiteResponse/Mesher.h \
+    $$PWD/SiteResponse/LayerDiff.h \
+    $$PWD/SiteResponse/ResultCache.h \
+    $$PWD/SiteResponse/SiteCatalogue.h \
     $$PWD/SiteResponse/EffectiveFEModel.h \
     $$PWD/SiteResponse/soillayer.h \
+    $$PWD/SiteResponse/motionReader.h \
+    $$PWD/SiteResponse/motionLibrary.h \
     $$PWD/SiteResponse/outcropMotion.h \
     $$PWD/SiteResponse/siteLayering.h \
     $$PWD/UI/ProfileManager.h \
+    $$PWD/UI/ResultFile.h \
     $$PWD/UI/PostProcessor.h
 
 
@@ -4,7 +4,7 @@
 #                                                                              #
 #------------------------------------------------------------------------------#
 
-QT       += core gui sql quick qml webenginewidgets uitools webengine webchannel
+QT       += core gui sql quick qml webenginewidgets uitools webengine webchannel concurrent
 
 CONFIG += c++11
 
@@ -53,6 +53,9 @@ SOURCES += main.cpp\
     UI/BonzaTableModel.cpp \
     UI/SiteResponse.cpp \
     UI/TabManager.cpp \
+    UI/ResponseDataService.cpp \
+    UI/LiveResultsMonitor.cpp \
+    UI/MeshItem.cpp \
     #SiteResponse/Mesher.cpp \
     UI/JsonManager.cpp \
     UI/ElementModel.cpp \
@@ -62,11 +65,13 @@ SOURCES += main.cpp\
     FEM/ElasticIsotropicMaterial.cpp \
     FEM/VariableTimeStepDirectIntegrationAnalysis.cpp \
     FEM/SSPquadUP.cpp \
+    FEM/ShearColumnUP.cpp \
     FEM/SSPquad.cpp \
     FEM/Analysis.cpp \
     FEM/AnalysisModel.cpp \
     FEM/ArrayOfTaggedObjects.cpp \
     FEM/ArrayOfTaggedObjectsIter.cpp \
+    FEM/AsyncStreamWriter.cpp \
     FEM/BandGenLinLapackSolver.cpp \
     FEM/BandGenLinSOE.cpp \
     FEM/BandGenLinSolver.cpp \
@@ -110,6 +115,7 @@ SOURCES += main.cpp\
     FEM/FE_EleIter.cpp \
     FEM/FE_Element.cpp \
     FEM/FEM_ObjectBroker.cpp \
+    FEM/FEM_ObjectBrokerAllClasses.cpp \
     FEM/FiberResponse.cpp \
     FEM/File.cpp \
     FEM/FileIter.cpp \
@@ -147,6 +153,7 @@ SOURCES += main.cpp\
     FEM/NDMaterial.cpp \
     FEM/Newmark.cpp \
     FEM/NewtonRaphson.cpp \
+    FEM/NodalKinematicState.cpp \
     FEM/NodalLoad.cpp \
     FEM/NodalLoadIter.cpp \
     FEM/Node.cpp \
@@ -164,6 +171,9 @@ SOURCES += main.cpp\
     FEM/PlaneStressMaterial.cpp \
     FEM/PlateFiberMaterial.cpp \
     FEM/Pressure_Constraint.cpp \
+    FEM/ProfileStream.cpp \
+    FEM/LiveFeedStream.cpp \
+    FEM/MemoryStream.cpp \
     FEM/PySimple1.cpp \
     FEM/QzSimple1.cpp \
     FEM/RCM.cpp \
@@ -182,6 +192,7 @@ SOURCES += main.cpp\
     FEM/SingleDomParamIter.cpp \
     FEM/SingleDomPC_Iter.cpp \
     FEM/SingleDomSP_Iter.cpp \
+    FEM/SnapshotChannel.cpp \
     FEM/SolutionAlgorithm.cpp \
     FEM/SP_Constraint.cpp \
     FEM/SSPbrick.cpp \
@@ -213,11 +224,17 @@ SOURCES += main.cpp\
     #FEM/ElasticIsotropicPlaneStress2D.cpp \
     SiteResponse/EffectiveFEModel.cpp \
     SiteResponse/Mesher.cpp \
+    SiteResponse/LayerDiff.cpp \
+    SiteResponse/ResultCache.cpp \
+    SiteResponse/SiteCatalogue.cpp \
     SiteResponse/soillayer.cpp \
     SiteResponse/siteLayering.cpp \
+    SiteResponse/motionReader.cpp \
+    SiteResponse/motionLibrary.cpp \
     SiteResponse/outcropMotion.cpp \
     #SiteResponse/FEModel3D.cpp
     UI/ProfileManager.cpp \
+    UI/ResultFile.cpp \
     UI/PostProcessor.cpp
 
 HEADERS  += UI/MainWindow.h \
@@ -229,6 +246,9 @@ HEADERS  += UI/MainWindow.h \
     UI/BonzaTableModel.h \
     UI/SiteResponse.h \
     UI/TabManager.h \
+    UI/ResponseDataService.h \
+    UI/LiveResultsMonitor.h \
+    UI/MeshItem.h \
     #SiteResponse/Mesher.h \
     UI/JsonManager.h \
     UI/ElementModel.h \
@@ -238,6 +258,7 @@ HEADERS  += UI/MainWindow.h \
     FEM/AnalysisModel.h \
     FEM/ArrayOfTaggedObjects.h \
     FEM/ArrayOfTaggedObjectsIter.h \
+    FEM/AsyncStreamWriter.h \
     FEM/BandGenLinLapackSolver.h \
     FEM/BandGenLinSOE.h \
     FEM/BandGenLinSolver.h \
@@ -286,6 +307,7 @@ HEADERS  += UI/MainWindow.h \
     FEM/FE_EleIter.h \
     FEM/FE_Element.h \
     FEM/FEM_ObjectBroker.h \
+    FEM/FEM_ObjectBrokerAllClasses.h \
     FEM/Fiber.h \
     FEM/FiberResponse.h \
     FEM/File.h \
@@ -327,6 +349,7 @@ HEADERS  += UI/MainWindow.h \
     FEM/NDMaterial.h \
     FEM/Newmark.h \
     FEM/NewtonRaphson.h \
+    FEM/NodalKinematicState.h \
     FEM/NodalLoad.h \
     FEM/NodalLoadIter.h \
     FEM/Node.h \
@@ -349,6 +372,9 @@ HEADERS  += UI/MainWindow.h \
     FEM/PlateFiberMaterial.h \
     FEM/Pressure_Constraint.h \
     FEM/Pressure_ConstraintIter.h \
+    FEM/ProfileStream.h \
+    FEM/LiveFeedStream.h \
+    FEM/MemoryStream.h \
     FEM/PySimple1.h \
     FEM/QzSimple1.h \
     FEM/RCM.h \
@@ -367,6 +393,7 @@ HEADERS  += UI/MainWindow.h \
     FEM/SingleDomParamIter.h \
     FEM/SingleDomPC_Iter.h \
     FEM/SingleDomSP_Iter.h \
+    FEM/SnapshotChannel.h \
     FEM/SolutionAlgorithm.h \
     FEM/SP_Constraint.h \
     FEM/SP_ConstraintIter.h \
@@ -402,12 +429,19 @@ HEADERS  += UI/MainWindow.h \
     #FEM/ElasticIsotropicPlaneStress2D.h \
     FEM/SSPquad.h \
     FEM/SSPquadUP.h \
+    FEM/ShearColumnUP.h \
     SiteResponse/Mesher.h \
+    SiteResponse/LayerDiff.h \
+    SiteResponse/ResultCache.h \
+    SiteResponse/SiteCatalogue.h \
     SiteResponse/EffectiveFEModel.h \
     SiteResponse/soillayer.h \
+    SiteResponse/motionReader.h \
+    SiteResponse/motionLibrary.h \
     SiteResponse/outcropMotion.h \
     SiteResponse/siteLayering.h \
     UI/ProfileManager.h \
+    UI/ResultFile.h \
     UI/PostProcessor.h
 
 
@@ -1,5 +1,8 @@
 #include "BonzaTableModel.h"
 #include <QSqlField>
+#include <QSqlQuery>
+#include <QSqlError>
+
 QList<QVariant> BonzaTableModel::getRowInfo(int r) const
 {
     QList<QVariant> list;
@@ -15,3 +18,129 @@ QList<QVariant> BonzaTableModel::getRowInfo(int r) const
     return list;
 }
 
+
+bool BonzaTableModel::endBatch()
+{
+    if (m_batchDepth > 0)
+        m_batchDepth--;
+    if (m_batchDepth > 0)
+        return true;
+
+    bool ok = submitEdits();
+    if (m_thicknessEdited)
+    {
+        m_thicknessEdited = false;
+        emit thicknessEdited();
+    }
+    return ok;
+}
+
+bool BonzaTableModel::beginTransaction()
+{
+    if (m_transactionDepth++ == 0)
+    {
+        m_inTransaction = database().transaction();
+        m_transactionFailed = false;
+    }
+    return m_inTransaction;
+}
+
+bool BonzaTableModel::endTransaction(bool commit)
+{
+    if (!commit)
+        m_transactionFailed = true;
+    if (m_transactionDepth == 0 || --m_transactionDepth > 0)
+        return !m_transactionFailed;
+
+    bool ok = !m_transactionFailed;
+    if (m_inTransaction)
+    {
+        if (ok)
+            ok = database().commit();
+        else
+            database().rollback();
+        m_inTransaction = false;
+    }
+    return ok;
+}
+
+bool BonzaTableModel::submitEdits()
+{
+    if (m_batchDepth > 0)
+        return true;
+
+    // one transaction for all the rows changed, rather than one per row
+    beginTransaction();
+    bool ok = submitAll();
+    endTransaction(ok);
+    return ok;
+}
+
+bool BonzaTableModel::shiftIds(int firstId, int delta, int skipId)
+{
+    // the ids are unique, so the rows shifted are first moved out of the way
+    // to negative ids and then back
+    QSqlQuery query(database());
+    query.prepare(QString("UPDATE %1 SET ID = -(ID + :delta) WHERE ID >= :first AND ID <> :skip").arg(tableName()));
+    query.bindValue(":delta", delta);
+    query.bindValue(":first", firstId);
+    query.bindValue(":skip", skipId);
+    if (!query.exec())
+    {
+        qDebug() << "shift ids error: " << query.lastError();
+        return false;
+    }
+    return true;
+}
+
+bool BonzaTableModel::moveLastRowTo(int row)
+{
+    int numRows = rowCount();
+    if (numRows < 1)
+        return false;
+    int lastId = record(numRows-1).value(0).toInt();
+
+    beginTransaction();
+    bool ok = shiftIds(row+1, 1, lastId);
+    QSqlQuery query(database());
+    if (ok)
+    {
+        query.prepare(QString("UPDATE %1 SET ID = :id WHERE ID = :last").arg(tableName()));
+        query.bindValue(":id", row+1);
+        query.bindValue(":last", lastId);
+        ok = query.exec();
+    }
+    ok = ok && query.exec(QString("UPDATE %1 SET ID = -ID WHERE ID < 0").arg(tableName()));
+    if (!ok)
+        qDebug() << "move row error: " << query.lastError();
+    ok = endTransaction(ok);
+
+    select();
+    return ok;
+}
+
+bool BonzaTableModel::closeGapAt(int row)
+{
+    beginTransaction();
+    bool ok = shiftIds(row+2, -1, -1);
+    QSqlQuery query(database());
+    ok = ok && query.exec(QString("UPDATE %1 SET ID = -ID WHERE ID < 0").arg(tableName()));
+    ok = endTransaction(ok);
+
+    select();
+    return ok;
+}
+
+const QVector<double> &BonzaTableModel::layerTops() const
+{
+    if (!m_topsValid)
+    {
+        int numRows = rowCount();
+        m_tops.resize(numRows+1);
+        m_tops[0] = 0.0;
+        for (int i=0; i<numRows; ++i)
+            m_tops[i+1] = m_tops[i] + this->record(i).value(THICKNESS).toDouble();
+        m_topsValid = true;
+    }
+    return m_tops;
+}
@@ -34,8 +34,26 @@ public:
         explicit BonzaTableModel(QWidget *parent = nullptr, QSqlDatabase db = QSqlDatabase()):
         QSqlTableModel(parent, db)
     {
+        connect(this, SIGNAL(modelReset()), this, SLOT(invalidateCache()));
+        connect(this, SIGNAL(dataChanged(const QModelIndex&,const QModelIndex&)), this, SLOT(invalidateCache()));
+        connect(this, SIGNAL(rowsInserted(const QModelIndex&,int,int)), this, SLOT(invalidateCache()));
+        connect(this, SIGNAL(rowsRemoved(const QModelIndex&,int,int)), this, SLOT(invalidateCache()));
     }
 
+    // the edits made between beginBatch() and endBatch() are kept in the
+    // model and written by endBatch() in one transaction
+    void beginBatch() { m_batchDepth++; }
+    bool endBatch();
+
+    // nested transactions, only the outermost one is committed
+    bool beginTransaction();
+    bool endTransaction(bool commit);
+
+    // the ids of the layers follow their rows. A layer added at the end is
+    // moved to row, and the gap left by a layer removed from row is closed
+    bool moveLastRowTo(int row);
+    bool closeGapAt(int row);
+
 
     Qt::ItemFlags flags( const QModelIndex &index ) const
     {
@@ -61,7 +79,7 @@ public:
         {
             QSqlTableModel::setData(index, value, Qt::EditRole);
             //emit thicknessEdited();
-            return submitAll();
+            return submitEdits();
         }
 
 
@@ -97,13 +115,16 @@ public:
                 emit thicknessEdited();
             }
             */
-            emit thicknessEdited();
+            if (m_batchDepth > 0)
+                m_thicknessEdited = true;
+            else
+                emit thicknessEdited();
 
-            return submitAll();
+            return submitEdits();
         }
 
         QSqlTableModel::setData(index, value, Qt::EditRole);
-        return submitAll();
+        return submitEdits();
 
     }
 
@@ -119,7 +140,7 @@ public:
         if (abs(ir - (numLayers-1)) < 1e-5 && numLayers==1) // First time to add Rock layer
         {
             QSqlTableModel::setData(index, value, Qt::EditRole);
-            return submitAll();
+            return submitEdits();
         }
 
 
@@ -128,11 +149,11 @@ public:
             QSqlTableModel::setData(index, value, Qt::EditRole);
 
 
-            return submitAll();
+            return submitEdits();
         }
 
         QSqlTableModel::setData(index, value, Qt::EditRole);
-        return submitAll();
+        return submitEdits();
 
     }
 
@@ -163,19 +184,13 @@ public:
     }
     Q_INVOKABLE double getBotompos(int row)
     {
-        double botompos = 0.0;
-        int i;
-        for (i=0;i<=row;++i)
-            botompos+=this->record(i).value(THICKNESS).toDouble();
-        return botompos;
+        const QVector<double> &tops = layerTops();
+        return tops[qBound(0, row+1, tops.size()-1)];
     }
     Q_INVOKABLE double getToppos(int row)
     {
-        double toppos = 0.0;
-        int i;
-        for (i=0;i<row;++i)
-            toppos+=this->record(i).value(THICKNESS).toDouble();
-        return toppos;
+        const QVector<double> &tops = layerTops();
+        return tops[qBound(0, row, tops.size()-1)];
     }
     Q_INVOKABLE QString getSoilColor(int row)
     {
@@ -184,11 +199,7 @@ public:
     }
     Q_INVOKABLE double getTotalHeight()
     {
-        double totalHeight = 0.0;
-        int i;
-        for (i=0;i<this->rowCount() ;++i)
-            totalHeight += this->record(i).value(THICKNESS).toDouble();
-        return totalHeight;
+        return layerTops().last();
     }
 
 
@@ -202,12 +213,13 @@ public:
     {
         int i;
 
+        beginBatch();
         for (i=0;i<this->rowCount() ;++i)
             setData(this->index(i, CHECKED), "0");
 
         setData(this->index(row, CHECKED), "1");
 
-        submitAll();
+        endBatch();
 
         //emit rowActivated(row);
 
@@ -217,11 +229,12 @@ public:
     Q_INVOKABLE void setActiveFromView(int row)
     {
         int i;
+        beginBatch();
         for (i=0;i<this->rowCount() ;++i)
             setData(this->index(i, CHECKED), "0");
 
         setData(this->index(row, CHECKED), "1");
-        submitAll();
+        endBatch();
         //emit rowActivated(row);
         qDebug()<< "row " << row << " activated., said the model.";
     }
@@ -229,9 +242,10 @@ public:
     Q_INVOKABLE void deActivateAll()
     {
         int i;
+        beginBatch();
         for (i=0;i<this->rowCount() ;++i)
             setData(this->index(i, CHECKED), "0");
-        submitAll();
+        endBatch();
     }
 
 public slots:
@@ -253,7 +267,24 @@ public slots:
 
     QList<QVariant> getRowInfo(int row) const;
 
-
+private slots:
+    void invalidateCache() { m_topsValid = false; }
+
+private:
+    // writes the edits in the model, unless a batch is open
+    bool submitEdits();
+    // the depth of the top of each layer, and the total height at the end,
+    // kept until the model changes as the views ask for them for every layer
+    const QVector<double> &layerTops() const;
+    bool shiftIds(int firstId, int delta, int skipId);
+
+    int m_batchDepth = 0;
+    int m_transactionDepth = 0;
+    bool m_inTransaction = false;
+    bool m_transactionFailed = false;
+    bool m_thicknessEdited = false;
+    mutable QVector<double> m_tops;
+    mutable bool m_topsValid = false;
 };
 
 #endif // BONZATABLEMODEL_H
@@ -225,39 +225,18 @@ void BonzaTableView::insertAt(const QList<QVariant> &valueList, int insertPositi
         if(insertPosition==m_nTotal & m_nTotal>0)
             insertPosition -=1;
 
+        // the cells of the new row are kept in the model and written with a
+        // single insert at the end of the batch
+        m_sqlModel->beginBatch();
+
         //int insertPosition = 1;
         this->model()->insertRow(m_nTotal);// actually added to the end of the table, stupid qt.
 
-        // print table for debug
-        for( int i = m_nTotal+1; i > -1; --i)
-        {
-            QSqlRecord myrecord = m_sqlModel->record(i);
-            QString id = myrecord.value("id").toString();
-            QString name = myrecord.value("LAYERNAME").toString();
-            QString color = myrecord.value("COLOR").toString();
-            QString checked = myrecord.value("CHECKED").toString();
-            QString thickness = myrecord.value("THICKNESS").toString();
-            qDebug() <<"ID: " <<id << "; name: " << name << " ; color:" << color << " ; checked: " << checked << " ;thickness " << thickness;
-        }
-
         // really put the data on the inserted row
         m_sqlModel->setData(m_sqlModel->index(m_nTotal, CHECKED), 0);
         m_sqlModel->setData(m_sqlModel->index(m_nTotal, LAYERNAME), "Layer "+QString::number(insertPosition+1));
         m_sqlModel->setData(m_sqlModel->index(m_nTotal, THICKNESS), "3");
 
-        // print table for debug
-        for( int i = m_nTotal+1; i > -1; --i)
-        {
-            QSqlRecord myrecord = m_sqlModel->record(i);
-            QString id = myrecord.value("id").toString();
-            QString name = myrecord.value("LAYERNAME").toString();
-            QString color = myrecord.value("COLOR").toString();
-            QString checked = myrecord.value("CHECKED").toString();
-            QString thickness = myrecord.value("THICKNESS").toString();
-            qDebug() <<"ID: " <<id << "; name: " << name << " ; color:" << color << " ; checked: " << checked << " ;thickness " << thickness;
-        }
-
-
         if(m_nTotal>=1)
         {
             int col = CHECKED;
@@ -282,55 +261,15 @@ void BonzaTableView::insertAt(const QList<QVariant> &valueList, int insertPositi
             m_sqlModel->setData(m_sqlModel->index(m_nTotal, COLOR), "Black");
         }
 
-        // print table for debug
-        for( int i = m_nTotal+1; i > -1; --i)
-        {
-            QSqlRecord myrecord = m_sqlModel->record(i);
-            QString id = myrecord.value("id").toString();
-            QString name = myrecord.value("LAYERNAME").toString();
-            QString color = myrecord.value("COLOR").toString();
-            QString checked = myrecord.value("CHECKED").toString();
-            QString thickness = myrecord.value("THICKNESS").toString();
-            qDebug() <<"ID: " <<id << "; name: " << name << " ; color:" << color << " ; checked: " << checked << " ;thickness " << thickness;
-        }
-
-
-        bool b;
-        for (int j = m_nTotal; j>=insertPosition; j--)
-        {
-            m_sqlModel->setData(m_sqlModel->index(j,0),QString::number(j+2),Qt::EditRole);
-            b = m_sqlModel->submitAll();
-        }
-        m_sqlModel->setData(m_sqlModel->index(m_nTotal,0),QString::number(insertPosition+1),Qt::EditRole);
-        b = m_sqlModel->submitAll();
-
+        m_sqlModel->endBatch();
 
+        // the row went in at the end, the rows from insertPosition on move
+        // down one to make room for it
+        m_sqlModel->moveLastRowTo(insertPosition);
 
         m_nTotal++;
         //updateTableModel();
 
-
-
-
-
-
-        // print table for debug
-        for( int i = m_nTotal+1; i > -1; --i)
-        {
-            QSqlRecord myrecord = m_sqlModel->record(i);
-            QString id = myrecord.value("id").toString();
-            QString name = myrecord.value("LAYERNAME").toString();
-            QString color = myrecord.value("COLOR").toString();
-            QString checked = myrecord.value("CHECKED").toString();
-            QString thickness = myrecord.value("THICKNESS").toString();
-            qDebug() <<"ID: " <<id << "; name: " << name << " ; color:" << color << " ; checked: " << checked << " ;thickness " << thickness;
-        }
-
-
-        bool inse = m_sqlModel->submitAll();
-
-        m_sqlModel->select();
-
         m_nCurPage = qCeil(double(insertPosition+1) / double(m_nPageSize));
         gotoPage(m_nCurPage);
 
@@ -355,39 +294,18 @@ void BonzaTableView::insertAtSilent(const QList<QVariant> &valueList, int insert
         if(insertPosition==m_nTotal & m_nTotal>0)
             insertPosition -=1;
 
+        // the cells of the new row are kept in the model and written with a
+        // single insert at the end of the batch
+        m_sqlModel->beginBatch();
+
         //int insertPosition = 1;
         this->model()->insertRow(m_nTotal);// actually added to the end of the table, stupid qt.
 
-        // print table for debug
-        for( int i = m_nTotal+1; i > -1; --i)
-        {
-            QSqlRecord myrecord = m_sqlModel->record(i);
-            QString id = myrecord.value("id").toString();
-            QString name = myrecord.value("LAYERNAME").toString();
-            QString color = myrecord.value("COLOR").toString();
-            QString checked = myrecord.value("CHECKED").toString();
-            QString thickness = myrecord.value("THICKNESS").toString();
-            qDebug() <<"ID: " <<id << "; name: " << name << " ; color:" << color << " ; checked: " << checked << " ;thickness " << thickness;
-        }
-
         // really put the data on the inserted row
         m_sqlModel->setDataSilent(m_sqlModel->index(m_nTotal, CHECKED), 0);
         m_sqlModel->setDataSilent(m_sqlModel->index(m_nTotal, LAYERNAME), "Layer "+QString::number(insertPosition+1));
         m_sqlModel->setDataSilent(m_sqlModel->index(m_nTotal, THICKNESS), "3");
 
-        // print table for debug
-        for( int i = m_nTotal+1; i > -1; --i)
-        {
-            QSqlRecord myrecord = m_sqlModel->record(i);
-            QString id = myrecord.value("id").toString();
-            QString name = myrecord.value("LAYERNAME").toString();
-            QString color = myrecord.value("COLOR").toString();
-            QString checked = myrecord.value("CHECKED").toString();
-            QString thickness = myrecord.value("THICKNESS").toString();
-            qDebug() <<"ID: " <<id << "; name: " << name << " ; color:" << color << " ; checked: " << checked << " ;thickness " << thickness;
-        }
-
-
         if(m_nTotal>=1)
         {
             int col = CHECKED;
@@ -412,55 +330,15 @@ void BonzaTableView::insertAtSilent(const QList<QVariant> &valueList, int insert
             m_sqlModel->setDataSilent(m_sqlModel->index(m_nTotal, COLOR), "Black");
         }
 
-        // print table for debug
-        for( int i = m_nTotal+1; i > -1; --i)
-        {
-            QSqlRecord myrecord = m_sqlModel->record(i);
-            QString id = myrecord.value("id").toString();
-            QString name = myrecord.value("LAYERNAME").toString();
-            QString color = myrecord.value("COLOR").toString();
-            QString checked = myrecord.value("CHECKED").toString();
-            QString thickness = myrecord.value("THICKNESS").toString();
-            qDebug() <<"ID: " <<id << "; name: " << name << " ; color:" << color << " ; checked: " << checked << " ;thickness " << thickness;
-        }
-
-
-        bool b;
-        for (int j = m_nTotal; j>=insertPosition; j--)
-        {
-            m_sqlModel->setDataSilent(m_sqlModel->index(j,0),QString::number(j+2),Qt::EditRole);
-            b = m_sqlModel->submitAll();
-        }
-        m_sqlModel->setDataSilent(m_sqlModel->index(m_nTotal,0),QString::number(insertPosition+1),Qt::EditRole);
-        b = m_sqlModel->submitAll();
-
+        m_sqlModel->endBatch();
 
+        // the row went in at the end, the rows from insertPosition on move
+        // down one to make room for it
+        m_sqlModel->moveLastRowTo(insertPosition);
 
         m_nTotal++;
         //updateTableModel();
 
-
-
-
-
-
-        // print table for debug
-        for( int i = m_nTotal+1; i > -1; --i)
-        {
-            QSqlRecord myrecord = m_sqlModel->record(i);
-            QString id = myrecord.value("id").toString();
-            QString name = myrecord.value("LAYERNAME").toString();
-            QString color = myrecord.value("COLOR").toString();
-            QString checked = myrecord.value("CHECKED").toString();
-            QString thickness = myrecord.value("THICKNESS").toString();
-            qDebug() <<"ID: " <<id << "; name: " << name << " ; color:" << color << " ; checked: " << checked << " ;thickness " << thickness;
-        }
-
-
-        bool inse = m_sqlModel->submitAll();
-
-        m_sqlModel->select();
-
         m_nCurPage = qCeil(double(insertPosition+1) / double(m_nPageSize));
         gotoPage(m_nCurPage);
 
@@ -626,50 +504,13 @@ void BonzaTableView::removeOneRow(int rowDel)
     m_sqlModel->setFilter(QString(""));
     m_sqlModel->select();
 
-    // debuging
-    for( int i = 0; i < m_nTotal; ++i)
-    {
-        QSqlRecord myrecord = m_sqlModel->record(i);
-        QString id = myrecord.value("id").toString();
-        QString name = myrecord.value("LAYERNAME").toString();
-        qDebug() <<"ID: " <<id << "; name: " << name ;
-    }
-
-
+    // the row is deleted and the ids after it close up in one transaction
+    m_sqlModel->beginTransaction();
     this->model()->removeRow(rowDel);
     m_nTotal--;
-    m_sqlModel->submitAll();
-    m_sqlModel->select();
-
-    // debuging
-    for( int i = 0; i < m_nTotal; ++i)
-    {
-        QSqlRecord myrecord = m_sqlModel->record(i);
-        QString id = myrecord.value("id").toString();
-        QString name = myrecord.value("LAYERNAME").toString();
-        qDebug() <<"ID: " <<id << "; name: " << name ;
-    }
-
-    qDebug()<<m_sqlModel->index(0,0).row();
-    // manually update the primary key of the table
-    for( int i = rowDel; i < m_nTotal; ++i)
-    {
-        qDebug() <<"old ID: " << m_sqlModel->record(i).value("id").toString() << "; new ID: " << i+1 ;
-        m_sqlModel->setData(m_sqlModel->index(i,0),QString::number(i+1),Qt::EditRole);
-    }
-    m_sqlModel->submitAll();
-    m_sqlModel->select();
-
-    // debuging
-    for( int i = 0; i < m_nTotal; ++i)
-    {
-        QSqlRecord myrecord = m_sqlModel->record(i);
-        QString id = myrecord.value("id").toString();
-        QString name = myrecord.value("LAYERNAME").toString();
-        qDebug() <<"ID: " <<id << "; name: " << name ;
-    }
-
-
+    bool ok = m_sqlModel->submitAll();
+    ok = m_sqlModel->closeGapAt(rowDel) && ok;
+    m_sqlModel->endTransaction(ok);
 
     int currentRow = qMin(int(rowDel+1),int(m_nTotal));
     m_nCurPage = qCeil(double(currentRow) / double(m_nPageSize));
@@ -683,15 +524,6 @@ void BonzaTableView::removeOneRow(int rowDel)
     m_sqlModel->setActive(rowDel);
     setCurrentIndex(m_sqlModel->index(rowDel, LAYERNAME));
 
-    // debuging
-    for( int i = 0; i < m_nTotal; ++i)
-    {
-        QSqlRecord myrecord = m_sqlModel->record(i);
-        QString id = myrecord.value("id").toString();
-        QString name = myrecord.value("LAYERNAME").toString();
-        qDebug() <<"ID: " <<id << "; name: " << name ;
-    }
-
 }
 
 void BonzaTableView::remove()
@@ -56,6 +56,13 @@ bool DatabaseManager::createConnect()
             qDebug() << "error code: " << m_db.lastError();
             return false;
         }
+
+        // the layer table is rewritten on every edit; with a write ahead log
+        // and no sync on each commit the writes do not wait on the disk
+        QSqlQuery pragma(m_db);
+        pragma.exec("PRAGMA journal_mode=WAL");
+        pragma.exec("PRAGMA synchronous=NORMAL");
+        pragma.exec("PRAGMA temp_store=MEMORY");
     }
 
     return true;
@@ -78,6 +78,16 @@ void ElementModel::addElement(QString type, int tag, int i, int j, int k, int l,
 
 }
 
+QRectF ElementModel::getRect(int row) const
+{
+    // the nodes are numbered from 1, i is at the bottom left and k at the top right
+    int i = mRecords[row][iRole].toInt() - 1;
+    int k = mRecords[row][kRole].toInt() - 1;
+    if (i < 0 || k < 0 || i >= int(nodes.size()) || k >= int(nodes.size()))
+        return QRectF();
+    return QRectF(QPointF(nodes[i]->x(), nodes[i]->y()), QPointF(nodes[k]->x(), nodes[k]->y())).normalized();
+}
+
 void ElementModel::clear()
 {
 
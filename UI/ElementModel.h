@@ -2,6 +2,8 @@
 #define ELEMENTMODEL_H
 
 #include <QAbstractListModel>
+#include <QRectF>
+#include <QColor>
 #include "Mesher.h"
 
 
@@ -44,6 +46,9 @@ public:
     void setWidth(double w){m_w = w;}
     void setTotalHeight(double h){m_h = h;}
     void setNodes(std::vector<Nodex*> nods){nodes = nods;}
+    // the element in the coordinates of the mesh, from the nodes at its corners
+    QRectF getRect(int row) const;
+    QColor getColor(int row) const {return QColor(mRecords[row][mcolorRole].toString());}
 
     Q_INVOKABLE void setActive(int row)
     {
@@ -0,0 +1,239 @@
+#include "LiveResultsMonitor.h"
+#include "ElementModel.h"
+#include "ResponseDataService.h"
+
+#include <QDir>
+#include <cstring>
+#include <atomic>
+
+// the layout of the start of a feed, see FEM/LiveFeedStream.h
+static const char liveFeedMagic[8] = {'S','R','T','F','E','E','D','1'};
+static const int headerSize = 40;
+static const int numColumnsOffset = 8;
+static const int capacityOffset = 12;
+static const int statusOffset = 16;
+static const int abortOffset = 20;
+static const int endTimeOffset = 24;
+static const int numRowsOffset = 32;
+
+template <typename T>
+static T readField(const uchar *map, int offset)
+{
+    return *reinterpret_cast<const volatile T*>(map + offset);
+}
+
+
+LiveResultsMonitor::LiveResultsMonitor(ElementModel *emodel, QObject *parent)
+    : QObject(parent), elementModel(emodel)
+{
+    timer.setInterval(200);
+    connect(&timer, SIGNAL(timeout()), this, SLOT(poll()));
+}
+
+LiveResultsMonitor::~LiveResultsMonitor()
+{
+    closeFeed(surface);
+    closeFeed(stress);
+}
+
+void LiveResultsMonitor::start(const QString &outputDir)
+{
+    stop();
+    closeFeed(surface);
+    closeFeed(stress);
+
+    // feeds left by an earlier run would be taken for this one's
+    surface.file.setFileName(QDir(outputDir).filePath("surface.live"));
+    stress.file.setFileName(QDir(outputDir).filePath("stress.live"));
+    QFile::remove(surface.file.fileName());
+    QFile::remove(stress.file.fileName());
+
+    status = Waiting;
+    time = 0.0;
+    endTime = 0.0;
+    polling = true;
+    timer.start();
+    emit updated();
+}
+
+void LiveResultsMonitor::stop()
+{
+    if (!polling)
+        return;
+    // pick up what was written since the last poll
+    poll();
+    timer.stop();
+    if (polling)
+    {
+        polling = false;
+        emit updated();
+    }
+}
+
+QVariantMap LiveResultsMonitor::getSurfaceMotion(int maxPoints)
+{
+    if (surface.numColumns < 2)
+        return QVariantMap();
+    const QVector<double> &x = surface.columns[0];
+    return ResponseDataService::makeSeries("Surface motion", x, surface.columns[1], 0, x.size(), maxPoints);
+}
+
+QVariantMap LiveResultsMonitor::getRu(int elementID, int maxPoints)
+{
+    // the feed lists the elements from the bottom up, the model from the top down
+    int numEles = elementModel->getSize();
+    if (elementID < 0 || elementID >= numEles)
+        return QVariantMap();
+    int column = 2 + 3*(numEles - 1 - elementID);
+    if (column >= stress.numColumns || stress.columns[0].isEmpty())
+        return QVariantMap();
+
+    // the stress at the first step is taken as the initial effective stress
+    const QVector<double> &x = stress.columns[0];
+    const QVector<double> &s = stress.columns[column];
+    double s0 = s[0];
+    if (s0 == 0.0)
+        return QVariantMap();
+    QVector<double> ru(s.size());
+    for (int i=0; i<s.size(); i++)
+        ru[i] = -(s[i] - s0) / s0;
+
+    return ResponseDataService::makeSeries("ru Element "+QString::number(elementID), x, ru, 0, x.size(), maxPoints);
+}
+
+void LiveResultsMonitor::abort()
+{
+    bool flagged = false;
+    Feed *feeds[] = {&surface, &stress};
+    for (Feed *feed : feeds)
+        if (feed->map != nullptr)
+        {
+            *reinterpret_cast<volatile int*>(feed->map + abortOffset) = 1;
+            flagged = true;
+        }
+
+    if (!flagged)
+    {
+        stop();
+        emit abortRequested();
+    }
+}
+
+void LiveResultsMonitor::poll()
+{
+    bool changed = false;
+    bool hadSurface = surface.map != nullptr;
+    Feed *feeds[] = {&surface, &stress};
+    for (Feed *feed : feeds)
+        if (feed->map != nullptr || openFeed(*feed))
+            changed = readFeed(*feed) || changed;
+    if (!hadSurface && surface.map != nullptr)
+        emit feedOpened();
+
+    if (surface.map != nullptr)
+    {
+        int newStatus = readField<int>(surface.map, statusOffset);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        endTime = readField<double>(surface.map, endTimeOffset);
+        if (!surface.columns[0].isEmpty())
+            time = surface.columns[0].last();
+        if (newStatus != status)
+        {
+            status = newStatus;
+            changed = true;
+        }
+        // the rows are all in before the status changes, so they were read
+        // above and the feeds can be let go
+        if (status != Running && readFeed(surface) == false && (stress.map == nullptr || readFeed(stress) == false))
+        {
+            timer.stop();
+            polling = false;
+            closeFeed(surface);
+            closeFeed(stress);
+            changed = true;
+        }
+    }
+
+    if (changed)
+        emit updated();
+}
+
+bool LiveResultsMonitor::openFeed(Feed &feed)
+{
+    if (!feed.file.exists() || feed.file.size() < headerSize)
+        return false;
+    if (!feed.file.isOpen() && !feed.file.open(QIODevice::ReadWrite))
+        return false;
+
+    qint64 size = feed.file.size();
+    uchar *map = feed.file.map(0, size);
+    if (map == nullptr)
+        return false;
+
+    // the magic goes in last, a feed without it is still being set up
+    if (memcmp(map, liveFeedMagic, sizeof(liveFeedMagic)) != 0)
+    {
+        feed.file.unmap(map);
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    int numColumns = readField<int>(map, numColumnsOffset);
+    int capacity = readField<int>(map, capacityOffset);
+    if (numColumns < 1 || capacity < 1 || size < headerSize + qint64(numColumns)*capacity*qint64(sizeof(double)))
+    {
+        feed.file.unmap(map);
+        return false;
+    }
+
+    feed.map = map;
+    feed.numColumns = numColumns;
+    feed.capacity = capacity;
+    feed.rowsRead = 0;
+    feed.columns.fill(QVector<double>(), numColumns);
+    return true;
+}
+
+void LiveResultsMonitor::closeFeed(Feed &feed)
+{
+    if (feed.map != nullptr)
+        feed.file.unmap(feed.map);
+    feed.map = nullptr;
+    feed.file.close();
+}
+
+bool LiveResultsMonitor::readFeed(Feed &feed)
+{
+    if (feed.map == nullptr)
+        return false;
+
+    qint64 numRows = readField<qint64>(feed.map, numRowsOffset);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (numRows <= feed.rowsRead)
+        return false;
+
+    // rows more than a ring behind are gone
+    qint64 first = qMax(feed.rowsRead, numRows - feed.capacity);
+    const double *rows = reinterpret_cast<const double*>(feed.map + headerSize);
+    QVector<double> copied;
+    copied.reserve(int(numRows - first)*feed.numColumns);
+    for (qint64 n=first; n<numRows; n++)
+    {
+        const double *row = rows + (n % feed.capacity)*feed.numColumns;
+        for (int i=0; i<feed.numColumns; i++)
+            copied << row[i];
+    }
+
+    // the writer may have gone round the ring while the rows were copied
+    std::atomic_thread_fence(std::memory_order_acquire);
+    qint64 numRowsAfter = readField<qint64>(feed.map, numRowsOffset);
+    qint64 firstValid = qMax(first, numRowsAfter - feed.capacity);
+    for (qint64 n=firstValid; n<numRows; n++)
+    {
+        const double *row = copied.constData() + (n - first)*feed.numColumns;
+        for (int i=0; i<feed.numColumns; i++)
+            feed.columns[i] << row[i];
+    }
+
+    feed.rowsRead = numRows;
+    return true;
+}
@@ -0,0 +1,83 @@
+#ifndef LIVERESULTSMONITOR_H
+#define LIVERESULTSMONITOR_H
+
+#include <QObject>
+#include <QFile>
+#include <QTimer>
+#include <QVector>
+#include <QVariantMap>
+
+class ElementModel;
+
+// Follows the live feeds (surface.live and stress.live) the analysis writes
+// while it runs and publishes them to the pages over the web channel. The
+// feeds are ring buffers in memory mapped files, see FEM/LiveFeedStream.h;
+// they are polled, and the rows written since the last poll are appended to
+// the histories kept here.
+class LiveResultsMonitor : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY updated)
+    Q_PROPERTY(double progress READ getProgress NOTIFY updated)
+    Q_PROPERTY(double time READ getTime NOTIFY updated)
+    Q_PROPERTY(int status READ getStatus NOTIFY updated)
+public:
+    explicit LiveResultsMonitor(ElementModel *emodel, QObject *parent = nullptr);
+    ~LiveResultsMonitor();
+
+    enum {Waiting = -1, Running = 0, Finished = 1, Failed = 2, Aborted = 3};
+
+    // forgets the last run and follows the feeds in outputDir
+    void start(const QString &outputDir);
+    void stop();
+
+    bool isRunning() const {return polling && (status == Waiting || status == Running);}
+    double getProgress() const {return endTime > 0.0 ? qBound(0.0, time/endTime, 1.0) : 0.0;}
+    double getTime() const {return time;}
+    int getStatus() const {return status;}
+
+    // the surface acceleration recorded so far
+    Q_INVOKABLE QVariantMap getSurfaceMotion(int maxPoints);
+    // the excess pore pressure ratio of an element so far
+    Q_INVOKABLE QVariantMap getRu(int elementID, int maxPoints);
+    // asks the analysis to stop after the step it is taking; an analysis
+    // without feeds cannot be asked, abortRequested is emitted for whoever
+    // runs it to stop it
+    Q_INVOKABLE void abort();
+
+signals:
+    void updated();
+    // the analysis writes the feeds, emitted once per run
+    void feedOpened();
+    void abortRequested();
+
+private slots:
+    void poll();
+
+private:
+    struct Feed
+    {
+        QFile file;
+        uchar *map = nullptr;
+        int numColumns = 0;
+        int capacity = 0;
+        qint64 rowsRead = 0;
+        QVector<QVector<double>> columns;
+    };
+
+    bool openFeed(Feed &feed);
+    void closeFeed(Feed &feed);
+    // appends the new rows of the feed, returns true if there were any
+    bool readFeed(Feed &feed);
+
+    ElementModel *elementModel;
+    QTimer timer;
+    bool polling = false;
+    Feed surface;
+    Feed stress;
+    int status = Waiting;
+    double time = 0.0;
+    double endTime = 0.0;
+};
+
+#endif // LIVERESULTSMONITOR_H
@@ -0,0 +1,261 @@
+#include "MeshItem.h"
+#include "ResultFile.h"
+
+#include <QDir>
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+#include <cmath>
+
+// a field keeps at most this many frames, rows between them are dropped
+static const int maxFrames = 1000;
+
+MeshItem::MeshItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void MeshItem::setModel(ElementModel *emodel)
+{
+    if (emodel == elementModel)
+        return;
+    if (elementModel != nullptr)
+        disconnect(elementModel, nullptr, this, nullptr);
+    elementModel = emodel;
+    if (elementModel != nullptr)
+    {
+        connect(elementModel, SIGNAL(modelReset()), this, SLOT(readModel()));
+        connect(elementModel, SIGNAL(dataChanged(const QModelIndex&,const QModelIndex&)), this, SLOT(readModel()));
+    }
+    readModel();
+    emit modelChanged();
+}
+
+void MeshItem::setOutputDir(const QString &dir)
+{
+    m_outputDir = dir;
+    loadField();
+}
+
+void MeshItem::setField(const QString &name)
+{
+    if (name == m_field)
+        return;
+    m_field = name;
+    loadField();
+}
+
+void MeshItem::setFrame(int frame)
+{
+    frame = qBound(0, frame, qMax(0, times.size()-1));
+    if (frame == m_frame)
+        return;
+    m_frame = frame;
+    update();
+    emit frameChanged();
+}
+
+int MeshItem::elementAt(qreal x, qreal y) const
+{
+    for (int row=0; row<rects.size(); row++)
+        if (toItem(rects[row]).contains(x, y))
+            return row;
+    return -1;
+}
+
+void MeshItem::readModel()
+{
+    int numEles = elementModel != nullptr ? elementModel->getSize() : 0;
+    bool sameMesh = numEles == rects.size();
+
+    QVector<QRectF> newRects(numEles);
+    colors.resize(numEles);
+    bounds = QRectF();
+    for (int row=0; row<numEles; row++)
+    {
+        newRects[row] = elementModel->getRect(row);
+        colors[row] = elementModel->getColor(row);
+        bounds = bounds.united(newRects[row]);
+        sameMesh = sameMesh && newRects[row] == rects[row];
+    }
+    rects = newRects;
+    activeRow = elementModel != nullptr ? elementModel->getActiveID() : -1;
+
+    // a field recorded on another mesh does not go with this one
+    if (!sameMesh && !values.isEmpty())
+        loadField();
+    update();
+}
+
+void MeshItem::loadField()
+{
+    values.clear();
+    times.clear();
+    m_fieldMin = 0.0;
+    m_fieldMax = 0.0;
+    m_frame = 0;
+
+    // the recorders list the elements from the bottom up, the mesh from the top down
+    int numEles = rects.size();
+    bool isStrain = m_field == "strain";
+    if (numEles > 0 && (isStrain || m_field == "ru") && !m_outputDir.isEmpty())
+    {
+        ResultFile file(QDir(m_outputDir).filePath(isStrain ? "strain.out" : "stress.out"));
+        QVector<double> row;
+        QVector<double> firstStress;
+        int stride = 1;
+        for (int n=0; file.isOpen() && file.readRow(row); n++)
+        {
+            if (row.size() < 1 + 3*numEles)
+                break;
+            if (!isStrain && firstStress.isEmpty())
+            {
+                firstStress.resize(numEles);
+                for (int e=0; e<numEles; e++)
+                    firstStress[e] = row[2 + 3*(numEles-1-e)];
+            }
+            if (n % stride != 0)
+                continue;
+
+            // keep every other frame once there are too many, and from then
+            // on read only every other row
+            if (times.size() == maxFrames)
+            {
+                for (int f=0; f<maxFrames/2; f++)
+                {
+                    times[f] = times[2*f];
+                    for (int e=0; e<numEles; e++)
+                        values[f*numEles + e] = values[2*f*numEles + e];
+                }
+                times.resize(maxFrames/2);
+                values.resize(maxFrames/2*numEles);
+                stride *= 2;
+                if (n % stride != 0)
+                    continue;
+            }
+
+            times << row[0];
+            for (int e=0; e<numEles; e++)
+            {
+                int fromBottom = numEles-1-e;
+                double value;
+                if (isStrain)
+                    value = row[3 + 3*fromBottom];
+                else
+                {
+                    double s0 = firstStress[e];
+                    value = s0 != 0.0 ? -(row[2 + 3*fromBottom] - s0) / s0 : 0.0;
+                }
+                values << float(value);
+            }
+        }
+
+        for (int i=0; i<values.size(); i++)
+        {
+            m_fieldMin = qMin(m_fieldMin, double(values[i]));
+            m_fieldMax = qMax(m_fieldMax, double(values[i]));
+        }
+        // the strain goes both ways, the colours are centred on zero
+        if (isStrain)
+        {
+            double maxAbs = qMax(-m_fieldMin, m_fieldMax);
+            m_fieldMin = -maxAbs;
+            m_fieldMax = maxAbs;
+        }
+    }
+
+    update();
+    emit fieldChanged();
+    emit frameChanged();
+}
+
+QRectF MeshItem::toItem(const QRectF &rect) const
+{
+    // the mesh is stretched to the item, with its top at the top
+    if (bounds.width() <= 0.0 || bounds.height() <= 0.0)
+        return QRectF();
+    double sx = width() / bounds.width();
+    double sy = height() / bounds.height();
+    return QRectF((rect.left() - bounds.left()) * sx, (bounds.bottom() - rect.bottom()) * sy,
+                  rect.width() * sx, rect.height() * sy);
+}
+
+QColor MeshItem::colorMap(double t)
+{
+    // blue through green and yellow to red
+    t = qBound(0.0, t, 1.0);
+    double r = qBound(0.0, 1.5 - std::fabs(4.0*t - 3.0), 1.0);
+    double g = qBound(0.0, 1.5 - std::fabs(4.0*t - 2.0), 1.0);
+    double b = qBound(0.0, 1.5 - std::fabs(4.0*t - 1.0), 1.0);
+    return QColor::fromRgbF(r, g, b);
+}
+
+static void setQuad(QSGGeometry::ColoredPoint2D *v, quint32 *idx, int quad, const QRectF &r, const QColor &c)
+{
+    QSGGeometry::ColoredPoint2D *p = v + 4*quad;
+    uchar red = uchar(c.red()), green = uchar(c.green()), blue = uchar(c.blue()), alpha = uchar(c.alpha());
+    p[0].set(float(r.left()), float(r.top()), red, green, blue, alpha);
+    p[1].set(float(r.right()), float(r.top()), red, green, blue, alpha);
+    p[2].set(float(r.right()), float(r.bottom()), red, green, blue, alpha);
+    p[3].set(float(r.left()), float(r.bottom()), red, green, blue, alpha);
+
+    quint32 *i = idx + 6*quad;
+    quint32 first = quint32(4*quad);
+    i[0] = first; i[1] = first+1; i[2] = first+2;
+    i[3] = first; i[4] = first+2; i[5] = first+3;
+}
+
+QSGNode *MeshItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    QSGGeometryNode *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (node == nullptr)
+    {
+        node = new QSGGeometryNode;
+        QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0, 0,
+                                                QSGGeometry::UnsignedIntType);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new QSGVertexColorMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+    }
+
+    // a quad for each element and a line along its top, and the outline of
+    // the active element
+    int numEles = rects.size();
+    bool hasActive = activeRow >= 0 && activeRow < numEles;
+    int numQuads = 2*numEles + (hasActive ? 4 : 0);
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate(4*numQuads, 6*numQuads);
+    QSGGeometry::ColoredPoint2D *v = geometry->vertexDataAsColoredPoint2D();
+    quint32 *idx = geometry->indexDataAsUInt();
+
+    bool showField = !times.isEmpty() && m_fieldMax > m_fieldMin;
+    const float *frameValues = showField ? values.constData() + m_frame*numEles : nullptr;
+    int quad = 0;
+    for (int row=0; row<numEles; row++)
+    {
+        QRectF r = toItem(rects[row]);
+        QColor c = showField ? colorMap((frameValues[row] - m_fieldMin) / (m_fieldMax - m_fieldMin)) : colors[row];
+        setQuad(v, idx, quad++, r, c);
+        setQuad(v, idx, quad++, QRectF(r.left(), r.top(), r.width(), 0.5), Qt::black);
+    }
+    if (hasActive)
+    {
+        QRectF r = toItem(rects[activeRow]);
+        const qreal w = 2.0;
+        setQuad(v, idx, quad++, QRectF(r.left(), r.top(), r.width(), w), Qt::red);
+        setQuad(v, idx, quad++, QRectF(r.left(), r.bottom()-w, r.width(), w), Qt::red);
+        setQuad(v, idx, quad++, QRectF(r.left(), r.top(), w, r.height()), Qt::red);
+        setQuad(v, idx, quad++, QRectF(r.right()-w, r.top(), w, r.height()), Qt::red);
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
+
+void MeshItem::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    update();
+}
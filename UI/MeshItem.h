@@ -0,0 +1,80 @@
+#ifndef MESHITEM_H
+#define MESHITEM_H
+
+#include <QQuickItem>
+#include <QVector>
+#include <QColor>
+#include <QRectF>
+#include "ElementModel.h"
+
+// Draws the mesh of the soil column as a single scene graph node: every
+// element is a quad of the node's triangles, coloured by its layer or by a
+// scalar field of the results (the shear strain or ru of the element), and
+// the colours of a field are worked out here for the frame shown, so a
+// field can be animated over the time of the analysis.
+class MeshItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(ElementModel* model READ model WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(QString outputDir READ outputDir WRITE setOutputDir NOTIFY fieldChanged)
+    Q_PROPERTY(QString field READ field WRITE setField NOTIFY fieldChanged)
+    Q_PROPERTY(int numFrames READ numFrames NOTIFY fieldChanged)
+    Q_PROPERTY(double fieldMin READ fieldMin NOTIFY fieldChanged)
+    Q_PROPERTY(double fieldMax READ fieldMax NOTIFY fieldChanged)
+    Q_PROPERTY(int frame READ frame WRITE setFrame NOTIFY frameChanged)
+    Q_PROPERTY(double time READ time NOTIFY frameChanged)
+public:
+    explicit MeshItem(QQuickItem *parent = nullptr);
+
+    ElementModel *model() const {return elementModel;}
+    void setModel(ElementModel *emodel);
+    QString outputDir() const {return m_outputDir;}
+    void setOutputDir(const QString &dir);
+    // "" for the layer colours, "strain" or "ru"
+    QString field() const {return m_field;}
+    void setField(const QString &name);
+    int numFrames() const {return times.size();}
+    double fieldMin() const {return m_fieldMin;}
+    double fieldMax() const {return m_fieldMax;}
+    int frame() const {return m_frame;}
+    void setFrame(int frame);
+    double time() const {return m_frame < times.size() ? times[m_frame] : 0.0;}
+
+    // the row of the element at a point of the item, -1 if there is none
+    Q_INVOKABLE int elementAt(qreal x, qreal y) const;
+
+signals:
+    void modelChanged();
+    void fieldChanged();
+    void frameChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+    void geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private slots:
+    void readModel();
+
+private:
+    void loadField();
+    QRectF toItem(const QRectF &rect) const;
+    static QColor colorMap(double t);
+
+    ElementModel *elementModel = nullptr;
+    // the elements from the top down, in the coordinates of the mesh
+    QVector<QRectF> rects;
+    QVector<QColor> colors;
+    QRectF bounds;
+    int activeRow = -1;
+
+    QString m_outputDir;
+    QString m_field;
+    // the value of every element at every frame, frame after frame
+    QVector<float> values;
+    QVector<double> times;
+    double m_fieldMin = 0.0;
+    double m_fieldMax = 0.0;
+    int m_frame = 0;
+};
+
+#endif // MESHITEM_H
@@ -1,4 +1,7 @@
 #include "PostProcessor.h"
+#include "ResultFile.h"
+#include <QtConcurrent>
+#include <QFileInfo>
 
 PostProcessor::PostProcessor(QWidget *parent) : QDialog(parent)
 {
@@ -25,15 +28,71 @@ int PostProcessor::getEleCount()
     return eleCount;
 }
 
+PostProcessor::~PostProcessor()
+{
+    waitForUpdate();
+}
+
+// the depths come first, every profile needs them; the four profiles read
+// different files and are reduced on the global thread pool, each one
+// announced by profileUpdated as soon as it is done and the last one also
+// by updateFinished
 void PostProcessor::update()
 {
+    waitForUpdate();
+
     calcDepths();
     calcRuDepths();
-    calcPGA();
-    calcGamma();
-    calcDisp();
-    calcRu();
-    emit updateFinished();
+
+    pendingProfiles = 4;
+    m_jobs.clear();
+    m_jobs << QtConcurrent::run([this]() { calcPGA(); profileFinished("pga"); });
+    m_jobs << QtConcurrent::run([this]() { calcGamma(); profileFinished("gamma"); });
+    m_jobs << QtConcurrent::run([this]() { calcDisp(); profileFinished("disp"); });
+    m_jobs << QtConcurrent::run([this]() { calcRu(); profileFinished("ru"); });
+}
+
+void PostProcessor::waitForUpdate()
+{
+    for (int i=0; i<m_jobs.size(); i++)
+        m_jobs[i].waitForFinished();
+}
+
+void PostProcessor::profileFinished(const QString &name)
+{
+    emit profileUpdated(name);
+    if (pendingProfiles.fetchAndAddOrdered(-1) == 1)
+        emit updateFinished();
+}
+
+
+// reads the given column from the rows first, first+stride, ... of a
+// profile file; returns false if there is none, e.g. older results or an
+// OpenSees run, or if it is older than the output it was reduced from, a
+// profile left by an earlier run
+bool PostProcessor::readProfile(const QString &fileName, const QString &outFileName, int column, int first, int stride, QVector<double> &v)
+{
+    QFileInfo profInfo(fileName);
+    QFileInfo outInfo(outFileName);
+    if (!profInfo.exists() || (outInfo.exists() && profInfo.lastModified() < outInfo.lastModified()))
+        return false;
+
+    ResultFile file(fileName);
+    if (!file.isOpen())
+        return false;
+
+    v.clear();
+    QVector<double> thisLine;
+    int row = 0;
+    while(file.readRow(thisLine)) {
+        if (thisLine.size()<=column)
+            break;
+        if (row>=first && (row-first)%stride==0)
+            v << thisLine[column];
+        row++;
+    }
+
+    return !v.isEmpty();
 }
 
 
@@ -42,21 +101,16 @@ void PostProcessor::calcDepths()
 
 
     //QString nodesFileName = "out_tcl/nodesInfo.dat";
-    QFile nodesFile(nodesFileName);
+    ResultFile nodesFile(nodesFileName);
     QVector<double> depths;
-    if(nodesFile.open(QIODevice::ReadOnly)) {
-        QTextStream in(&nodesFile);
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
-            if (thisLine.size()<3)
-                break;
-            else
-            {
-                depths.append(thisLine[2].toDouble());
-            }
+    QVector<double> thisLine;
+    while(nodesFile.readRow(thisLine)) {
+        if (thisLine.size()<3)
+            break;
+        else
+        {
+            depths.append(thisLine[2]);
         }
-        nodesFile.close();
     }
 
 
@@ -99,22 +153,19 @@ void PostProcessor::calcRuDepths()
 void PostProcessor::calcPGA()
 {
     //QString accFileName = accFileName;
-    QFile accFile(accFileName);
     QVector<double> pga;
-    if(accFile.open(QIODevice::ReadOnly)) {
-        QTextStream in(&accFile);
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
+    if(!readProfile(accProfileFileName, accFileName, 2, 0, 2, pga)) {
+        ResultFile accFile(accFileName);
+        QVector<double> thisLine;
+        while(accFile.readRow(thisLine)) {
             if (thisLine.size()<2)
                 break;
             else
             {
-                thisLine.removeAll("");
                 QVector<double> thispga;
                 for (int i=1; i<thisLine.size();i+=4)// TODO: 3D?
                 {
-                    double tmp = fabs(thisLine[i].trimmed().toDouble());
+                    double tmp = fabs(thisLine[i]);
                     thispga << tmp;
                 }
                 if(pga.size()!=thispga.size() && pga.size()<1)
@@ -132,7 +183,6 @@ void PostProcessor::calcPGA()
                 }
             }
         }
-        accFile.close();
     }
 
     if (m_pga.size()>0)
@@ -162,23 +212,19 @@ void PostProcessor::calcPGA()
 
 void PostProcessor::calcGamma()
 {
-    QString FileName = strainFileName;
-    QFile File(FileName);
     QVector<double> v;
-    if(File.open(QIODevice::ReadOnly)) {
-        QTextStream in(&File);
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
+    if(!readProfile(strainProfileFileName, strainFileName, 2, 2, 3, v)) {
+        ResultFile File(strainFileName);
+        QVector<double> thisLine;
+        while(File.readRow(thisLine)) {
             if (thisLine.size()<2)
                 break;
             else
             {
-                thisLine.removeAll("");
                 QVector<double> thisv;
                 for (int i=3; i<thisLine.size();i+=3)// TODO: 3D?
                 {
-                    double tmp = fabs(thisLine[i].trimmed().toDouble());
+                    double tmp = fabs(thisLine[i]);
                     thisv << tmp;
                 }
                 if(v.size()!=thisv.size() && v.size()<1)
@@ -196,7 +242,6 @@ void PostProcessor::calcGamma()
                 }
             }
         }
-        File.close();
     }
 
     if (m_gamma.size()>0)
@@ -222,25 +267,21 @@ void PostProcessor::calcGamma()
 
 void PostProcessor::calcDisp()
 {
-    QString FileName = dispFileName;
-    QFile File(FileName);
     QVector<double> v;
     QVector<double> v1;
     double thisDisp;
-    if(File.open(QIODevice::ReadOnly)) {
-        QTextStream in(&File);
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
+    if(!readProfile(dispProfileFileName, dispFileName, 4, 0, 2, v)) {
+        ResultFile File(dispFileName);
+        QVector<double> thisLine;
+        while(File.readRow(thisLine)) {
             if (thisLine.size()<2)
                 break;
             else
             {
-                thisLine.removeAll("");
                 QVector<double> thisv;
                 for (int i=1; i<thisLine.size();i+=4)// TODO: 3D?
                 {
-                    double tmp = fabs(thisLine[i].trimmed().toDouble());
+                    double tmp = fabs(thisLine[i]);
                     thisv << tmp;
                 }
                 if(v.size()!=thisv.size() && v.size()<1)
@@ -262,7 +303,6 @@ void PostProcessor::calcDisp()
                 }
             }
         }
-        File.close();
     }
 
     if (m_disp.size()>0)
@@ -288,28 +328,24 @@ void PostProcessor::calcDisp()
 
 void PostProcessor::calcRu()
 {
-    QString FileName = stressFileName;
-    QFile File(FileName);
     QVector<double> v;
     QVector<double> v1;
     double thisValue;
 
     eleCount = getEleCount();
 
-    if(File.open(QIODevice::ReadOnly)) {
-        QTextStream in(&File);
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
+    if(!readProfile(stressProfileFileName, stressFileName, 5, 1, 3, v)) {
+        ResultFile File(stressFileName);
+        QVector<double> thisLine;
+        while(File.readRow(thisLine)) {
             if (thisLine.size()<2)
                 break;
             else
             {
-                thisLine.removeAll("");
                 QVector<double> thisv;
                 for (int i=2; i<thisLine.size();i+=3)// TODO: 3D?
                 {
-                    double tmp = (thisLine[i].trimmed().toDouble());
+                    double tmp = thisLine[i];
                     thisv << tmp;
                 }
                 if(v.size()!=thisv.size() && v.size()<1)// first time
@@ -331,7 +367,6 @@ void PostProcessor::calcRu()
                 }
             }
         }
-        File.close();
     }
 
     if (m_ru.size()>0)
@@ -7,6 +7,8 @@
 #include <QFile>
 #include <QDir>
 #include <QTextStream>
+#include <QFuture>
+#include <QAtomicInt>
 #include <math.h>
 
 class PostProcessor : public QDialog
@@ -16,14 +18,17 @@ public:
     explicit PostProcessor(QWidget *parent = nullptr);
     PostProcessor(QTabWidget *tab,QWidget *parent = nullptr);
     PostProcessor(QString outDir) : m_outputDir(outDir){}
+    ~PostProcessor();
     void calcPGA();
     void update();
+    void waitForUpdate();
     void calcDepths();
     void calcGamma();
     void calcDisp();
     void calcRu();
     void calcRuDepths();
     int getEleCount();
+    bool readProfile(const QString &fileName, const QString &outFileName, int column, int first, int stride, QVector<double> &v);
 
     QVector<double> getPga(){return m_pga;}
     QVector<double> getDepths(){return m_depths;}
@@ -44,8 +49,14 @@ public:
 
 
 signals:
+    // name is pga, gamma, disp or ru; emitted from the thread that reduced it
+    void profileUpdated(QString name);
     void updateFinished();
 private:
+    void profileFinished(const QString &name);
+
+    QList<QFuture<void>> m_jobs;
+    QAtomicInt pendingProfiles;
     QVector<double> m_pga;
     QVector<double> m_depths;
     QVector<double> m_ruDepths;
@@ -66,6 +77,13 @@ private:
     QString stressFileName = QDir(m_outputDir).filePath("stress.out");
     QString pwpFileName = QDir(m_outputDir).filePath("porePressure.out");
 
+    // envelopes reduced during the analysis, one line per recorded column:
+    // min max absMax timeOfAbsMax maxGrowth maxDrop
+    QString accProfileFileName = QDir(m_outputDir).filePath("acceleration.prof");
+    QString dispProfileFileName = QDir(m_outputDir).filePath("displacement.prof");
+    QString strainProfileFileName = QDir(m_outputDir).filePath("strain.prof");
+    QString stressProfileFileName = QDir(m_outputDir).filePath("stress.prof");
+
     // processed dat
     QString pgaFileName = QDir(m_outputDir).filePath("pga.dat");
     QString ruFileName = QDir(m_outputDir).filePath("ru.dat");
@@ -113,6 +113,37 @@ void ProfileManager::onPostProcessorUpdated()
 
 }
 
+// shows one profile as soon as the post processor has it
+void ProfileManager::onProfileUpdated(QString name)
+{
+    QWebEngineView *view;
+    if (name=="pga")
+    {
+        updatePGAHtml();
+        view = pgaHtmlView;
+    }
+    else if (name=="gamma")
+    {
+        updateGammaHtml();
+        view = gammaHtmlView;
+    }
+    else if (name=="disp")
+    {
+        updateDispHtml();
+        view = dispHtmlView;
+    }
+    else if (name=="ru")
+    {
+        updateRuHtml();
+        view = ruHtmlView;
+    }
+    else
+        return;
+
+    view->reload();
+    view->show();
+}
+
 void ProfileManager::updatePGAHtml()
 {
     // get file paths
@@ -25,6 +25,7 @@ public:
 
 public slots:
     void onPostProcessorUpdated();
+    void onProfileUpdated(QString name);
     void onTabBarClicked(int);
 public:
     QString rootDir = qApp->applicationDirPath();
@@ -0,0 +1,207 @@
+#include "ResponseDataService.h"
+#include "ElementModel.h"
+#include "PostProcessor.h"
+#include "ResultFile.h"
+
+#include <QFileInfo>
+#include <QByteArray>
+#include <QStringList>
+#include <algorithm>
+
+static QString toBase64(const QVector<double> &v)
+{
+    QByteArray bytes(reinterpret_cast<const char*>(v.constData()), v.size()*int(sizeof(double)));
+    return QString::fromLatin1(bytes.toBase64());
+}
+
+// keeps the smallest and the largest value of each bucket, in time order
+static void minMaxReduce(const QVector<double> &x, const QVector<double> &y, int first, int last, int maxPoints,
+                         QVector<double> &xOut, QVector<double> &yOut)
+{
+    int count = last - first;
+    if (count <= maxPoints)
+    {
+        xOut = x.mid(first, count);
+        yOut = y.mid(first, count);
+        return;
+    }
+
+    int numBuckets = std::max(1, maxPoints/2);
+    xOut.reserve(2*numBuckets);
+    yOut.reserve(2*numBuckets);
+    for (int b=0; b<numBuckets; b++)
+    {
+        int start = first + int(qint64(b)*count/numBuckets);
+        int end = first + int(qint64(b+1)*count/numBuckets);
+        int iMin = start;
+        int iMax = start;
+        for (int i=start+1; i<end; i++)
+        {
+            if (y[i] < y[iMin])
+                iMin = i;
+            if (y[i] > y[iMax])
+                iMax = i;
+        }
+        int i1 = std::min(iMin, iMax);
+        int i2 = std::max(iMin, iMax);
+        xOut << x[i1];
+        yOut << y[i1];
+        if (i2 != i1)
+        {
+            xOut << x[i2];
+            yOut << y[i2];
+        }
+    }
+}
+
+
+ResponseDataService::ResponseDataService(ElementModel *emodel, QObject *parent)
+    : QObject(parent), elementModel(emodel)
+{
+
+}
+
+QVariantMap ResponseDataService::getMotion(const QString &name, double tStart, double tEnd, int maxPoints)
+{
+    if (name == "rock")
+        return getSeries(rockMotionFile, 1, "Rock motion", tStart, tEnd, maxPoints);
+
+    QStringList parts = name.split(".");
+    if (parts.size() != 2 || (parts[0] != "base" && parts[0] != "surface")
+            || (parts[1] != "acc" && parts[1] != "vel" && parts[1] != "disp"))
+    {
+        qWarning("motion must be rock, base.<acc|vel|disp> or surface.<acc|vel|disp>!");
+        return QVariantMap();
+    }
+
+    QString seriesName = parts[0]=="base" ? "Rock motion" : "Surface motion";
+    return getSeries(analysisDir+"/out_tcl/"+name, 1, seriesName, tStart, tEnd, maxPoints);
+}
+
+QVariantMap ResponseDataService::getResponse(const QString &type, int elementID, double tStart, double tEnd, int maxPoints)
+{
+    if (postProcessor == nullptr)
+        return QVariantMap();
+
+    // the recorders list the elements from the bottom up, the model from the top down
+    int numEles = elementModel->getSize();
+    if (elementID < 0 || elementID >= numEles)
+        return QVariantMap();
+    int fromBottom = numEles - 1 - elementID;
+
+    QString fileName;
+    QString seriesName;
+    int column;
+    if (type=="acc" || type=="vel" || type=="disp")
+    {
+        if (type=="acc")
+            fileName = postProcessor->getAccFileName();
+        else if (type=="vel")
+            fileName = postProcessor->getVelFileName();
+        else
+            fileName = postProcessor->getDispFileName();
+        column = 7 + 4*fromBottom;
+        seriesName = "Node "+QString::number(elementID);
+    }
+    else if (type=="pwp")
+    {
+        fileName = postProcessor->getPWPFileName();
+        column = 4 + 2*fromBottom;
+        seriesName = "Node "+QString::number(elementID);
+    }
+    else if (type=="strain" || type=="stress")
+    {
+        fileName = type=="strain" ? postProcessor->getStrainFileName() : postProcessor->getStressFileName();
+        column = 3 + 3*fromBottom;
+        seriesName = "Element "+QString::number(elementID);
+    }
+    else
+    {
+        qWarning("response must be acc, vel, disp, pwp, strain or stress!");
+        return QVariantMap();
+    }
+
+    return getSeries(fileName, column, seriesName, tStart, tEnd, maxPoints);
+}
+
+QVariantMap ResponseDataService::getSeries(const QString &fileName, int column, const QString &name,
+                                           double tStart, double tEnd, int maxPoints)
+{
+    QVariantMap result;
+    const Table *table = loadTable(fileName);
+    if (table == nullptr || column >= table->columns.size())
+        return result;
+
+    const QVector<double> &x = table->columns[0];
+    const QVector<double> &y = table->columns[column];
+    int first = 0;
+    int last = x.size();
+    if (tEnd >= tStart)
+    {
+        first = int(std::lower_bound(x.begin(), x.end(), tStart) - x.begin());
+        last = int(std::upper_bound(x.begin(), x.end(), tEnd) - x.begin());
+    }
+    return makeSeries(name, x, y, first, last, maxPoints);
+}
+
+QVariantMap ResponseDataService::makeSeries(const QString &name, const QVector<double> &x, const QVector<double> &y,
+                                            int first, int last, int maxPoints)
+{
+    QVariantMap result;
+    if (last <= first)
+        return result;
+
+    QVector<double> xOut, yOut;
+    minMaxReduce(x, y, first, last, std::max(2, maxPoints), xOut, yOut);
+
+    result["name"] = name;
+    result["x"] = toBase64(xOut);
+    result["y"] = toBase64(yOut);
+    result["count"] = xOut.size();
+    result["total"] = x.size();
+    return result;
+}
+
+// reads a recorder file into columns; the table ends at the first row with a
+// different number of values than the first, e.g. one cut short by the writer
+const ResponseDataService::Table *ResponseDataService::loadTable(const QString &fileName)
+{
+    QFileInfo info(fileName);
+    if (fileName.isEmpty() || !info.exists())
+        return nullptr;
+
+    QHash<QString, Table>::iterator it = tables.find(fileName);
+    if (it != tables.end() && it->modified == info.lastModified() && it->size == info.size())
+        return &it.value();
+
+    ResultFile file(fileName);
+    if (!file.isOpen())
+        return nullptr;
+
+    Table table;
+    table.modified = info.lastModified();
+    table.size = info.size();
+
+    int numCols = 0;
+    QVector<double> row;
+    while (file.readRow(row))
+    {
+        if (numCols == 0)
+        {
+            numCols = row.size();
+            if (numCols < 2)
+                break;
+            table.columns.resize(numCols);
+        }
+        if (row.size() != numCols)
+            break;
+        for (int i=0; i<numCols; i++)
+            table.columns[i] << row[i];
+    }
+
+    if (numCols < 2)
+        return nullptr;
+
+    it = tables.insert(fileName, table);
+    return &it.value();
+}
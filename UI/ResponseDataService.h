@@ -0,0 +1,60 @@
+#ifndef RESPONSEDATASERVICE_H
+#define RESPONSEDATASERVICE_H
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QDateTime>
+#include <QVariantMap>
+
+class ElementModel;
+class PostProcessor;
+
+// Serves the recorded time histories to the plots in the web views over the
+// web channel. Each series goes out as base64 encoded Float64Arrays and is
+// reduced to the smallest and the largest value in each of maxPoints/2
+// buckets of the requested time window, so the plot looks the same as with
+// every sample but only a chart width of points is sent.
+class ResponseDataService : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ResponseDataService(ElementModel *emodel, QObject *parent = nullptr);
+
+    void setAnalysisDir(const QString &dir){analysisDir = dir;}
+    void setRockMotionFile(const QString &fileName){rockMotionFile = fileName;}
+    void setPostProcessor(PostProcessor *postProcessorIn){postProcessor = postProcessorIn;}
+    void clear(){tables.clear();}
+
+    // name is "rock" for the input motion, or base.<motion> / surface.<motion>
+    // with motion acc, vel or disp; a tEnd before tStart means the whole record
+    Q_INVOKABLE QVariantMap getMotion(const QString &name, double tStart, double tEnd, int maxPoints);
+    // type is acc, vel, disp or pwp at the top node of an element, or strain
+    // or stress in the element
+    Q_INVOKABLE QVariantMap getResponse(const QString &type, int elementID, double tStart, double tEnd, int maxPoints);
+
+    // the samples first to last-1 of a series, reduced to maxPoints and
+    // encoded the way the pages expect them
+    static QVariantMap makeSeries(const QString &name, const QVector<double> &x, const QVector<double> &y,
+                                  int first, int last, int maxPoints);
+
+private:
+    struct Table
+    {
+        QDateTime modified;
+        qint64 size = 0;
+        QVector<QVector<double>> columns;
+    };
+
+    const Table *loadTable(const QString &fileName);
+    QVariantMap getSeries(const QString &fileName, int column, const QString &name,
+                          double tStart, double tEnd, int maxPoints);
+
+    ElementModel *elementModel;
+    PostProcessor *postProcessor = nullptr;
+    QString analysisDir;
+    QString rockMotionFile;
+    QHash<QString, Table> tables;
+};
+
+#endif // RESPONSEDATASERVICE_H
@@ -0,0 +1,65 @@
+#include "ResultFile.h"
+#include "motionReader.h"
+
+#include <cstring>
+
+static inline bool isSeparator(char c)
+{
+    return c==' ' || c=='\t' || c=='\r' || c==',';
+}
+
+
+ResultFile::ResultFile(const QString &fileName)
+    : file(fileName)
+{
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    qint64 size = file.size();
+    if (size > 0)
+    {
+        data = reinterpret_cast<const char*>(file.map(0, size));
+        if (data == nullptr)
+        {
+            buffer = file.readAll();
+            data = buffer.constData();
+            size = buffer.size();
+        }
+    }
+    else
+        data = "";
+    pos = data;
+    end = data + size;
+}
+
+bool ResultFile::readRow(QVector<double> &row)
+{
+    row.clear();
+    while (pos < end && *pos=='#')
+    {
+        const char *lineEnd = static_cast<const char*>(memchr(pos, '\n', size_t(end - pos)));
+        pos = lineEnd ? lineEnd + 1 : end;
+    }
+    if (pos >= end)
+        return false;
+
+    const char *lineEnd = static_cast<const char*>(memchr(pos, '\n', size_t(end - pos)));
+    if (lineEnd == nullptr)
+        lineEnd = end;
+
+    const char *p = pos;
+    while (p < lineEnd)
+    {
+        while (p < lineEnd && isSeparator(*p))
+            p++;
+        if (p == lineEnd)
+            break;
+        double value;
+        if (!MotionReader::parseNumber(p, lineEnd, value))
+            break;
+        row << value;
+    }
+
+    pos = lineEnd < end ? lineEnd + 1 : end;
+    return true;
+}
@@ -0,0 +1,28 @@
+#ifndef RESULTFILE_H
+#define RESULTFILE_H
+
+#include <QFile>
+#include <QVector>
+
+// Reads the rows of numbers of a result file through a memory map of the
+// file. Lines starting with # are skipped, and the values of a row may be
+// separated by spaces, tabs or commas.
+class ResultFile
+{
+public:
+    explicit ResultFile(const QString &fileName);
+
+    bool isOpen() const {return data != nullptr;}
+    // reads the numbers of the next line into row, up to the first token that
+    // is not a number; returns false at the end of the file
+    bool readRow(QVector<double> &row);
+
+private:
+    QFile file;
+    QByteArray buffer; // the file is read into this when it cannot be mapped
+    const char *data = nullptr;
+    const char *pos = nullptr;
+    const char *end = nullptr;
+};
+
+#endif // RESULTFILE_H
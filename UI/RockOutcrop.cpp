@@ -3,6 +3,7 @@
 #include "ui_RockOutcrop.h"
 #include "InsertWindow.h"
 #include <QQmlContext>
+#include <QQmlEngine>
 
 #include <QTime>
 #include <QTimer>
@@ -19,6 +20,8 @@
 #include <QTabWidget>
 
 #include "SiteResponse.h"
+#include "ResultCache.h"
+#include "MeshItem.h"
 
 #include <QUiLoader>
 
@@ -153,6 +156,7 @@ RockOutcrop::RockOutcrop(QWidget *parent) :
 
 
     // add QQuickwidget for displaying mesh
+    qmlRegisterType<MeshItem>("SiteResponseTool", 1, 0, "MeshItem");
     meshView = new QQuickView();
     meshView->setSource(QUrl(QStringLiteral("qrc:/resources/ui/MeshView.qml")));
     meshView->rootContext()->setContextProperty("elements", elementModel);
@@ -298,6 +302,8 @@ RockOutcrop::RockOutcrop(QWidget *parent) :
     openseesProcess->setWorkingDirectory(analysisDir);
     //connect(openseesProcess, SIGNAL(readyReadStandardOutput()),this,SLOT(onOpenSeesFinished()));
     connect(openseesProcess, SIGNAL(readyReadStandardError()),this,SLOT(onOpenSeesFinished()));
+    // OpenSees writes no live feeds, Abort on the pages stops the process
+    connect(theTabManager, SIGNAL(liveAbortRequested()), openseesProcess, SLOT(kill()));
 
     if(!QDir(outputDir).exists())
         QDir().mkdir(outputDir);
@@ -350,6 +356,8 @@ void RockOutcrop::loadFromJson()
 
     QJsonArray soilLayers = inobj["soilProfile"].toObject()["soilLayers"].toArray();
     QJsonArray materials = inobj["materials"].toArray();
+    // the whole profile goes into the layer table in one transaction
+    ui->tableView->m_sqlModel->beginTransaction();
     for (int i=soilLayers.size()-1; i>=0; i--)
     {
         QJsonObject l = soilLayers[i].toObject();
@@ -383,6 +391,7 @@ void RockOutcrop::loadFromJson()
         theTabManager->updateLayerTab(l,mat);
 
     }
+    ui->tableView->m_sqlModel->endTransaction(true);
 
 
 
@@ -430,6 +439,8 @@ bool RockOutcrop::inputFromJSON(QJsonObject& inobj) {
 
     QJsonArray soilLayers = inobj["soilProfile"].toObject()["soilLayers"].toArray();
     QJsonArray materials = inobj["materials"].toArray();
+    // the whole profile goes into the layer table in one transaction
+    ui->tableView->m_sqlModel->beginTransaction();
     for (int i=soilLayers.size()-1; i>=0; i--)
     {
         QJsonObject l = soilLayers[i].toObject();
@@ -463,6 +474,7 @@ bool RockOutcrop::inputFromJSON(QJsonObject& inobj) {
         theTabManager->updateLayerTab(l,mat);
 
     }
+    ui->tableView->m_sqlModel->endTransaction(true);
 
 
 
@@ -936,8 +948,15 @@ void RockOutcrop::on_reBtn_clicked()
 
     if (!file_name.isNull())
     {
-        std::ofstream o(file_name.toStdString());
-        o << std::setw(4) << root << std::endl;
+        // an unchanged profile is not written again, and the mesh below is kept
+        std::ostringstream text;
+        text << std::setw(4) << root << std::endl;
+        if (text.str() != lastSRTText || !QFile::exists(file_name))
+        {
+            std::ofstream o(file_name.toStdString());
+            o << text.str();
+            lastSRTText = text.str();
+        }
     } else {
         QMessageBox::information(this, "error", "Failed to get file name.");
     }
@@ -945,6 +964,8 @@ void RockOutcrop::on_reBtn_clicked()
 
 
     mesher->mesh2DColumn();
+    if (!mesher->changed())
+        return;
     elementModel->clear();
     elementModel->setTotalHeight(ui->totalHeight->text().toDouble());
     elementModel->setNodes(mesher->nodes);
@@ -986,19 +1007,36 @@ void RockOutcrop::on_runBtn_clicked()
         }else{
             // build tcl file
             ui->reBtn->click();
-            SiteResponse *srt = new SiteResponse(srtFileName.toStdString(),
-                                                 analysisDir.toStdString(),outputDir.toStdString());
+            if (srt == nullptr)
+                srt = new SiteResponse(srtFileName.toStdString(),
+                                       analysisDir.toStdString(),outputDir.toStdString());
             //QMessageBox::information(this,tr("Alert"), "Are you sure you have soil layers. If not, I'll quit.", tr("OK."));
             srt->buildTcl();
 
             if(!QDir(outputDir).exists())
                 QDir().mkdir(outputDir);
 
+            // an identical run before left its results in the cache
+            resultKey = srt->resultKey(SRT_ENGINE_VERSION " OpenSees " + openseespath.toStdString());
+            ResultCache cache(QDir(analysisDir).filePath("cache").toStdString());
+            if (resultKey != 0 && cache.fetch(resultKey, std::vector<std::string>(1, outputDir.toStdString())))
+            {
+                resultKey = 0;
+                QMessageBox::information(this,tr("OpenSees Information"), "Analysis is done (the results of an identical run were reused).", tr("OK."));
+                showResults();
+                return;
+            }
+
             /*
             * Calling Opensee to do the work
             */
             //"/Users/simcenter/Codes/OpenSees/bin/opensees"
             //openseesProcess->start("/Users/simcenter/Codes/OpenSees/bin/opensees",QStringList()<<"/Users/simcenter/Codes/SimCenter/SiteResponseTool/bin/model.tcl");
+            // OpenSees writes no profiles, the ones of an earlier run would be
+            // read instead of its outputs and kept with them in the cache
+            foreach (QString name, QDir(outputDir).entryList(QStringList() << "*.prof", QDir::Files))
+                QFile::remove(QDir(outputDir).filePath(name));
+            theTabManager->startLiveResults(outputDir);
             openseesProcess->start(openseespath,QStringList()<<tclName);
             openseesErrCount = 1;
             emit runBtnClicked(dinoView);
@@ -1020,22 +1058,43 @@ void RockOutcrop::onOpenSeesFinished()
             QMessageBox::information(this,tr("OpenSees Information"), "Analysis is done.", tr("OK."));
             qDebug() << "opensees says:" << str_err;
             openseesErrCount = 2;
-            theTabManager->getTab()->setCurrentIndex(2);
-            theTabManager->setGMViewLoaded();
-            theTabManager->reFreshGMTab();
-            theTabManager->reFreshGMView();
+            theTabManager->stopLiveResults();
+
+            // keep the results for an identical run, the live feeds are not part of them
+            if (resultKey != 0)
+            {
+                std::vector<ResultCache::File> files;
+                foreach (QString name, QDir(outputDir).entryList(QDir::Files))
+                    if (!name.endsWith(".live"))
+                        files.push_back({0, name.toStdString()});
+                ResultCache cache(QDir(analysisDir).filePath("cache").toStdString());
+                cache.store(resultKey, std::vector<std::string>(1, outputDir.toStdString()), files);
+                resultKey = 0;
+            }
+
+            showResults();
+        }
+    }
+
+}
 
-            resultsTab->setCurrentIndex(1);
+void RockOutcrop::showResults()
+{
+    theTabManager->getTab()->setCurrentIndex(2);
+    theTabManager->setGMViewLoaded();
+    theTabManager->reFreshGMTab();
+    theTabManager->reFreshGMView();
 
-            postProcessor = new PostProcessor(outputDir);
-            profiler->updatePostProcessor(postProcessor);
-            theTabManager->updatePostProcessor(postProcessor);
-            connect(postProcessor, SIGNAL(updateFinished()), profiler, SLOT(onPostProcessorUpdated()));
-            postProcessor->update();
+    resultsTab->setCurrentIndex(1);
 
-        }
-    }
+    postProcessor = new PostProcessor(outputDir);
+    profiler->updatePostProcessor(postProcessor);
+    theTabManager->updatePostProcessor(postProcessor);
+    connect(postProcessor, SIGNAL(profileUpdated(QString)), profiler, SLOT(onProfileUpdated(QString)));
+    postProcessor->update();
 
+    // the mesh can now be coloured by the results
+    meshView->rootObject()->setProperty("outputDir", outputDir);
 }
 
 
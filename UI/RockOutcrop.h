@@ -18,6 +18,8 @@ namespace Ui {
 class RockOutcrop;
 }
 
+class SiteResponse;
+
 
 class RockOutcrop : public SimCenterAppWidget
 {
@@ -93,17 +95,23 @@ signals:
 private:
     Ui::RockOutcrop *ui;
 
+    // shows the results of the run in the output directory
+    void showResults();
+
     int layerViewWidth = 200;
     int meshViewWidth = 200;
     int layerTableWidth = 630;
     int layerTableHeight = 500;//320;
     int openseesErrCount = 0;
+    unsigned long long resultKey = 0;// of the run in progress in the result cache
 
 private:// some of them were public
     QWidget *plotContainer;
     QWidget *matContainer;
     QWebEngineView *dinoView;
     Mesher* mesher;
+    SiteResponse* srt = nullptr;// kept between runs with the rock motion it has read
+    std::string lastSRTText;// what was last written to SRT.json
     QQuickView *meshView;
     //QQuickView *pgaView;
     ElementModel* elementModel;
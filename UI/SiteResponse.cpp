@@ -8,6 +8,10 @@
 
 
 
+#include <QDateTime>
+#include <QFileInfo>
+
+#include "ResultCache.h"
 #include "StandardStream.h"
 #include "FileStream.h"
 #include "OPS_Stream.h"
@@ -20,6 +24,21 @@ OPS_Stream *opserrPtr = &ferr;
 OPS_Stream *opsoutPtr = &sserr;
 
 
+// the sizes and modification times of the files of a motion, which change
+// whenever the motion is written again
+static std::string motionStamp(const std::string &motionName)
+{
+    std::ostringstream stamp;
+    const char *extensions[] = {".time", ".acc", ".vel", ".disp"};
+    for (const char *extension : extensions)
+    {
+        QFileInfo info(QString::fromStdString(motionName + extension));
+        stamp << info.exists() << " " << info.size() << " " << info.lastModified().toMSecsSinceEpoch() << ";";
+    }
+    return stamp.str();
+}
+
+
 SiteResponse::SiteResponse(std::string configureFile,std::string anaDir,std::string outDir) :
     m_configureFile(configureFile),
     m_analysisDir(anaDir),
@@ -59,6 +78,7 @@ SiteResponse::SiteResponse(std::string configureFile,std::string anaDir,std::str
         //std::string motionXFN("/Users/simcenter/Codes/SimCenter/SiteResponseTool/test/RSN766_G02_000_VEL");
         std::string motionXFN(anaDir+"/Rock");//TODO: may not work on windows
         motionX.setMotion(motionXFN.c_str());
+        m_motionStamp = motionStamp(motionXFN);
         bbpOName = "out";
         model = new SiteResponseModel("2D", &motionX);
         model->setOutputDir(bbpOName);
@@ -76,10 +96,34 @@ SiteResponse::SiteResponse(std::string configureFile,std::string anaDir,std::str
 
 void SiteResponse::buildTcl()
 {
+    // the object is kept between runs, the rock motion is read again only
+    // if its files have been written since
+    std::string motionXFN(m_analysisDir+"/Rock");//TODO: may not work on windows
+    std::string stamp = motionStamp(motionXFN);
+    if (stamp != m_motionStamp)
+    {
+        motionX.setMotion(motionXFN.c_str());
+        m_motionStamp = stamp;
+    }
     bool runAnalysis = false;
     model->buildEffectiveStressModel2D(runAnalysis);
 }
 
+unsigned long long SiteResponse::resultKey(const std::string &engine)
+{
+    std::ifstream in(m_configureFile);
+    json config;
+    try
+    {
+        in >> config;
+    }
+    catch (std::exception &e)
+    {
+        return 0;
+    }
+    return ResultCache::makeKey(config, &motionX, engine);
+}
+
 void SiteResponse::run()
 {
     bool runAnalysis = true;
@@ -16,6 +16,9 @@ public:
 
     void run();
     void buildTcl();
+    // the key of the results of this configuration and motion in a
+    // ResultCache, for the given engine
+    unsigned long long resultKey(const std::string &engine);
 
 	
 private:
@@ -26,6 +29,8 @@ private:
     std::string m_configureFile;
     std::string m_analysisDir;
     std::string m_outputDir;
+    // the files of the rock motion when motionX was read, see buildTcl()
+    std::string m_motionStamp;
 
 
 
@@ -22,6 +22,11 @@ TabManager::TabManager(BonzaTableView *tableViewIn, ElementModel *emodel,QWidget
 
     tableModel = tableView->m_sqlModel;
 
+    responseData = new ResponseDataService(elementModel, this);
+    responseData->setAnalysisDir(analysisDir);
+    liveResults = new LiveResultsMonitor(elementModel, this);
+    connect(liveResults, SIGNAL(feedOpened()), this, SLOT(showLiveResults()));
+    connect(liveResults, SIGNAL(abortRequested()), this, SIGNAL(liveAbortRequested()));
 
     if(!QDir(analysisDir).exists())
         QDir().mkdir(analysisDir);
@@ -118,6 +123,8 @@ void TabManager::init(QTabWidget* theTab){
     QWebChannel *pWebChannel   = new QWebChannel(GMView->page());
     //TInteractObj *pInteractObj = new TInteractObj(this);
     pWebChannel->registerObject(QStringLiteral("elementModel"), elementModel);
+    pWebChannel->registerObject(QStringLiteral("responseData"), responseData);
+    pWebChannel->registerObject(QStringLiteral("liveResults"), liveResults);
     GMView->page()->setWebChannel(pWebChannel);
     GMView->page()->load(QUrl::fromLocalFile(QFileInfo(GMTabHtmlName_true).absoluteFilePath()));
     //GMView->show();
@@ -449,655 +456,52 @@ void TabManager::onFEMTabEdited()
 
 void TabManager::reFreshGMTab()
 {
+    // the pages ask responseData for the data once they are loaded
+    responseData->setRockMotionFile(FEMWidget->findChild<QLineEdit*>("GMPath")->text());
+    responseData->clear();
 
-    // get file paths
-    QFileInfo indexHtmlInfo(GMTabHtmlName);
-    //QString dir = indexHtmlInfo.path();
-    //QString tmpPath = QDir(dir).filePath("index-template.html");
-    //QString newPath = QDir(dir).filePath("index.html");
-    QString tmpPath = QDir(rootDir).filePath("resources/ui/GroundMotion/index-template.html");
-    QString newPath = QDir(rootDir).filePath("resources/ui/GroundMotion/index.html");
-    QFile::remove(newPath);
-    //QFile::copy(tmpPath, newPath);
-
-    // read template file into string
-    QFile file(tmpPath);
-    file.open(QIODevice::ReadOnly | QIODevice::Text);
-    QByteArray t = file.readAll();
-    QString text = QString(t);
-    file.close();
-
-
-    QString insertedString = loadGMtoString();
-    text.replace(QString("//UPDATEPOINT"), insertedString);
-
-    // write to index.html
-    QFile newfile(newPath);
-    newfile.open(QIODevice::WriteOnly | QIODevice::Text);
-    newfile.write(text.toUtf8());
-    newfile.close();
+    writeSurfaceMotion();
 
-    updateAccHtml();
-    updateDispHtml();
-    updatePWPHtml();
-    updateStrainHtml();
-    updateStressHtml();
+    writeHtmlFromTemplate("index");
+    writeHtmlFromTemplate("acc");
+    writeHtmlFromTemplate("disp");
+    writeHtmlFromTemplate("pwp");
+    writeHtmlFromTemplate("strain");
+    writeHtmlFromTemplate("stress");
 
     GMView->reload();
     //GMView->show();
 
 }
 
-void TabManager::updateAccHtml()
+void TabManager::writeHtmlFromTemplate(const QString &name)
 {
     // get file paths
-    QFileInfo htmlInfo(accHtmlName);
-    //QString dir = htmlInfo.path();
-    QString tmpPath = QDir(rootDir).filePath("resources/ui/GroundMotion/acc-template.html");
-    QString newPath = QDir(rootDir).filePath("resources/ui/GroundMotion/acc.html");
+    QString tmpPath = QDir(rootDir).filePath("resources/ui/GroundMotion/"+name+"-template.html");
+    QString newPath = QDir(rootDir).filePath("resources/ui/GroundMotion/"+name+".html");
     QFile::remove(newPath);
-
-    // read template file into string
-    QFile file(tmpPath);
-    file.open(QIODevice::ReadOnly | QIODevice::Text);
-    QByteArray t = file.readAll();
-    QString text = QString(t);
-    file.close();
-
-
-
-    QString insertedString = loadMotions2String("acc");
-    text.replace(QString("//UPDATEPOINT"), insertedString);
-
-
-    // write to index.html
-    QFile newfile(newPath);
-    newfile.open(QIODevice::WriteOnly | QIODevice::Text);
-    newfile.write(text.toUtf8());
-    newfile.close();
+    QFile::copy(tmpPath, newPath);
 }
 
-void TabManager::updateDispHtml()
+void TabManager::startLiveResults(const QString &outputDir)
 {
-    // get file paths
-    QFileInfo htmlInfo(dispHtmlName);
-    //QString dir = htmlInfo.path();
-    QString tmpPath = QDir(rootDir).filePath("resources/ui/GroundMotion/disp-template.html");
-    QString newPath = QDir(rootDir).filePath("resources/ui/GroundMotion/disp.html");
-    QFile::remove(newPath);
-
-    // read template file into string
-    QFile file(tmpPath);
-    file.open(QIODevice::ReadOnly | QIODevice::Text);
-    QByteArray t = file.readAll();
-    QString text = QString(t);
-    file.close();
-
-
-    QString insertedString = loadMotions2String("disp");
-    text.replace(QString("//UPDATEPOINT"), insertedString);
-
-
-    // write to index.html
-    QFile newfile(newPath);
-    newfile.open(QIODevice::WriteOnly | QIODevice::Text);
-    newfile.write(text.toUtf8());
-    newfile.close();
+    // the pages follow the run through liveResults, they are shown once
+    // the run turns out to write the feeds
+    liveResults->start(outputDir);
 }
 
-void TabManager::updateStrainHtml()
+void TabManager::showLiveResults()
 {
-    // get file paths
-    QFileInfo htmlInfo(strainHtmlName);
-    //QString dir = htmlInfo.path();
-    QString tmpPath = QDir(rootDir).filePath("resources/ui/GroundMotion/strain-template.html");
-    QString newPath = QDir(rootDir).filePath("resources/ui/GroundMotion/strain.html");
-    QFile::remove(newPath);
-
-    // read template file into string
-    QFile file(tmpPath);
-    file.open(QIODevice::ReadOnly | QIODevice::Text);
-    QByteArray t = file.readAll();
-    QString text = QString(t);
-    file.close();
-
-
-    QString insertedString = loadEleResponse("strain");
-    text.replace(QString("//UPDATEPOINT"), insertedString);
-
-
-    // write to index.html
-    QFile newfile(newPath);
-    newfile.open(QIODevice::WriteOnly | QIODevice::Text);
-    newfile.write(text.toUtf8());
-    newfile.close();
-}
-
-
-void TabManager::updateStressHtml()
-{
-    // get file paths
-    QFileInfo htmlInfo(strainHtmlName);
-    //QString dir = htmlInfo.path();
-    QString tmpPath = QDir(rootDir).filePath("resources/ui/GroundMotion/stress-template.html");
-    QString newPath = QDir(rootDir).filePath("resources/ui/GroundMotion/stress.html");
-    QFile::remove(newPath);
-
-    // read template file into string
-    QFile file(tmpPath);
-    file.open(QIODevice::ReadOnly | QIODevice::Text);
-    QByteArray t = file.readAll();
-    QString text = QString(t);
-    file.close();
-
-
-    QString insertedString = loadEleResponse("stress");
-    text.replace(QString("//UPDATEPOINT"), insertedString);
-
-
-    // write to index.html
-    QFile newfile(newPath);
-    newfile.open(QIODevice::WriteOnly | QIODevice::Text);
-    newfile.write(text.toUtf8());
-    newfile.close();
-}
-
-void TabManager::updatePWPHtml()
-{
-    // get file paths
-    QFileInfo htmlInfo(pwpHtmlName);
-    //QString dir = htmlInfo.path();
-    QString tmpPath = QDir(rootDir).filePath("resources/ui/GroundMotion/pwp-template.html");
-    QString newPath = QDir(rootDir).filePath("resources/ui/GroundMotion/pwp.html");
-    QFile::remove(newPath);
-
-    // read template file into string
-    QFile file(tmpPath);
-    file.open(QIODevice::ReadOnly | QIODevice::Text);
-    QByteArray t = file.readAll();
-    QString text = QString(t);
-    file.close();
-
-
-    QString insertedString = loadPWPResponse();
-    text.replace(QString("//UPDATEPOINT"), insertedString);
-
-
-    // write to index.html
-    QFile newfile(newPath);
-    newfile.open(QIODevice::WriteOnly | QIODevice::Text);
-    newfile.write(text.toUtf8());
-    newfile.close();
-}
-
-
-
-
-QString TabManager::loadGMtoString()
-{
-
-    QString text;
-    QTextStream stream(&text);
-
-
-
-    /*
-     * Get rock motion from file
-     */
-    QString newGmPathStr = FEMWidget->findChild<QLineEdit*>("GMPath")->text();
-    QFile file(newGmPathStr);
-    QStringList xd, yd;
-    if(file.open(QIODevice::ReadOnly)) {
-        QTextStream in(&file);
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
-            if (thisLine.size()<2)
-                break;
-            xd.append(thisLine[0].trimmed());
-            yd.append(thisLine[1].trimmed());
-        }
-        file.close();
-    }
-
-    stream << "xnew = ['x'";
-    for (int i=0; i<xd.size(); i++)
-        stream << ", "<<xd.at(i);
-    stream <<"];" <<endl;
-
-    stream << "ynew = ['Rock motion'";
-    for (int i=0; i<yd.size(); i++)
-        stream << ", "<<yd.at(i);
-    stream <<"];" <<endl;
-
-    /*
-     * Get surface motion from file
-     */
-    //QString surfaceVelFileName = "/Users/simcenter/Codes/SimCenter/SiteResponseTool/bin/out_tcl/vel_surface.txt";
-    QString surfaceVelFileName = analysisDir+"/out_tcl/surface.vel";
-    QFile surfaceVelFile(surfaceVelFileName);
-    QStringList xdSurfaceVel, ydSurfaceVel;
-    if(surfaceVelFile.open(QIODevice::ReadOnly)) {
-        QTextStream in(&surfaceVelFile);
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
-            if (thisLine.size()<2)
-                break;
-            else
-            {
-                thisLine.removeAll("");
-                xdSurfaceVel.append(thisLine[0].trimmed());
-                ydSurfaceVel.append(thisLine[1].trimmed());
-
-            }
-
-        }
-        surfaceVelFile.close();
-    }
-
-    stream << "xSurfaceVel = ['x'";
-    for (int i=0; i<xdSurfaceVel.size(); i++)
-        stream << ", "<<xdSurfaceVel.at(i);
-    stream <<"];" <<endl;
-
-    stream << "ySurfaceVel = ['Surface motion'";
-    for (int i=0; i<ydSurfaceVel.size(); i++)
-        stream << ", "<<ydSurfaceVel.at(i).toDouble();
-    stream <<"];" <<endl;
-
-    QString nodeResponseStr = loadNodeResponse("vel");
-    stream << nodeResponseStr;
-
-    writeSurfaceMotion();
-
-
-
-
-    //stream << "       xnew = ['x', 1, 2, 3, 4, 5, 6];" <<endl;
-    //stream << "       ynew = ['Ground motion', 70, 180, 190, 180, 80, 250];"<<endl;
-    //stream << "       chart.unload();"<<endl;
-    stream << "       setTimeout(function () {"<<endl;
-    stream << "       chart.load({"<<endl;
-    stream << "           columns: ["<<endl;
-    stream << "           xnew,"<<endl;
-    stream <<"           ynew"<<endl;
-    stream <<"           ]"<<endl;
-    stream <<"       });"<<endl;
-
-    stream << "       chart.load({"<<endl;
-    stream << "           columns: ["<<endl;
-    stream << "           xSurfaceVel,"<<endl;
-    stream <<"           ySurfaceVel"<<endl;
-    stream <<"           ]"<<endl;
-    stream <<"       });"<<endl;
-
-    stream <<"       chart.unload({"<<endl;
-    stream <<"           ids: 'Demo motion 1'"<<endl;
-    stream <<"       });"<<endl;
-    stream <<"       chart.unload({"<<endl;
-    stream <<"           ids: 'Demo motion 2'"<<endl;
-    stream <<"       });"<<endl;
-    stream <<"       }, 1000);"<<endl;
-    return text;
-
-}
-
-QString TabManager::loadMotions2String(QString motion)
-{
-
-    QString text;
-    QTextStream stream(&text);
-
-    QString vaseVelFileName = analysisDir+"/out_tcl/base."+motion;
-    QFile baseVelFile(vaseVelFileName);
-    QStringList xdBaseVel, ydBaseVel;
-    if(baseVelFile.open(QIODevice::ReadOnly)) {
-        QTextStream in(&baseVelFile);
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
-            if (thisLine.size()<2)
-                break;
-            else
-            {
-                thisLine.removeAll("");
-                xdBaseVel.append(thisLine[0].trimmed());
-                ydBaseVel.append(thisLine[1].trimmed());
-
-            }
-
-        }
-        baseVelFile.close();
-    }
-
-    stream << "xnew = ['x'";
-    for (int i=0; i<xdBaseVel.size(); i++)
-        stream << ", "<<xdBaseVel.at(i);
-    stream <<"];" <<endl;
-
-    stream << "ynew = ['Rock motion'";
-    for (int i=0; i<ydBaseVel.size(); i++)
-        stream << ", "<<ydBaseVel.at(i);
-    stream <<"];" <<endl;
-
-
-
-    QString nodeResponseStr = loadNodeResponse(motion);
-    stream << nodeResponseStr;
-
-
-
-    /*
-     * Get surface motion from file
-     */
-    //QString surfaceVelFileName = "/Users/simcenter/Codes/SimCenter/SiteResponseTool/bin/out_tcl/vel_surface.txt";
-    QString surfaceVelFileName = analysisDir+"/out_tcl/surface."+motion;
-    QFile surfaceVelFile(surfaceVelFileName);
-    QStringList xdSurfaceVel, ydSurfaceVel;
-    if(surfaceVelFile.open(QIODevice::ReadOnly)) {
-        QTextStream in(&surfaceVelFile);
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
-            if (thisLine.size()<2)
-                break;
-            else
-            {
-                thisLine.removeAll("");
-                xdSurfaceVel.append(thisLine[0].trimmed());
-                ydSurfaceVel.append(thisLine[1].trimmed());
-
-            }
-
-        }
-        surfaceVelFile.close();
-    }
-
-    stream << "xSurfaceVel = ['x'";
-    for (int i=0; i<xdSurfaceVel.size(); i++)
-        stream << ", "<<xdSurfaceVel.at(i);
-    stream <<"];" <<endl;
-
-    stream << "ySurfaceVel = ['Surface motion'";
-    for (int i=0; i<ydSurfaceVel.size(); i++)
-        stream << ", "<<ydSurfaceVel.at(i).toDouble();
-    stream <<"];" <<endl;
-
-    writeSurfaceMotion();
-
-
-
-
-    //stream << "       xnew = ['x', 1, 2, 3, 4, 5, 6];" <<endl;
-    //stream << "       ynew = ['Ground motion', 70, 180, 190, 180, 80, 250];"<<endl;
-    stream << "       chart.unload();"<<endl;
-    stream << "       setTimeout(function () {"<<endl;
-    stream << "       chart.load({"<<endl;
-    stream << "           columns: ["<<endl;
-    stream << "           xnew,"<<endl;
-    stream <<"           ynew"<<endl;
-    stream <<"           ]"<<endl;
-    stream <<"       });"<<endl;
-
-    stream << "       chart.load({"<<endl;
-    stream << "           columns: ["<<endl;
-    stream << "           xSurfaceVel,"<<endl;
-    stream <<"           ySurfaceVel"<<endl;
-    stream <<"           ]"<<endl;
-    stream <<"       });"<<endl;
-
-    stream <<"       chart.unload({"<<endl;
-    stream <<"           ids: 'Demo motion 1'"<<endl;
-    stream <<"       });"<<endl;
-    stream <<"       chart.unload({"<<endl;
-    stream <<"           ids: 'Demo motion 2'"<<endl;
-    stream <<"       });"<<endl;
-    stream <<"       }, 500);"<<endl;
-    return text;
-
+    writeHtmlFromTemplate("index");
+    writeHtmlFromTemplate("acc");
+    writeHtmlFromTemplate("pwp");
+    GMView->reload();
 }
 
 void TabManager::updatePostProcessor(PostProcessor *postProcessort)
 {
     postProcessor = postProcessort;
-}
-
-QString TabManager::loadNodeResponse(QString motion)
-{
-    QString motionFileName;
-    if(motion=="acc")
-            motionFileName = postProcessor->getAccFileName();
-    else if (motion=="vel")
-        motionFileName = postProcessor->getVelFileName();
-    else if (motion=="disp")
-        motionFileName = postProcessor->getDispFileName();
-    else if (motion=="strain")
-        motionFileName = postProcessor->getStrainFileName();
-    else if (motion=="stress")
-        motionFileName = postProcessor->getStressFileName();
-    else
-        qWarning("motion must be acc, vel or disp!");
-
-    QFile File(motionFileName);
-
-    QVector<QVector<double>> v;
-    if(File.open(QIODevice::ReadOnly)) {
-        QTextStream in(&File);
-        int lineCount = 0;
-        int numCols = 0;
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
-            thisLine.removeAll("");
-            int sizeThisLine = thisLine.size();
-            lineCount += 1;
-            if (lineCount==1)
-                numCols = sizeThisLine;
-            if (sizeThisLine != numCols && lineCount>1)
-            {
-                lineCount -= 1;
-                break;
-            }
-            else
-            {
-                //thisLine.removeAll("");
-                for (int i=0; i<thisLine.size();i++)// TODO: 3D?
-                {
-                    if (lineCount==1)
-                    {
-                        QVector<double> tmpV;
-                        v.append(tmpV);
-                    }
-                    v[i].append((thisLine[i].trimmed().toDouble()));
-                }
-            }
-        }
-        File.close();
-    }
-
-    QString text;
-    QTextStream stream(&text);
-
-    if(v.size()>0)
-    {
-    stream << "time = ['x'";
-    for (int i=0; i<v[0].size(); i++)
-        stream << ", "<<v[0][i];
-    stream <<"];" <<endl;
-
-
-    int eleID = elementModel->getSize();
-    for (int j=7;j<v.size();j+=4)
-    {
-        eleID -= 1;
-        //stream << "n1 = ['Node 1'";
-        stream << "n"+QString::number(eleID)+" = ['Node "+QString::number(eleID)+"'";
-        //stream << "n"+QString::number(eleID)+" = ['Node marked by <'";
-        for (int i=0; i<v[j].size(); i++)
-            stream << ", "<<v[j][i];
-        stream <<"];" <<endl;
-    }
-    }
-
-
-    return text;
-
-
-
-}
-
-QString TabManager::loadPWPResponse()
-{
-
-    QFile File(postProcessor->getPWPFileName());
-
-    QVector<QVector<double>> v;
-    if(File.open(QIODevice::ReadOnly)) {
-        QTextStream in(&File);
-        int lineCount = 0;
-        int numCols = 0;
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
-            thisLine.removeAll("");
-            int sizeThisLine = thisLine.size();
-            lineCount += 1;
-            if (lineCount==1)
-                numCols = sizeThisLine;
-            if (sizeThisLine != numCols && lineCount>1)
-            {
-                lineCount -= 1;
-                break;
-            }
-            else
-            {
-                //thisLine.removeAll("");
-                for (int i=0; i<thisLine.size();i++)// TODO: 3D?
-                {
-                    if (lineCount==1)
-                    {
-                        QVector<double> tmpV;
-                        v.append(tmpV);
-                    }
-                    v[i].append((thisLine[i].trimmed().toDouble()));
-                }
-            }
-        }
-        File.close();
-    }
-
-    QString text;
-    QTextStream stream(&text);
-
-    if(v.size()>0)
-    {
-    stream << "time = ['x'";
-    for (int i=0; i<v[0].size(); i++)
-        stream << ", "<<v[0][i];
-    stream <<"];" <<endl;
-
-
-    int eleID = elementModel->getSize();
-    for (int j=4;j<v.size();j+=2)
-    {
-        eleID -= 1;
-        //stream << "n1 = ['Node 1'";
-        stream << "pwp"+QString::number(eleID)+" = ['Node "+QString::number(eleID)+"'";
-        //stream << "pwp"+QString::number(eleID)+" = ['Node marked by <'";
-        for (int i=0; i<v[j].size(); i++)
-            stream << ", "<<v[j][i];
-        stream <<"];" <<endl;
-    }
-    }
-
-
-    return text;
-
-
-
-}
-
-QString TabManager::loadEleResponse(QString motion)
-{
-
-    QString fileName;
-    if (motion=="strain")
-        fileName = postProcessor->getStrainFileName();
-    else if (motion=="stress")
-        fileName = postProcessor->getStressFileName();
-
-    QFile File(fileName);
-
-    QVector<QVector<double>> v;
-    if(File.open(QIODevice::ReadOnly)) {
-        QTextStream in(&File);
-        int lineCount = 0;
-        int numCols = 0;
-        while(!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList thisLine = line.split(" ");
-            thisLine.removeAll("");
-            int sizeThisLine = thisLine.size();
-            lineCount += 1;
-            if (lineCount==1)
-                numCols = sizeThisLine;
-            if (sizeThisLine != numCols && lineCount>1)
-            {
-                lineCount -= 1;
-                break;
-            }
-            else
-            {
-                //thisLine.removeAll("");
-                for (int i=0; i<thisLine.size();i++)// TODO: 3D?
-                {
-                    if (lineCount==1)
-                    {
-                        QVector<double> tmpV;
-                        v.append(tmpV);
-                    }
-                    v[i].append((thisLine[i].trimmed().toDouble()));
-                }
-            }
-        }
-        File.close();
-    }
-
-    QString text;
-    QTextStream stream(&text);
-
-    if(v.size()>0)
-    {
-    stream << "time = ['x'";
-    for (int i=0; i<v[0].size(); i++)
-        stream << ", "<<v[0][i];
-    stream <<"];" <<endl;
-
-    QString outTitle;
-    if(motion=="strain")
-        outTitle = "Strain";
-    else if(motion=="stress")
-        outTitle="Stress";
-
-    int eleID = elementModel->getSize();
-    for (int j=3;j<v.size();j+=3)
-    {
-        eleID -= 1;
-        //stream << "n1 = ['Node 1'";
-        stream << outTitle+QString::number(eleID)+" = ['Element "+QString::number(eleID)+"'";
-        //stream << "pwp"+QString::number(eleID)+" = ['Node marked by <'";
-        for (int i=0; i<v[j].size(); i++)
-            stream << ", "<<v[j][i];
-        stream <<"];" <<endl;
-    }
-    }
-
-
-    return text;
-
-
-
+    responseData->setPostProcessor(postProcessor);
 }
 
 bool TabManager::writeSurfaceMotion()
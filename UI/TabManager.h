@@ -18,6 +18,8 @@
 #include <QWebChannel>
 #include "ElementModel.h"
 #include "PostProcessor.h"
+#include "ResponseDataService.h"
+#include "LiveResultsMonitor.h"
 
 
 
@@ -38,27 +40,22 @@ public:
     void reFreshGMTab();
     void writeGM();
     bool writeSurfaceMotion();
-    QString loadGMtoString();
-    QString loadMotions2String(QString);
-    QString loadPWPResponse();
-    QString loadEleResponse(QString);
-    QString loadNodeResponse(QString);
     QTabWidget* getTab(){return tab;}
     void hideConfigure();
     QString openseespath(){return openseesPathStr;}
     QString rockmotionpath(){return GMPathStr;}
-    void updateDispHtml();
-    void updateAccHtml();
-    void updatePWPHtml();
-    void updateStrainHtml();
-    void updateStressHtml();
+    void writeHtmlFromTemplate(const QString &name);
     void reFreshGMView(){GMView->show();}
     void setPM4SandToolTps();
     void updatePostProcessor(PostProcessor *postProcessort);
     void setGMViewLoaded(){GMViewLoaded = true;}
+    void startLiveResults(const QString &outputDir);
+    void stopLiveResults(){liveResults->stop();}
 
 signals:
     void configTabUpdated();
+    // Abort was pressed on a page while a run that writes no feeds is on
+    void liveAbortRequested();
 
 
 public:
@@ -83,6 +80,7 @@ public slots:
     void updateOpenSeesPath(QString);
     void updateLayerTab(QJsonObject,QJsonObject);
     void onConfigTabEdtFinished();
+    void showLiveResults();
 
 
 private:
@@ -94,6 +92,8 @@ private:
     BonzaTableModel *tableModel;
     ElementModel* elementModel;
     PostProcessor *postProcessor;
+    ResponseDataService *responseData;
+    LiveResultsMonitor *liveResults;
 
     QFile uiFilePM4Sand;
     QFile uiFileElasticIsotropic;
@@ -0,0 +1,103 @@
+// Helpers for the plots that get their data from the responseData object
+// published on the web channel (UI/ResponseDataService).
+
+// number of points to ask for: two per pixel of the chart
+function plotPoints() {
+    return Math.max(200, 2 * document.getElementById('chart').clientWidth);
+}
+
+function decodeSeries(base64) {
+    var bytes = atob(base64);
+    var buffer = new ArrayBuffer(bytes.length);
+    var view = new Uint8Array(buffer);
+    for (var i = 0; i < bytes.length; i++)
+        view[i] = bytes.charCodeAt(i);
+    return new Float64Array(buffer);
+}
+
+// replaces what the chart shows by the given series, each on its own x
+function loadSeries(chart, seriesList) {
+    var xs = {};
+    var columns = [];
+    seriesList.forEach(function (series) {
+        if (!series || !series.count)
+            return;
+        var xName = 'x ' + series.name;
+        xs[series.name] = xName;
+        columns.push([xName].concat(Array.prototype.slice.call(decodeSeries(series.x))));
+        columns.push([series.name].concat(Array.prototype.slice.call(decodeSeries(series.y))));
+    });
+    chart.load({ xs: xs, columns: columns, unload: true });
+}
+
+// loads the named motions, then the response of an element if type is given
+function showSeries(chart, motions, type, elementID) {
+    var points = plotPoints();
+    var seriesList = [];
+    var next = function (i) {
+        if (i < motions.length) {
+            responseData.getMotion(motions[i], 0, -1, points, function (series) {
+                seriesList.push(series);
+                next(i + 1);
+            });
+        } else if (type) {
+            responseData.getResponse(type, elementID, 0, -1, points, function (series) {
+                seriesList.push(series);
+                loadSeries(chart, seriesList);
+            });
+        } else {
+            loadSeries(chart, seriesList);
+        }
+    };
+    next(0);
+}
+
+// while an analysis runs, shows its progress with an abort button above the
+// chart and, if fetch is given, plots what fetch(points, callback) returns
+// from the liveResults object (UI/LiveResultsMonitor) each time it updates
+function followLiveResults(chart, fetch) {
+    if (typeof liveResults === 'undefined' || !liveResults)
+        return;
+
+    var panel = document.createElement('div');
+    panel.style.display = 'none';
+    var text = document.createElement('span');
+    var button = document.createElement('input');
+    button.type = 'button';
+    button.className = 'btn';
+    button.value = 'Abort';
+    button.onclick = function () {
+        button.disabled = true;
+        liveResults.abort();
+    };
+    panel.appendChild(text);
+    panel.appendChild(document.createTextNode(' '));
+    panel.appendChild(button);
+    var chartDiv = document.getElementById('chart');
+    chartDiv.parentNode.insertBefore(panel, chartDiv);
+
+    var statusText = ['Running', 'Finished', 'Failed', 'Aborted'];
+    // a page loaded after the run shows the recorded results instead
+    var following = false;
+    var update = function () {
+        following = following || liveResults.running;
+        if (!following) {
+            panel.style.display = 'none';
+            return;
+        }
+        panel.style.display = 'block';
+        button.style.display = liveResults.running ? 'inline' : 'none';
+        if (liveResults.status < 0)
+            text.textContent = liveResults.running ? 'Waiting for the analysis ...' : '';
+        else
+            text.textContent = statusText[liveResults.status] + ': t = ' + liveResults.time.toFixed(2)
+                + ' s (' + Math.round(100 * liveResults.progress) + '%)';
+        if (fetch && liveResults.status >= 0)
+            fetch(plotPoints(), function (series) {
+                if (series && series.count)
+                    loadSeries(chart, [series]);
+            });
+    };
+    liveResults.updated.connect(update);
+    update();
+}
@@ -1,7 +1,6 @@
 import QtQuick 2.0
-import QtQml.Models 2.2
-
 import QtQuick.Shapes 1.0
+import SiteResponseTool 1.0
 
 Rectangle {
     anchors.centerIn: parent
@@ -10,102 +9,88 @@ Rectangle {
     height: parent.height //500//320
     color: "#ffffff" //"#e2e2e2"
 
-    //border.color: "black"
-    //border.width: 1
-    //radius: 1
     property real eleWidth: elements.getWidth()
     property real totalHeight: elements.getTotalHeight()
     property real parentHeight: height //500//320
+    // where the results are, set once an analysis is done
+    property alias outputDir: mesh.outputDir
+
+    // all the elements are drawn by one scene graph item, coloured by layer
+    // or by the strain or ru of the element at a frame of the analysis
+    MeshItem {
+        id: mesh
+        x: (container.width * 0.5) / 2
+        y: 0.15 * 0.8 * container.height
+        width: container.width * 0.5
+        height: container.height * 0.8
+        model: elements
+
+        MouseArea {
+            anchors.fill: parent
+            onClicked: {
+                var row = mesh.elementAt(mouse.x, mouse.y)
+                if (row >= 0)
+                    elements.setActive(row)
+            }
+        }
+    }
 
-    Rectangle {
-
-        property real totalSoilHeight: elements.getTotalHeight()
-        property real startYLoc: 0.15 * 0.8 * container.height
-        property real soilWidth: elements.getWidth(
-                                     ) * 0.8 * container.height / elements.getTotalHeight(
-                                     ) // eleWidth*hFactor //width*0.3
-        //property real startXLoc: (container.width-elements.getWidth()*0.8* container.height / elements.getTotalHeight())/2 //(1-0.3)*width/2
-        property real startXLoc: (container.width * 0.5) / 2 //(1-0.3)*width/2
-
-        id: innerRect
-        x: startXLoc
-        y: startYLoc
-        width: parent.width
-        height: parent.height * 0.8
-
-        //color: "#000000"//"#e2e2e2"
-        ListView {
-            width: elements.getWidth(
-                       ) * 0.8 * container.height / elements.getTotalHeight()
-            height: container.height * 0.8
-
-            model: elements
-            delegate: Rectangle {
-
-                property real hFactor: 0.8 * container.height / elements.getTotalHeight()
-                //property real soilWidth: elements.getWidth()*0.8* container.height / elements.getTotalHeight()
-                property real soilWidth: (container.width * 0.5)
-
-                height: h * hFactor
-                width: soilWidth
-                color: mcolor
-                border.color: active ? "red" : "black"
-                border.width: active ? 2 : 0.5
-                property bool active2: active
-
-                Rectangle {
-                    x: soilWidth + 10
-                    y: -5
-                    width: 10
-                    height: 10
-                    color: white
-                    radius: 10 / 2
-                }
-
-
-
-                property real startXGWT: (width - soilWidth) / 2
-                property real startYGWT: 0.0//(theGWT + 0.15 * elements.getTotalHeight(
-                Shape {
-
-                    // water table
-                    ShapePath {
-                        strokeWidth: 2
-                        strokeColor: active ? "blue" : "white"
-                        strokeStyle: ShapePath.SolidLine
-                        dashPattern: [1, 2]
-
-                        startX: soilWidth+1 + 5
-                        startY: -5
-                        PathLine {
-                            x: soilWidth+1
-                            y: 0
-                        }
-                        PathLine {
-                            x: soilWidth+1 +5
-                            y: 5
-                        }
-
-
-                    }
-                }
-
+    // water table
+    Shape {
+        x: mesh.x + mesh.width + 1
+        y: mesh.y + mesh.height * (elements.activeID >= 0 ? elements.getCurrentHeight() : 0)
+           / Math.max(elements.getTotalHeight(), 1e-6)
+        ShapePath {
+            strokeWidth: 2
+            strokeColor: "blue"
+            strokeStyle: ShapePath.SolidLine
+
+            startX: 5
+            startY: -5
+            PathLine { x: 0; y: 0 }
+            PathLine { x: 5; y: 5 }
+        }
+    }
 
+    Timer {
+        id: player
+        interval: 40
+        repeat: true
+        onTriggered: mesh.frame = (mesh.frame + 1) % mesh.numFrames
+    }
 
-                //Text { text: tag + " " + h + " " + totalHeight + " " + hFactor }
+    Row {
+        id: fieldControls
+        anchors.horizontalCenter: parent.horizontalCenter
+        y: mesh.y + mesh.height + 6
+        spacing: 6
+        visible: mesh.outputDir !== ""
+
+        Repeater {
+            model: [["Layers", ""], ["Strain", "strain"], ["ru", "ru"]]
+            delegate: Text {
+                text: modelData[0]
+                font.bold: mesh.field === modelData[1]
                 MouseArea {
                     anchors.fill: parent
                     onClicked: {
-                        elements.setActive(index)
-                        //soilModel.setActive(index) ;
-                        //parent.border.color = "red"
-                        console.log(elements.getTotalHeight())
+                        player.stop()
+                        mesh.field = modelData[1]
                     }
-                    enabled: true
                 }
             }
         }
-
-
+        Text {
+            visible: mesh.numFrames > 1
+            text: player.running ? "Pause" : "Play"
+            MouseArea {
+                anchors.fill: parent
+                onClicked: player.running ? player.stop() : player.start()
+            }
+        }
+        Text {
+            visible: mesh.numFrames > 0
+            text: "t = " + mesh.time.toFixed(2) + " s"
+        }
     }
 }
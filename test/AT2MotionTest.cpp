@@ -0,0 +1,142 @@
+// Runs an analysis end to end with a PEER NGA AT2 record, which gives the
+// acceleration only; the motion has to come with the velocity the dashpot at
+// the base of the model is loaded with. An acceleration given as .time/.acc
+// files is checked the same way.
+//
+//   at2motiontest [work directory]
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "EffectiveFEModel.h"
+#include "outcropMotion.h"
+
+#include "StandardStream.h"
+#include "OPS_Stream.h"
+#include "OPS_Globals.h"
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+OPS_Stream *opsoutPtr = &sserr;
+
+static int numFailed = 0;
+
+static void check(bool passed, const char* what)
+{
+	if (!passed)
+	{
+		fprintf(stderr, "FAILED: %s\n", what);
+		numFailed++;
+	}
+}
+
+// a half sine pulse of peak, in g's, and duration pulse seconds, followed by
+// rest up to numPoints points
+static const double peak = 0.1;
+static const double pulse = 0.5;
+static const double dt = 0.005;
+static const int numPoints = 400;
+
+static double pulseAcc(int i)
+{
+	double t = i * dt;
+	return (t < pulse) ? peak * sin(M_PI * t / pulse) : 0.0;
+}
+
+static void writeAT2(const std::string& fName)
+{
+	std::ofstream out(fName.c_str());
+	out << "PEER NGA STRONG MOTION DATABASE RECORD\n";
+	out << "HALF SINE PULSE, 0 DEG\n";
+	out << "ACCELERATION TIME SERIES IN UNITS OF G\n";
+	out << "NPTS=  " << numPoints << ", DT=   .0050 SEC\n";
+	char value[32];
+	for (int i = 0; i < numPoints; i++)
+	{
+		sprintf(value, "%15.7E", pulseAcc(i));
+		out << value << (((i % 5) == 4) ? "\n" : "");
+	}
+	out << "\n";
+}
+
+static void writeAcc(const std::string& name)
+{
+	std::ofstream time((name + ".time").c_str());
+	std::ofstream acc((name + ".acc").c_str());
+	for (int i = 0; i < numPoints; i++)
+	{
+		time << i * dt << "\n";
+		acc << pulseAcc(i) << "\n";
+	}
+}
+
+// the velocity at the end of the record is the area of the pulse
+static void checkVelocity(OutcropMotion& motion, const char* what)
+{
+	std::string message = std::string(what) + " has no velocity";
+	check(motion.isInitialized() && (motion.getVelSeries() != NULL), message.c_str());
+	if (motion.getVelSeries() == NULL)
+		return;
+	double expected = 2.0 * peak * 9.81 * pulse / M_PI;
+	double velocity = motion.getVelSeries()->getFactor((numPoints - 1) * dt);
+	message = std::string("the velocity of ") + what + " is not the integral of its acceleration";
+	check(fabs(velocity - expected) < 1.0e-3 * expected, message.c_str());
+}
+
+static void writeConfig(const std::string& fName)
+{
+	std::ofstream out(fName.c_str());
+	out << "{\n"
+		" \"basicSettings\": {\"eSizeH\":0.25,\"eSizeV\":0.25,\"rockVs\":760,\"rockDen\":2.4,\"dashpotCoeff\":1824,"
+		"\"dampingCoeff\":0.02,\"groundMotion\":\"test.AT2\",\"OpenSeesPath\":\"\",\"groundWaterTable\":2.0},\n"
+		" \"soilProfile\": {\"soilLayers\":[\n"
+		"   {\"id\":1,\"name\":\"Layer 1\",\"thickness\":3.0,\"density\":2.0,\"vs\":180,\"material\":1,\"color\":\"#aaaaaa\",\"eSize\":0.5,"
+		"\"Dr\":0.47,\"hPerm\":1e-7,\"vPerm\":1e-7,\"uBulk\":2.2e6},\n"
+		"   {\"id\":2,\"name\":\"Rock\",\"thickness\":0.0,\"density\":2.4,\"vs\":760,\"material\":2,\"color\":\"#cccccc\",\"eSize\":0.5,"
+		"\"Dr\":0.0,\"hPerm\":1e-7,\"vPerm\":1e-7,\"uBulk\":2.2e6}\n"
+		" ]},\n"
+		" \"materials\":[\n"
+		"   {\"id\":1,\"type\":\"Elastic\",\"E\":172757,\"poisson\":0.3,\"density\":2.0},\n"
+		"   {\"id\":2,\"type\":\"Elastic\",\"E\":1e7,\"poisson\":0.3,\"density\":2.4}\n"
+		" ]\n"
+		"}\n";
+}
+
+int main(int argc, char** argv)
+{
+	std::string workDir = (argc > 1) ? argv[1] : ".";
+	std::string at2 = workDir + "/test.AT2";
+	std::string rock = workDir + "/Rock";
+
+	writeAcc(rock);
+	OutcropMotion accMotion;
+	accMotion.setMotion(rock.c_str());
+	checkVelocity(accMotion, "an acceleration read from .time/.acc files");
+
+	writeAT2(at2);
+	OutcropMotion motion;
+	motion.setMotion(at2.c_str());
+	checkVelocity(motion, "an AT2 record");
+
+	// the analysis is loaded by the velocity of the record
+	writeConfig(workDir + "/SRT.json");
+	SiteResponseModel model("2D", &motion);
+	model.setConfigFile(workDir + "/SRT.json");
+	model.setAnalysisDir(workDir);
+	model.setOutputDir(workDir);
+	model.setTclOutputDir(workDir);
+	check(model.buildEffectiveStressModel2D(true) == 0, "the analysis of an AT2 record failed");
+
+	int numRows = 0;
+	std::ifstream surface((workDir + "/surface.acc").c_str());
+	std::string line;
+	while (std::getline(surface, line))
+		numRows++;
+	check(numRows > 0, "the analysis of an AT2 record wrote no surface acceleration");
+
+	if (numFailed == 0)
+		fprintf(stderr, "AT2 motion: all checks passed\n");
+	return (numFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+// Checks that an analysis is found in the result cache when it is run again
+// with the same motion. The GUI keeps its OutcropMotion between runs and
+// reads the rock motion into it again when the files change, so the key is
+// made twice on the same motion, before and after reading the same files
+// again, and the second key must find what was stored under the first.
+//
+//   resultcachetest [work directory]
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ResultCache.h"
+#include "outcropMotion.h"
+
+#include "StandardStream.h"
+#include "OPS_Stream.h"
+#include "OPS_Globals.h"
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+OPS_Stream *opsoutPtr = &sserr;
+
+static int numFailed = 0;
+
+static void check(bool passed, const char* what)
+{
+	if (!passed)
+	{
+		fprintf(stderr, "FAILED: %s\n", what);
+		numFailed++;
+	}
+}
+
+// a rock motion as the GUI writes it, the .time and .vel files of name
+static void writeMotion(const std::string& name, double amplitude)
+{
+	std::ofstream time((name + ".time").c_str());
+	std::ofstream vel((name + ".vel").c_str());
+	for (int i = 0; i < 200; i++)
+	{
+		time << i * 0.005 << "\n";
+		vel << amplitude * ((i % 20) - 10) / 10.0 << "\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string workDir = (argc > 1) ? argv[1] : ".";
+	std::string rock = workDir + "/Rock";
+
+	json config = {
+		{"basicSettings", {{"groundMotion", rock}, {"OpenSeesPath", "OpenSees"}, {"dampingCoeff", 0.02}}},
+		{"soilProfile", {{"soilLayers", {{{"id", 1}, {"name", "Layer 1"}, {"thickness", 5.0}, {"color", "#aaaaaa"}}}}}}
+	};
+
+	writeMotion(rock, 0.1);
+	OutcropMotion motion;
+	motion.setMotion(rock.c_str());
+	unsigned long long firstKey = ResultCache::makeKey(config, &motion, "native");
+	check(firstKey == ResultCache::makeKey(config, &motion, "native"), "the key of a motion changes when it is made again");
+
+	// the next run of the GUI reads the same files into the same motion
+	motion.setMotion(rock.c_str());
+	unsigned long long secondKey = ResultCache::makeKey(config, &motion, "native");
+	check(firstKey == secondKey, "the key changes when the same motion is read again");
+
+	// an output of the first run is found by the key of the second
+	std::vector<std::string> dirs(1, workDir);
+	ResultCache::File file = {0, "surface.acc"};
+	{
+		std::ofstream out((workDir + "/surface.acc").c_str());
+		out << "0.0 0.1\n0.005 0.2\n";
+	}
+	ResultCache cache(workDir + "/cache");
+	check(cache.store(firstKey, dirs, std::vector<ResultCache::File>(1, file)), "the result could not be stored");
+	remove((workDir + "/surface.acc").c_str());
+	check(cache.fetch(secondKey, dirs), "the result of the same motion is not found");
+	check(std::ifstream((workDir + "/surface.acc").c_str()).good(), "the fetched output is not in the work directory");
+
+	// another motion is not
+	writeMotion(rock, 0.2);
+	motion.setMotion(rock.c_str());
+	unsigned long long otherKey = ResultCache::makeKey(config, &motion, "native");
+	check(otherKey != firstKey, "another motion has the same key");
+	check(!cache.fetch(otherKey, dirs), "the result of another motion is found");
+
+	if (numFailed == 0)
+		fprintf(stderr, "ResultCache: all checks passed\n");
+	return (numFailed == 0) ? 0 : 1;
+}